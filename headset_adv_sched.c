@@ -0,0 +1,192 @@
+/******************************************************************************
+* File Name:   headset_adv_sched.c
+*
+* Description: LE advertising scheduler following the connection and audio state.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "headset_adv_sched.h"
+#include "wiced_bt_trace.h"
+
+/*******************************************************************************
+* Structures
+********************************************************************************/
+typedef struct
+{
+    wiced_bool_t                enabled;
+    uint8_t                     state;
+    headset_adv_sched_profile_t profile;
+    wiced_bt_ble_advert_mode_t  mode;       /* Current mode reported by the stack */
+} headset_adv_sched_cb_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static headset_adv_sched_cb_t headset_adv_sched_cb =
+{
+    .profile    = HEADSET_ADV_SCHED_PROFILE_OFF,
+    .mode       = BTM_BLE_ADVERT_OFF,
+};
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void headset_adv_sched_apply(void);
+
+/*******************************************************************************
+* Global Function Definitions
+*******************************************************************************/
+
+void headset_adv_sched_enable(void)
+{
+    headset_adv_sched_cb.enabled = WICED_TRUE;
+    headset_adv_sched_apply();
+}
+
+/*
+ * - Auto-off: off.
+ * - LE connected: off, the single LE link is in use.
+ * - Discoverable: fast, so a Seeker finds the device quickly. The stack falls back to the
+ *   slow profile after high_duty_duration.
+ * - Audio running: off, advertising events would compete with the A2DP / eSCO slots.
+ * - Otherwise: slow, to stay findable by the devices already paired.
+ */
+headset_adv_sched_profile_t headset_adv_sched_select(uint8_t state)
+{
+    if (state & (HEADSET_ADV_SCHED_STATE_AUTO_OFF | HEADSET_ADV_SCHED_STATE_LE_CONNECTED))
+    {
+        return HEADSET_ADV_SCHED_PROFILE_OFF;
+    }
+
+    if (state & HEADSET_ADV_SCHED_STATE_DISCOVERABLE)
+    {
+        return HEADSET_ADV_SCHED_PROFILE_FAST;
+    }
+
+    if (state & (HEADSET_ADV_SCHED_STATE_STREAMING | HEADSET_ADV_SCHED_STATE_CALL))
+    {
+        return HEADSET_ADV_SCHED_PROFILE_OFF;
+    }
+
+    return HEADSET_ADV_SCHED_PROFILE_SLOW;
+}
+
+void headset_adv_sched_state_set(uint8_t state, wiced_bool_t set)
+{
+    if (set)
+    {
+        headset_adv_sched_cb.state |= state;
+    }
+    else
+    {
+        headset_adv_sched_cb.state &= ~state;
+    }
+
+    headset_adv_sched_apply();
+}
+
+/*
+ * The Fast Pair provider restarts advertising by itself (e.g. to refresh its data). A restart
+ * while the off profile is selected is stopped again; in the other profiles it is left running
+ * and the schedule applies again at the next state change.
+ */
+void headset_adv_sched_advert_state_changed(wiced_bt_ble_advert_mode_t mode)
+{
+    headset_adv_sched_cb.mode = mode;
+
+    if (!headset_adv_sched_cb.enabled ||
+        (headset_adv_sched_cb.profile != HEADSET_ADV_SCHED_PROFILE_OFF) ||
+        (headset_adv_sched_cb.state & HEADSET_ADV_SCHED_STATE_LE_CONNECTED) ||
+        (mode == BTM_BLE_ADVERT_OFF))
+    {
+        return;
+    }
+
+    WICED_BT_TRACE("headset_adv_sched: stop advertising restarted in state 0x%x\n", headset_adv_sched_cb.state);
+
+    wiced_bt_start_advertisements(BTM_BLE_ADVERT_OFF, BLE_ADDR_PUBLIC, NULL);
+}
+
+/*******************************************************************************
+* Static Function Definitions
+*******************************************************************************/
+
+static void headset_adv_sched_apply(void)
+{
+    headset_adv_sched_profile_t profile = headset_adv_sched_select(headset_adv_sched_cb.state);
+    wiced_bt_ble_advert_mode_t mode;
+
+    if (!headset_adv_sched_cb.enabled || (profile == headset_adv_sched_cb.profile))
+    {
+        return;
+    }
+
+    WICED_BT_TRACE("headset_adv_sched: state 0x%x, profile %d -> %d\n",
+                   headset_adv_sched_cb.state,
+                   headset_adv_sched_cb.profile,
+                   profile);
+
+    headset_adv_sched_cb.profile = profile;
+
+    /* The stack stops advertising by itself when the LE link comes up. */
+    if (headset_adv_sched_cb.state & HEADSET_ADV_SCHED_STATE_LE_CONNECTED)
+    {
+        return;
+    }
+
+    switch (profile)
+    {
+    case HEADSET_ADV_SCHED_PROFILE_FAST:
+        mode = BTM_BLE_ADVERT_UNDIRECTED_HIGH;
+        break;
+    case HEADSET_ADV_SCHED_PROFILE_SLOW:
+        mode = BTM_BLE_ADVERT_UNDIRECTED_LOW;
+        break;
+    default:
+        mode = BTM_BLE_ADVERT_OFF;
+        break;
+    }
+
+    if (mode != headset_adv_sched_cb.mode)
+    {
+        wiced_bt_start_advertisements(mode, BLE_ADDR_PUBLIC, NULL);
+    }
+}
+
+/* [] END OF FILE */
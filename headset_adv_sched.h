@@ -0,0 +1,143 @@
+/******************************************************************************
+* File Name:   headset_adv_sched.h
+*
+* Description: LE advertising scheduler following the connection and audio state.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#if !defined(HEADSET_ADV_SCHED_H)
+#define HEADSET_ADV_SCHED_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_ble.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/*
+ * Device state seen by the scheduler (bit mask).
+ */
+#define HEADSET_ADV_SCHED_STATE_DISCOVERABLE    (1 << 0)    /* Pairing mode */
+#define HEADSET_ADV_SCHED_STATE_BREDR_CONNECTED (1 << 1)    /* At least one source connected */
+#define HEADSET_ADV_SCHED_STATE_STREAMING       (1 << 2)    /* A2DP stream running */
+#define HEADSET_ADV_SCHED_STATE_CALL            (1 << 3)    /* (e)SCO link up */
+#define HEADSET_ADV_SCHED_STATE_LE_CONNECTED    (1 << 4)    /* LE link up (single LE link supported) */
+#define HEADSET_ADV_SCHED_STATE_AUTO_OFF        (1 << 5)    /* Auto-off: advertising stopped */
+
+/*
+ * Advertising profiles. The intervals of the fast and slow profiles are the high and low
+ * duty settings of wiced_bt_cfg_adv_settings.
+ */
+typedef enum
+{
+    HEADSET_ADV_SCHED_PROFILE_OFF,
+    HEADSET_ADV_SCHED_PROFILE_SLOW,
+    HEADSET_ADV_SCHED_PROFILE_FAST,
+} headset_adv_sched_profile_t;
+
+/*******************************************************************************
+*        External Variable Declarations
+*******************************************************************************/
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: headset_adv_sched_enable
+********************************************************************************
+* Summary:
+*   Start scheduling once the advertising data is set (Fast Pair provider initialized).
+*
+* Parameters:
+*   void
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_adv_sched_enable(void);
+
+/*******************************************************************************
+* Function Name: headset_adv_sched_select
+********************************************************************************
+* Summary:
+*   Policy: advertising profile for a device state.
+*
+* Parameters:
+*   state   : HEADSET_ADV_SCHED_STATE_xxx mask
+*
+* Return:
+*   advertising profile
+*
+*******************************************************************************/
+headset_adv_sched_profile_t headset_adv_sched_select(uint8_t state);
+
+/*******************************************************************************
+* Function Name: headset_adv_sched_state_set
+********************************************************************************
+* Summary:
+*   Set or clear state bits and switch the advertising profile if needed.
+*
+* Parameters:
+*   state   : HEADSET_ADV_SCHED_STATE_xxx bit(s)
+*   set     : WICED_TRUE to set, WICED_FALSE to clear
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_adv_sched_state_set(uint8_t state, wiced_bool_t set);
+
+/*******************************************************************************
+* Function Name: headset_adv_sched_advert_state_changed
+********************************************************************************
+* Summary:
+*   Handle BTM_BLE_ADVERT_STATE_CHANGED_EVT. Advertising started by another module (the
+*   Fast Pair provider) is not overridden.
+*
+* Parameters:
+*   mode    : new advertising mode
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_adv_sched_advert_state_changed(wiced_bt_ble_advert_mode_t mode);
+
+#endif /* HEADSET_ADV_SCHED_H */
+/* [] END OF FILE */
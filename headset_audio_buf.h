@@ -0,0 +1,116 @@
+/******************************************************************************
+* File Name:   headset_audio_buf.h
+*
+* Description: Phase based layout description and lifetime checker for the audio buffer.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#if !defined(HEADSET_AUDIO_BUF_H)
+#define HEADSET_AUDIO_BUF_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define HEADSET_AUDIO_BUF_MAX(a, b)             (((a) > (b)) ? (a) : (b))
+#define HEADSET_AUDIO_BUF_DIV_ROUND_UP(a, b)    (((a) + (b) - 1) / (b))
+#define HEADSET_AUDIO_BUF_ALIGN(size, align)    (HEADSET_AUDIO_BUF_DIV_ROUND_UP(size, align) * (align))
+
+/*
+ * Sizing model of the audio buffer users.
+ *
+ * All macros below are integer constant expressions so the audio buffer size can be derived,
+ * and checked with static assertions, at build time from the codec parameters the application
+ * advertises. Sizes that only depend on the audio library implementation (codec state) are
+ * given as constants.
+ */
+
+/* Book-keeping the A2DP jitter buffer keeps for every queued media frame */
+#define HEADSET_AUDIO_BUF_A2DP_FRAME_OVERHEAD   7
+
+/* Number of PCM samples per channel in one SBC frame */
+#define HEADSET_AUDIO_BUF_SBC_FRAME_SAMPLES     (16 * 8)    /* 16 blocks, 8 subbands */
+
+/* Number of PCM samples per channel in one AAC-LC frame */
+#define HEADSET_AUDIO_BUF_AAC_FRAME_SAMPLES     1024
+
+/* Largest SBC frame (joint stereo, 16 blocks, 8 subbands) in bytes for the given bitpool (A2DP spec 12.9) */
+#define HEADSET_AUDIO_BUF_SBC_FRAME_LEN(bitpool) \
+    (4 + ((4 * 8 * 2) / 8) + HEADSET_AUDIO_BUF_DIV_ROUND_UP(8 + (16 * (bitpool)), 8))
+
+/* Number of frames of frame_samples samples needed to cover depth_ms at sample_rate */
+#define HEADSET_AUDIO_BUF_FRAMES(depth_ms, sample_rate, frame_samples) \
+    HEADSET_AUDIO_BUF_DIV_ROUND_UP((depth_ms) * (sample_rate), (frame_samples) * 1000)
+
+/* SBC jitter buffer size */
+#define HEADSET_AUDIO_BUF_SBC_JITTER_SIZE(depth_ms, sample_rate, bitpool) \
+    (HEADSET_AUDIO_BUF_FRAMES(depth_ms, sample_rate, HEADSET_AUDIO_BUF_SBC_FRAME_SAMPLES) * \
+     (HEADSET_AUDIO_BUF_SBC_FRAME_LEN(bitpool) + HEADSET_AUDIO_BUF_A2DP_FRAME_OVERHEAD))
+
+/* AAC jitter buffer size for the given maximum bit rate (bit/s) */
+#define HEADSET_AUDIO_BUF_AAC_JITTER_SIZE(depth_ms, sample_rate, bit_rate) \
+    (HEADSET_AUDIO_BUF_DIV_ROUND_UP((bit_rate) / 8 * (depth_ms), 1000) + \
+     (HEADSET_AUDIO_BUF_FRAMES(depth_ms, sample_rate, HEADSET_AUDIO_BUF_AAC_FRAME_SAMPLES) * \
+      HEADSET_AUDIO_BUF_A2DP_FRAME_OVERHEAD))
+
+/*
+ * Main region sizes the audio library requires, as documented with its reference configuration:
+ * 14728 bytes for HFP (mSBC use mainly) and 14148 bytes for A2DP (jitter buffer use mainly).
+ * The library does not publish the split of its HFP memory, so HFP is only checked against this
+ * figure. The A2DP jitter buffer is also checked against the size modeled above.
+ */
+#define HEADSET_AUDIO_BUF_LIB_HFP_MIN           14728
+#define HEADSET_AUDIO_BUF_LIB_A2DP_MIN          14148
+
+/* SBC decoder state */
+#define HEADSET_AUDIO_BUF_SBC_CODEC_SIZE        6908
+
+/* AAC decoder state (21248 bytes) and sample buffer (2 * 4 * 1024 bytes) */
+#define HEADSET_AUDIO_BUF_AAC_CODEC_SIZE        (21248 + (2 * 4 * 1024))
+
+/*******************************************************************************
+*        External Variable Declarations
+*******************************************************************************/
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+
+#endif /* HEADSET_AUDIO_BUF_H */
+/* [] END OF FILE */
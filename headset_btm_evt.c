@@ -0,0 +1,163 @@
+/******************************************************************************
+* File Name:   headset_btm_evt.c
+*
+* Description: Bluetooth management event dispatch.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "headset_btm_evt.h"
+#include "wiced_bt_trace.h"
+#if HEADSET_BTM_EVT_TIMING
+#include "clock_timer.h"
+#endif
+
+/*******************************************************************************
+* Structures
+********************************************************************************/
+typedef struct
+{
+    headset_btm_evt_handler_t   p_handler[HEADSET_BTM_EVT_MAX];
+
+    uint32_t                    count[HEADSET_BTM_EVT_MAX];
+    uint32_t                    count_other;                    /* Events out of the table */
+#if HEADSET_BTM_EVT_TIMING
+    uint32_t                    time_us[HEADSET_BTM_EVT_MAX];
+    uint32_t                    max_us[HEADSET_BTM_EVT_MAX];
+#endif
+} headset_btm_evt_cb_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static headset_btm_evt_cb_t headset_btm_evt_cb = {0};
+
+/*******************************************************************************
+* Global Function Definitions
+*******************************************************************************/
+
+wiced_result_t headset_btm_evt_register(wiced_bt_management_evt_t event, headset_btm_evt_handler_t p_handler)
+{
+    headset_btm_evt_cb_t *p_cb = &headset_btm_evt_cb;
+
+    if (((uint32_t) event >= HEADSET_BTM_EVT_MAX) || (p_handler == NULL))
+    {
+        return WICED_BT_BADARG;
+    }
+
+    if (p_cb->p_handler[event] != NULL)
+    {
+        WICED_BT_TRACE("headset_btm_evt: event %d already has a handler\n", event);
+        return WICED_BT_ERROR;
+    }
+
+    p_cb->p_handler[event] = p_handler;
+
+    return WICED_BT_SUCCESS;
+}
+
+wiced_result_t headset_btm_evt_dispatch(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data)
+{
+    headset_btm_evt_cb_t *p_cb = &headset_btm_evt_cb;
+    wiced_result_t result;
+#if HEADSET_BTM_EVT_TIMING
+    uint32_t start_us, time_us;
+#endif
+
+    if ((uint32_t) event >= HEADSET_BTM_EVT_MAX)
+    {
+        p_cb->count_other++;
+        return WICED_BT_USE_DEFAULT_SECURITY;
+    }
+
+    p_cb->count[event]++;
+
+    if (p_cb->p_handler[event] == NULL)
+    {
+        return WICED_BT_USE_DEFAULT_SECURITY;
+    }
+
+#if HEADSET_BTM_EVT_TIMING
+    start_us = (uint32_t) clock_SystemTimeMicroseconds64();
+#endif
+
+    result = p_cb->p_handler[event](event, p_event_data);
+
+#if HEADSET_BTM_EVT_TIMING
+    time_us = (uint32_t) clock_SystemTimeMicroseconds64() - start_us;
+
+    p_cb->time_us[event] += time_us;
+    if (time_us > p_cb->max_us[event])
+    {
+        p_cb->max_us[event] = time_us;
+    }
+#endif
+
+    return result;
+}
+
+void headset_btm_evt_stats_report(void)
+{
+    headset_btm_evt_cb_t *p_cb = &headset_btm_evt_cb;
+    uint8_t event;
+
+    for (event = 0; event < HEADSET_BTM_EVT_MAX; event++)
+    {
+        if (p_cb->count[event] == 0)
+        {
+            continue;
+        }
+
+#if HEADSET_BTM_EVT_TIMING
+        WICED_BT_TRACE("headset_btm_evt: event %d n %d avg %d max %d us\n",
+                       event,
+                       p_cb->count[event],
+                       p_cb->time_us[event] / p_cb->count[event],
+                       p_cb->max_us[event]);
+#else
+        WICED_BT_TRACE("headset_btm_evt: event %d n %d\n", event, p_cb->count[event]);
+#endif
+    }
+
+    if (p_cb->count_other != 0)
+    {
+        WICED_BT_TRACE("headset_btm_evt: other events n %d\n", p_cb->count_other);
+    }
+}
+
+/* [] END OF FILE */
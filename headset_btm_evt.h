@@ -0,0 +1,128 @@
+/******************************************************************************
+* File Name:   headset_btm_evt.h
+*
+* Description: Bluetooth management event dispatch.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#if !defined(HEADSET_BTM_EVT_H)
+#define HEADSET_BTM_EVT_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+#include "wiced_bt_dev.h"
+#include "wiced_result.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Events below this value have a dispatch table entry, others get the default result */
+#define HEADSET_BTM_EVT_MAX             64
+
+/* Time the handlers of each event */
+#ifndef HEADSET_BTM_EVT_TIMING
+#define HEADSET_BTM_EVT_TIMING          0
+#endif
+
+/*******************************************************************************
+*        Data Types
+*******************************************************************************/
+typedef wiced_result_t (*headset_btm_evt_handler_t)(wiced_bt_management_evt_t event,
+                                                    wiced_bt_management_evt_data_t *p_event_data);
+
+/*******************************************************************************
+*        External Variable Declarations
+*******************************************************************************/
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: headset_btm_evt_register
+********************************************************************************
+* Summary:
+*   Register the handler of a management event. An event has a single handler, a handler
+*   that needs more modules calls them itself in the order they need.
+*
+* Parameters:
+*   event       : management event
+*   p_handler   : handler
+*
+* Return:
+*   WICED_BT_SUCCESS
+*   WICED_BT_BADARG if the event is out of the table
+*   WICED_BT_ERROR if the event already has a handler
+*
+*******************************************************************************/
+wiced_result_t headset_btm_evt_register(wiced_bt_management_evt_t event, headset_btm_evt_handler_t p_handler);
+
+/*******************************************************************************
+* Function Name: headset_btm_evt_dispatch
+********************************************************************************
+* Summary:
+*   Management callback given to the stack. Call the handler registered for the event.
+*
+* Parameters:
+*   event           : management event
+*   p_event_data    : event data
+*
+* Return:
+*   WICED_BT_USE_DEFAULT_SECURITY if no handler is registered, else the result of the handler
+*
+*******************************************************************************/
+wiced_result_t headset_btm_evt_dispatch(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data);
+
+/*******************************************************************************
+* Function Name: headset_btm_evt_stats_report
+********************************************************************************
+* Summary:
+*   Trace the number of times each event was received, and the handler time with
+*   HEADSET_BTM_EVT_TIMING.
+*
+* Parameters:
+*   void
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_btm_evt_stats_report(void);
+
+#endif /* HEADSET_BTM_EVT_H */
+/* [] END OF FILE */
@@ -46,6 +46,12 @@
 #include <stdint.h>
 
 #include "bt_hs_spk_button.h"
+#include "bt_hs_spk_handsfree.h"
+#include "headset_button.h"
+#include "headset_button_trace.h"
+#include "headset_defer.h"
+#include "headset_power.h"
+#include "headset_sniff.h"
 #include "wiced.h"
 #include "wiced_button_manager.h"
 #include "wiced_platform.h"
@@ -58,6 +64,12 @@
 #define ARRAY_SIZE(a)                                ( sizeof(a) / sizeof(a[0]) )
 #endif // ARRAY_SIZE
 
+#ifdef AUDIO_INSERT_ENABLED
+/* Stream the volume prompt is mixed into */
+#define HEADSET_BUTTON_AUDIO_INSERT_HANDSFREE        0
+#define HEADSET_BUTTON_AUDIO_INSERT_AUDIO            1
+#endif
+
 /*******************************************************************************
 * Global Variables
 ********************************************************************************/
@@ -78,142 +90,119 @@ static wiced_button_manager_configuration_t app_button_manager_configuration =
 /* Static button configuration */
 static wiced_button_configuration_t app_button_configurations[] =
 {
-#if (APP_BUTTON_MAX == 1)
-    [ PLAY_PAUSE_BUTTON ]                   = { PLATFORM_BUTTON_1, BUTTON_CLICK_EVENT | BUTTON_LONG_DURATION_EVENT | BUTTON_VERY_LONG_DURATION_EVENT , 0 },
-#else
     [ PLAY_PAUSE_BUTTON ]                   = { PLATFORM_BUTTON_1, BUTTON_CLICK_EVENT | BUTTON_LONG_DURATION_EVENT | BUTTON_VERY_LONG_DURATION_EVENT , 0 },
+#if (APP_BUTTON_MAX > 1)
     [ VOLUME_UP_NEXT_TRACK_BUTTON ]         = { PLATFORM_BUTTON_2, BUTTON_CLICK_EVENT | BUTTON_LONG_DURATION_EVENT | BUTTON_VERY_LONG_DURATION_EVENT | BUTTON_HOLDING_EVENT , 0 },
     [ VOLUME_DOWN_PREVIOUS_TRACK_BUTTON ]   = { PLATFORM_BUTTON_3, BUTTON_CLICK_EVENT | BUTTON_LONG_DURATION_EVENT | BUTTON_VERY_LONG_DURATION_EVENT | BUTTON_HOLDING_EVENT , 0 },
+#endif
 #if (APP_BUTTON_MAX >= 4)
     [ VOICE_REC_BUTTON ]                    = { PLATFORM_BUTTON_4, BUTTON_CLICK_EVENT | BUTTON_LONG_DURATION_EVENT | BUTTON_VERY_LONG_DURATION_EVENT | BUTTON_HOLDING_EVENT, 0 },
 #endif
-#endif
 };
 
 /* Button objects for the button manager */
 button_manager_button_t app_buttons[] =
 {
-#if (APP_BUTTON_MAX == 1)
-    [ PLAY_PAUSE_BUTTON ]                   = { &app_button_configurations[ PLAY_PAUSE_BUTTON ]        },
-#else
     [ PLAY_PAUSE_BUTTON ]                   = { &app_button_configurations[ PLAY_PAUSE_BUTTON ]        },
+#if (APP_BUTTON_MAX > 1)
     [ VOLUME_UP_NEXT_TRACK_BUTTON ]         = { &app_button_configurations[ VOLUME_UP_NEXT_TRACK_BUTTON ]     },
     [ VOLUME_DOWN_PREVIOUS_TRACK_BUTTON ]   = { &app_button_configurations[ VOLUME_DOWN_PREVIOUS_TRACK_BUTTON ]  },
+#endif
 #if (APP_BUTTON_MAX >= 4)
     [ VOICE_REC_BUTTON ]                    = { &app_button_configurations[ VOICE_REC_BUTTON ] },
 #endif
-#endif
 };
 
-static bt_hs_spk_button_action_t app_button_action[] =
+/* (event, state, repeat) tuple of each column of the action map */
+static const struct
 {
-#if (APP_BUTTON_MAX == 1)
-    /* PLAY_PAUSE_BUTTON */
-    {
-        .action = ACTION_PAUSE_PLAY,
-        .button = PLAY_PAUSE_BUTTON,
-        .event  = BUTTON_CLICK_EVENT,
-        .state  = BUTTON_STATE_RELEASED,
-    },
-    {
-        .action = ACTION_BT_DISCOVERABLE,
-        .button = PLAY_PAUSE_BUTTON,
-        .event  = BUTTON_LONG_DURATION_EVENT,
-        .state  = BUTTON_STATE_HELD,
-    },
-#else
-    /* PLAY_PAUSE_BUTTON */
-    {
-        .action = ACTION_PAUSE_PLAY,
-        .button = PLAY_PAUSE_BUTTON,
-        .event  = BUTTON_CLICK_EVENT,
-        .state  = BUTTON_STATE_RELEASED,
-    },
-    {
-        .action = ACTION_BT_DISCOVERABLE,
-        .button = PLAY_PAUSE_BUTTON,
-        .event  = BUTTON_LONG_DURATION_EVENT,
-        .state  = BUTTON_STATE_HELD,
-    },
+    button_manager_event_t          event;
+    button_manager_button_state_t   state;
+    uint8_t                         repeat;
+} app_button_slot[HEADSET_BUTTON_SLOT_NUM] =
+{
+    [ HEADSET_BUTTON_SLOT_CLICK ]               = { BUTTON_CLICK_EVENT,                 BUTTON_STATE_RELEASED,  0 },
+    [ HEADSET_BUTTON_SLOT_LONG_HELD ]           = { BUTTON_LONG_DURATION_EVENT,         BUTTON_STATE_HELD,      0 },
+    [ HEADSET_BUTTON_SLOT_LONG_RELEASED ]       = { BUTTON_LONG_DURATION_EVENT,         BUTTON_STATE_RELEASED,  0 },
+    [ HEADSET_BUTTON_SLOT_VERY_LONG_HELD ]      = { BUTTON_VERY_LONG_DURATION_EVENT,    BUTTON_STATE_HELD,      0 },
+    [ HEADSET_BUTTON_SLOT_VERY_LONG_RELEASED ]  = { BUTTON_VERY_LONG_DURATION_EVENT,    BUTTON_STATE_RELEASED,  0 },
+    [ HEADSET_BUTTON_SLOT_HOLD_1 ]              = { BUTTON_HOLDING_EVENT,               BUTTON_STATE_HELD,      1 },
+    [ HEADSET_BUTTON_SLOT_HOLD_2 ]              = { BUTTON_HOLDING_EVENT,               BUTTON_STATE_HELD,      2 },
+};
+
+/*
+ * Action map, button x slot. Every (button, event, state, repeat) tuple has exactly one cell, and
+ * mapping a cell twice is a build error (see the diagnostic below), so a product layout only
+ * lists its cells. Unlisted cells are unmapped.
+ */
+#define APP_BUTTON_ACTION(a)    { .mapped = WICED_TRUE, .action = (a) }
 
-    /* VOLUME_UP_NEXT_TRACK_BUTTON */
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Woverride-init"
+#endif
+static const struct
+{
+    wiced_bool_t            mapped;
+    app_service_action_t    action;
+} app_button_map[APP_BUTTON_MAX][HEADSET_BUTTON_SLOT_NUM] =
+{
+    [ PLAY_PAUSE_BUTTON ] =
     {
-        .action = ACTION_VOLUME_UP,
-        .button = VOLUME_UP_NEXT_TRACK_BUTTON,
-        .event  = BUTTON_CLICK_EVENT,
-        .state  = BUTTON_STATE_RELEASED,
+        [ HEADSET_BUTTON_SLOT_CLICK ]           = APP_BUTTON_ACTION(ACTION_PAUSE_PLAY),
+        [ HEADSET_BUTTON_SLOT_LONG_HELD ]       = APP_BUTTON_ACTION(ACTION_BT_DISCOVERABLE),
     },
+#if (APP_BUTTON_MAX > 1)
+    [ VOLUME_UP_NEXT_TRACK_BUTTON ] =
     {
-        .action = ACTION_FORWARD,
-        .button = VOLUME_UP_NEXT_TRACK_BUTTON,
-        .event  = BUTTON_LONG_DURATION_EVENT,
-        .state  = BUTTON_STATE_RELEASED,
-    },
+        [ HEADSET_BUTTON_SLOT_CLICK ]           = APP_BUTTON_ACTION(ACTION_VOLUME_UP),
+        [ HEADSET_BUTTON_SLOT_LONG_RELEASED ]   = APP_BUTTON_ACTION(ACTION_FORWARD),
 #if (APP_BUTTON_MAX < 4)
-    {
-        .action = ACTION_VOICE_RECOGNITION,
-        .button = VOLUME_UP_NEXT_TRACK_BUTTON,
-        .event  = BUTTON_HOLDING_EVENT,
-        .state  = BUTTON_STATE_HELD,
-        .repeat = 2,
-    },
+        [ HEADSET_BUTTON_SLOT_HOLD_2 ]          = APP_BUTTON_ACTION(ACTION_VOICE_RECOGNITION),
 #endif
-
-    /* VOLUME_DOWN_PREVIOUS_TRACK_BUTTON */
-    {
-        .action = ACTION_VOLUME_DOWN,
-        .button = VOLUME_DOWN_PREVIOUS_TRACK_BUTTON,
-        .event  = BUTTON_CLICK_EVENT,
-        .state  = BUTTON_STATE_RELEASED,
     },
+    [ VOLUME_DOWN_PREVIOUS_TRACK_BUTTON ] =
     {
-        .action = ACTION_BACKWARD,
-        .button = VOLUME_DOWN_PREVIOUS_TRACK_BUTTON,
-        .event  = BUTTON_LONG_DURATION_EVENT,
-        .state  = BUTTON_STATE_RELEASED,
-    },
+        [ HEADSET_BUTTON_SLOT_CLICK ]           = APP_BUTTON_ACTION(ACTION_VOLUME_DOWN),
+        [ HEADSET_BUTTON_SLOT_LONG_RELEASED ]   = APP_BUTTON_ACTION(ACTION_BACKWARD),
 #ifdef ENABLE_PTS_TESTING
-    {
-        .action = ACTION_MULTI_FUNCTION_LONG_RELEASE,
-        .button = VOLUME_DOWN_PREVIOUS_TRACK_BUTTON,
-        .event  = BUTTON_HOLDING_EVENT,
-        .state  = BUTTON_STATE_HELD,
-        .repeat = 1,
-    },
+        [ HEADSET_BUTTON_SLOT_HOLD_1 ]          = APP_BUTTON_ACTION(ACTION_MULTI_FUNCTION_LONG_RELEASE),
 #endif
 #if (APP_BUTTON_MAX < 4)
-    {
-        .action = ACTION_TRANSPORT_DETECT_ON,
-        .button = VOLUME_DOWN_PREVIOUS_TRACK_BUTTON,
-        .event  = BUTTON_HOLDING_EVENT,
-        .state  = BUTTON_STATE_HELD,
-        .repeat = 2,
+        [ HEADSET_BUTTON_SLOT_HOLD_2 ]          = APP_BUTTON_ACTION(ACTION_TRANSPORT_DETECT_ON),
+#endif
     },
 #endif
-
 #if (APP_BUTTON_MAX >= 4)
-    /* VOICE_REC_BUTTON */
-    {
-        .action = ACTION_VOICE_RECOGNITION,
-        .button = VOICE_REC_BUTTON,
-        .event  = BUTTON_HOLDING_EVENT,
-        .state  = BUTTON_STATE_HELD,
-        .repeat = 2,
-    },
+    [ VOICE_REC_BUTTON ] =
     {
-        .action = ACTION_TRANSPORT_DETECT_ON,
-        .button = VOICE_REC_BUTTON,
-        .event  = BUTTON_CLICK_EVENT,
-        .state  = BUTTON_STATE_RELEASED,
+        [ HEADSET_BUTTON_SLOT_CLICK ]           = APP_BUTTON_ACTION(ACTION_TRANSPORT_DETECT_ON),
+        [ HEADSET_BUTTON_SLOT_HOLD_2 ]          = APP_BUTTON_ACTION(ACTION_VOICE_RECOGNITION),
     },
 #endif
-#endif
 };
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+_Static_assert(ARRAY_SIZE(app_buttons) == APP_BUTTON_MAX, "app_buttons does not match APP_BUTTON_MAX");
+
+/* Flat list handed to the bt_hs_spk library, built from the map */
+static bt_hs_spk_button_action_t app_button_action[APP_BUTTON_MAX * HEADSET_BUTTON_SLOT_NUM];
 
 /*******************************************************************************
 * Function Prototypes
 ********************************************************************************/
 static wiced_bool_t headset_button_pre_handler(platform_button_t button, button_manager_event_t event, button_manager_button_state_t state, uint32_t repeat);
+#if HEADSET_BUTTON_TRACE
+static wiced_bool_t headset_button_trace_pre_handler(platform_button_t button, button_manager_event_t event, button_manager_button_state_t state, uint32_t repeat);
+static void         headset_button_trace_action(void *p_arg);
+#endif
+static uint32_t     headset_button_action_list_build(void);
+static uint8_t      headset_button_slot_get(button_manager_event_t event, button_manager_button_state_t state, uint32_t repeat);
+#ifdef AUDIO_INSERT_ENABLED
+static void         headset_button_audio_insert_start(void *p_arg);
+#endif
 
 /*******************************************************************************
 * Global Function Definitions
@@ -230,45 +219,64 @@ wiced_result_t btheadset_init_button_interface(void)
     config.number_of_buttons                        = ARRAY_SIZE(app_buttons);
 #if defined(CYW43012C0)
     config.p_pre_handler                            = NULL;
+#elif HEADSET_BUTTON_TRACE
+    config.p_pre_handler                            = &headset_button_trace_pre_handler;
 #else
     config.p_pre_handler                            = &headset_button_pre_handler;
 #endif
     config.button_action_config.p_action            = app_button_action;
-    config.button_action_config.number_of_actions   = ARRAY_SIZE(app_button_action);
+    config.button_action_config.number_of_actions   = headset_button_action_list_build();
+
+#if HEADSET_BUTTON_TRACE
+    headset_button_trace_init();
+#endif
 
     result = bt_hs_spk_init_button_interface(&config);
     return result;
 }
 
+wiced_bool_t headset_button_action_resolve(platform_button_t button, button_manager_event_t event,
+                                           button_manager_button_state_t state, uint32_t repeat,
+                                           app_service_action_t *p_action)
+{
+    uint8_t slot = headset_button_slot_get(event, state, repeat);
+
+    if (((uint32_t) button >= APP_BUTTON_MAX) ||
+        (slot >= HEADSET_BUTTON_SLOT_NUM) ||
+        !app_button_map[button][slot].mapped)
+    {
+        return WICED_FALSE;
+    }
+
+    *p_action = app_button_map[button][slot].action;
+
+    return WICED_TRUE;
+}
+
 /*******************************************************************************
 * Static Function Definitions
 *******************************************************************************/
+/*
+ * Every event is passed on to the bt_hs_spk library, mapped or not.
+ */
 static wiced_bool_t headset_button_pre_handler(platform_button_t button, button_manager_event_t event, button_manager_button_state_t state, uint32_t repeat)
 {
+    headset_power_user_activity();
+    headset_sniff_wake();
+
 #ifdef AUDIO_INSERT_ENABLED
     if ((button == (platform_button_t)VOLUME_UP_NEXT_TRACK_BUTTON) &&
         (event == BUTTON_CLICK_EVENT) &&
         (state == BUTTON_STATE_RELEASED))
     {
+        /* Check the volume before the library handles the click, start the prompt from the work queue. */
         /* Check if call session exists. */
         if (bt_hs_spk_handsfree_call_session_check())
         {
             if (bt_hs_spk_handsfree_volume_get() == WICED_HANDSFREE_VOLUME_MAX)
             {
                 /* Already maximum volume */
-                /* Prompt audio to indicate the volume is already at maximum */
-                headset_button_audio_insert_config.sample_rate = bt_hs_spk_handsfree_audio_manager_sampling_rate_get();
-                headset_button_audio_insert_config.duration    = HEADSET_BUTTON_AUDIO_INSERT_DURATION;
-                headset_button_audio_insert_config.p_source    = sine_wave_mono;
-                headset_button_audio_insert_config.len         = sizeof(sine_wave_mono);
-                headset_button_audio_insert_config.stopped_when_state_is_changed = WICED_TRUE;
-                headset_button_audio_insert_config.p_timeout_callback = NULL;
-
-                bt_hs_spk_audio_insert_start(&headset_button_audio_insert_config);
-
-                WICED_BT_TRACE("AUDIO_INSERT_STARTED duration:%d sample_rate:%d\n",
-                               headset_button_audio_insert_config.duration,
-                               headset_button_audio_insert_config.sample_rate);
+                headset_defer(HEADSET_DEFER_PRIORITY_HIGH, &headset_button_audio_insert_start, (void *) HEADSET_BUTTON_AUDIO_INSERT_HANDSFREE);
             }
         }
 
@@ -278,19 +286,7 @@ static wiced_bool_t headset_button_pre_handler(platform_button_t button, button_
             if (bt_hs_spk_audio_volume_get() == BT_HS_SPK_AUDIO_VOLUME_MAX)
             {
                 /* Already maximum volume */
-                /* Prompt audio to indicate the volume is already at maximum */
-                headset_button_audio_insert_config.sample_rate = bt_hs_spk_audio_audio_manager_sampling_rate_get();
-                headset_button_audio_insert_config.duration    = HEADSET_BUTTON_AUDIO_INSERT_DURATION;
-                headset_button_audio_insert_config.p_source    = bt_hs_spk_audio_audio_manager_channel_number_get() > 1 ? sine_wave_stereo : sine_wave_mono;
-                headset_button_audio_insert_config.len         = bt_hs_spk_audio_audio_manager_channel_number_get() > 1 ? sizeof(sine_wave_stereo) : sizeof(sine_wave_mono);
-                headset_button_audio_insert_config.stopped_when_state_is_changed = WICED_TRUE;
-                headset_button_audio_insert_config.p_timeout_callback = NULL;
-
-                bt_hs_spk_audio_insert_start(&headset_button_audio_insert_config);
-
-                WICED_BT_TRACE("AUDIO_INSERT_STARTED duration:%d sample_rate:%d\n",
-                               headset_button_audio_insert_config.duration,
-                               headset_button_audio_insert_config.sample_rate);
+                headset_defer(HEADSET_DEFER_PRIORITY_HIGH, &headset_button_audio_insert_start, (void *) HEADSET_BUTTON_AUDIO_INSERT_AUDIO);
             }
         }
     }
@@ -299,4 +295,141 @@ static wiced_bool_t headset_button_pre_handler(platform_button_t button, button_
     return WICED_TRUE;
 }
 
+#if HEADSET_BUTTON_TRACE
+/*
+ * Stamp the whole button path:
+ *  - GPIO: the debounced release edge, stamped by the button manager in ms of the system clock.
+ *    Events raised while the button is held come from the hold timers and have no edge.
+ *  - EVENT and DISPATCH: the pre-handler in and out.
+ *  - ACTION: the bt_hs_spk library runs the action of a passed event before returning to the
+ *    button manager, the deferred stamp runs right after it. Events without an action in the
+ *    map have no ACTION stamp.
+ */
+static wiced_bool_t headset_button_trace_pre_handler(platform_button_t button, button_manager_event_t event, button_manager_button_state_t state, uint32_t repeat)
+{
+    app_service_action_t action;
+    wiced_bool_t pass;
+
+    if ((state == BUTTON_STATE_RELEASED) && ((uint32_t) button < ARRAY_SIZE(app_buttons)))
+    {
+        headset_button_trace_record((uint32_t) (app_buttons[button].released_timestamp * 1000),
+                                    HEADSET_BUTTON_TRACE_STAGE_GPIO, button, event);
+    }
+
+    headset_button_trace_stamp(HEADSET_BUTTON_TRACE_STAGE_EVENT, button, event);
+
+    pass = headset_button_pre_handler(button, event, state, repeat);
+
+    headset_button_trace_stamp(HEADSET_BUTTON_TRACE_STAGE_DISPATCH, button, event);
+
+    if (pass && headset_button_action_resolve(button, event, state, repeat, &action))
+    {
+        headset_defer(HEADSET_DEFER_PRIORITY_HIGH, &headset_button_trace_action,
+                      (void *) (uintptr_t) ((button << 16) | event));
+    }
+
+    return pass;
+}
+
+static void headset_button_trace_action(void *p_arg)
+{
+    uint32_t arg = (uint32_t) (uintptr_t) p_arg;
+
+    headset_button_trace_stamp(HEADSET_BUTTON_TRACE_STAGE_ACTION, (platform_button_t) (arg >> 16),
+                               (button_manager_event_t) (arg & 0xffff));
+}
+#endif
+
+#ifdef AUDIO_INSERT_ENABLED
+/*
+ * Prompt audio to indicate the volume is already at maximum
+ */
+static void headset_button_audio_insert_start(void *p_arg)
+{
+    if ((uintptr_t) p_arg == HEADSET_BUTTON_AUDIO_INSERT_HANDSFREE)
+    {
+        headset_button_audio_insert_config.sample_rate = bt_hs_spk_handsfree_audio_manager_sampling_rate_get();
+        headset_button_audio_insert_config.duration    = HEADSET_BUTTON_AUDIO_INSERT_DURATION;
+        headset_button_audio_insert_config.p_source    = sine_wave_mono;
+        headset_button_audio_insert_config.len         = sizeof(sine_wave_mono);
+        headset_button_audio_insert_config.stopped_when_state_is_changed = WICED_TRUE;
+        headset_button_audio_insert_config.p_timeout_callback = NULL;
+    }
+    else
+    {
+        headset_button_audio_insert_config.sample_rate = bt_hs_spk_audio_audio_manager_sampling_rate_get();
+        headset_button_audio_insert_config.duration    = HEADSET_BUTTON_AUDIO_INSERT_DURATION;
+        headset_button_audio_insert_config.p_source    = bt_hs_spk_audio_audio_manager_channel_number_get() > 1 ? sine_wave_stereo : sine_wave_mono;
+        headset_button_audio_insert_config.len         = bt_hs_spk_audio_audio_manager_channel_number_get() > 1 ? sizeof(sine_wave_stereo) : sizeof(sine_wave_mono);
+        headset_button_audio_insert_config.stopped_when_state_is_changed = WICED_TRUE;
+        headset_button_audio_insert_config.p_timeout_callback = NULL;
+    }
+
+    bt_hs_spk_audio_insert_start(&headset_button_audio_insert_config);
+
+    WICED_BT_TRACE("AUDIO_INSERT_STARTED duration:%d sample_rate:%d\n",
+                   headset_button_audio_insert_config.duration,
+                   headset_button_audio_insert_config.sample_rate);
+}
+#endif
+
+/*
+ * Fill app_button_action[] with the mapped cells of the action map
+ */
+static uint32_t headset_button_action_list_build(void)
+{
+    uint32_t num = 0;
+    uint8_t button, slot;
+
+    for (button = 0; button < APP_BUTTON_MAX; button++)
+    {
+        for (slot = 0; slot < HEADSET_BUTTON_SLOT_NUM; slot++)
+        {
+            if (!app_button_map[button][slot].mapped)
+            {
+                continue;
+            }
+
+            app_button_action[num].action   = app_button_map[button][slot].action;
+            app_button_action[num].button   = (platform_button_t) button;
+            app_button_action[num].event    = app_button_slot[slot].event;
+            app_button_action[num].state    = app_button_slot[slot].state;
+            app_button_action[num].repeat   = app_button_slot[slot].repeat;
+            num++;
+        }
+    }
+
+    return num;
+}
+
+/*
+ * Column of the action map for an event, HEADSET_BUTTON_SLOT_NUM if none
+ */
+static uint8_t headset_button_slot_get(button_manager_event_t event, button_manager_button_state_t state, uint32_t repeat)
+{
+    wiced_bool_t held = (state == BUTTON_STATE_HELD) ? WICED_TRUE : WICED_FALSE;
+
+    switch (event)
+    {
+    case BUTTON_CLICK_EVENT:
+        return held ? HEADSET_BUTTON_SLOT_NUM : HEADSET_BUTTON_SLOT_CLICK;
+
+    case BUTTON_LONG_DURATION_EVENT:
+        return held ? HEADSET_BUTTON_SLOT_LONG_HELD : HEADSET_BUTTON_SLOT_LONG_RELEASED;
+
+    case BUTTON_VERY_LONG_DURATION_EVENT:
+        return held ? HEADSET_BUTTON_SLOT_VERY_LONG_HELD : HEADSET_BUTTON_SLOT_VERY_LONG_RELEASED;
+
+    case BUTTON_HOLDING_EVENT:
+        if (!held || (repeat < 1) || (repeat > 2))
+        {
+            return HEADSET_BUTTON_SLOT_NUM;
+        }
+        return (uint8_t) (HEADSET_BUTTON_SLOT_HOLD_1 + repeat - 1);
+
+    default:
+        return HEADSET_BUTTON_SLOT_NUM;
+    }
+}
+
 /* [] END OF FILE */
@@ -0,0 +1,98 @@
+/******************************************************************************
+* File Name:   headset_button.h
+*
+* Description: Indexed button action map.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#if !defined(HEADSET_BUTTON_H)
+#define HEADSET_BUTTON_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+#include "bt_hs_spk_button.h"
+#include "wiced_button_manager.h"
+#include "wiced_platform.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Columns of the action map: the (event, state, repeat) tuples a button can be mapped on */
+typedef enum
+{
+    HEADSET_BUTTON_SLOT_CLICK,                  /* BUTTON_CLICK_EVENT, released */
+    HEADSET_BUTTON_SLOT_LONG_HELD,              /* BUTTON_LONG_DURATION_EVENT, held */
+    HEADSET_BUTTON_SLOT_LONG_RELEASED,          /* BUTTON_LONG_DURATION_EVENT, released */
+    HEADSET_BUTTON_SLOT_VERY_LONG_HELD,         /* BUTTON_VERY_LONG_DURATION_EVENT, held */
+    HEADSET_BUTTON_SLOT_VERY_LONG_RELEASED,     /* BUTTON_VERY_LONG_DURATION_EVENT, released */
+    HEADSET_BUTTON_SLOT_HOLD_1,                 /* BUTTON_HOLDING_EVENT, held, repeat 1 */
+    HEADSET_BUTTON_SLOT_HOLD_2,                 /* BUTTON_HOLDING_EVENT, held, repeat 2 */
+    HEADSET_BUTTON_SLOT_NUM,
+} headset_button_slot_t;
+
+/*******************************************************************************
+*        External Variable Declarations
+*******************************************************************************/
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: headset_button_action_resolve
+********************************************************************************
+* Summary:
+*   Look up the action mapped on a button event in constant time.
+*
+* Parameters:
+*   button      : button
+*   event       : button event
+*   state       : button state
+*   repeat      : hold repeat count
+*   p_action    : output, the mapped action
+*
+* Return:
+*   WICED_TRUE if an action is mapped
+*
+*******************************************************************************/
+wiced_bool_t headset_button_action_resolve(platform_button_t button, button_manager_event_t event,
+                                           button_manager_button_state_t state, uint32_t repeat,
+                                           app_service_action_t *p_action);
+
+#endif /* HEADSET_BUTTON_H */
+/* [] END OF FILE */
@@ -0,0 +1,278 @@
+/******************************************************************************
+* File Name:   headset_button_trace.c
+*
+* Description: Button input latency tracing.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+
+#include "clock_timer.h"
+#include "headset_button_trace.h"
+#include "wiced_bt_trace.h"
+#include "wiced_timer.h"
+
+/*******************************************************************************
+* Structures
+********************************************************************************/
+typedef struct
+{
+    uint32_t    time_us;
+    uint8_t     button;
+    uint8_t     event;
+    uint8_t     stage;
+} headset_button_trace_entry_t;
+
+typedef struct
+{
+    headset_button_trace_entry_t    ring[HEADSET_BUTTON_TRACE_RING_SIZE];
+    uint32_t                        total;          /* Stamps recorded */
+    uint32_t                        reported;       /* Stamps already dumped */
+
+    uint32_t                        start_us[APP_BUTTON_MAX];       /* First stamp of the current event */
+    uint8_t                         start_valid[APP_BUTTON_MAX];
+    uint8_t                         last_stage[APP_BUTTON_MAX];
+
+    headset_button_trace_hist_t     hist[HEADSET_BUTTON_TRACE_STAGE_NUM];
+    wiced_timer_t                   report_timer;
+} headset_button_trace_cb_t;
+
+_Static_assert((HEADSET_BUTTON_TRACE_RING_SIZE & (HEADSET_BUTTON_TRACE_RING_SIZE - 1)) == 0,
+               "HEADSET_BUTTON_TRACE_RING_SIZE must be a power of 2");
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static headset_button_trace_cb_t headset_button_trace_cb;
+
+static const char * const headset_button_trace_stage_name[HEADSET_BUTTON_TRACE_STAGE_NUM] =
+{
+    [ HEADSET_BUTTON_TRACE_STAGE_GPIO ]     = "gpio",
+    [ HEADSET_BUTTON_TRACE_STAGE_EVENT ]    = "event",
+    [ HEADSET_BUTTON_TRACE_STAGE_DISPATCH ] = "dispatch",
+    [ HEADSET_BUTTON_TRACE_STAGE_ACTION ]   = "action",
+};
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void headset_button_trace_hist_add(headset_button_trace_hist_t *p_hist, uint32_t latency_us);
+static void headset_button_trace_report_timeout(WICED_TIMER_PARAM_TYPE arg);
+
+/*******************************************************************************
+* Global Function Definitions
+*******************************************************************************/
+
+void headset_button_trace_init(void)
+{
+    memset(&headset_button_trace_cb, 0, sizeof(headset_button_trace_cb));
+
+    wiced_init_timer(&headset_button_trace_cb.report_timer,
+                     headset_button_trace_report_timeout,
+                     0,
+                     WICED_MILLI_SECONDS_TIMER);
+}
+
+void headset_button_trace_stamp(headset_button_trace_stage_t stage, platform_button_t button,
+                                button_manager_event_t event)
+{
+    headset_button_trace_record((uint32_t) clock_SystemTimeMicroseconds64(), stage, button, event);
+
+    /* Report once the user is done pressing, not while the next event is waiting. */
+    if (stage == HEADSET_BUTTON_TRACE_STAGE_EVENT)
+    {
+        wiced_start_timer(&headset_button_trace_cb.report_timer, HEADSET_BUTTON_TRACE_REPORT_IDLE);
+    }
+}
+
+void headset_button_trace_record(uint32_t time_us, headset_button_trace_stage_t stage,
+                                 platform_button_t button, button_manager_event_t event)
+{
+    headset_button_trace_cb_t *p_cb = &headset_button_trace_cb;
+    headset_button_trace_entry_t *p_entry;
+
+    if (((uint32_t) button >= APP_BUTTON_MAX) ||
+        (stage >= HEADSET_BUTTON_TRACE_STAGE_NUM))
+    {
+        return;
+    }
+
+    p_entry = &p_cb->ring[p_cb->total & (HEADSET_BUTTON_TRACE_RING_SIZE - 1)];
+    p_entry->time_us    = time_us;
+    p_entry->button     = (uint8_t) button;
+    p_entry->event      = (uint8_t) event;
+    p_entry->stage      = (uint8_t) stage;
+    p_cb->total++;
+
+    /* An event without a GPIO edge just before it (hold timers) starts at the EVENT stamp. */
+    if ((stage == HEADSET_BUTTON_TRACE_STAGE_GPIO) ||
+        ((stage == HEADSET_BUTTON_TRACE_STAGE_EVENT) &&
+         (!p_cb->start_valid[button] || (p_cb->last_stage[button] != HEADSET_BUTTON_TRACE_STAGE_GPIO))))
+    {
+        p_cb->start_us[button]      = time_us;
+        p_cb->start_valid[button]   = 1;
+    }
+    else if (p_cb->start_valid[button])
+    {
+        /* Unsigned difference, correct across the 32-bit wrap of the clock. */
+        headset_button_trace_hist_add(&p_cb->hist[stage], time_us - p_cb->start_us[button]);
+    }
+
+    p_cb->last_stage[button] = (uint8_t) stage;
+}
+
+const headset_button_trace_hist_t *headset_button_trace_hist_get(headset_button_trace_stage_t stage)
+{
+    if ((stage == HEADSET_BUTTON_TRACE_STAGE_GPIO) ||
+        (stage >= HEADSET_BUTTON_TRACE_STAGE_NUM))
+    {
+        return NULL;
+    }
+
+    return &headset_button_trace_cb.hist[stage];
+}
+
+/*
+ * The timeline lines are the input of scripts/button_trace.py, keep their format in sync.
+ */
+void headset_button_trace_report(void)
+{
+    headset_button_trace_cb_t *p_cb = &headset_button_trace_cb;
+    headset_button_trace_entry_t *p_entry;
+    headset_button_trace_hist_t *p_hist;
+    uint32_t i;
+    uint8_t stage, b;
+
+    i = p_cb->reported;
+    if ((p_cb->total - i) > HEADSET_BUTTON_TRACE_RING_SIZE)
+    {
+        WICED_BT_TRACE("headset_button_trace: %d stamps lost\n", p_cb->total - i - HEADSET_BUTTON_TRACE_RING_SIZE);
+        i = p_cb->total - HEADSET_BUTTON_TRACE_RING_SIZE;
+    }
+
+    for (; i != p_cb->total; i++)
+    {
+        p_entry = &p_cb->ring[i & (HEADSET_BUTTON_TRACE_RING_SIZE - 1)];
+
+        WICED_BT_TRACE("headset_button_trace: t %u button %d event %d %s\n",
+                       p_entry->time_us, p_entry->button, p_entry->event,
+                       headset_button_trace_stage_name[p_entry->stage]);
+    }
+
+    p_cb->reported = p_cb->total;
+
+    for (stage = HEADSET_BUTTON_TRACE_STAGE_EVENT; stage < HEADSET_BUTTON_TRACE_STAGE_NUM; stage++)
+    {
+        p_hist = &p_cb->hist[stage];
+
+        if (p_hist->count == 0)
+        {
+            continue;
+        }
+
+        WICED_BT_TRACE("headset_button_trace: %s n %d min %d avg %d max %d us\n",
+                       headset_button_trace_stage_name[stage],
+                       p_hist->count,
+                       p_hist->min_us,
+                       (uint32_t) (p_hist->sum_us / p_hist->count),
+                       p_hist->max_us);
+
+        for (b = 0; b < HEADSET_BUTTON_TRACE_HIST_BUCKETS; b++)
+        {
+            if (p_hist->bucket[b] == 0)
+            {
+                continue;
+            }
+
+            if (b < HEADSET_BUTTON_TRACE_HIST_BUCKETS - 1)
+            {
+                WICED_BT_TRACE("headset_button_trace:   < %d us: %d\n",
+                               1 << (b + HEADSET_BUTTON_TRACE_HIST_SHIFT + 1), p_hist->bucket[b]);
+            }
+            else
+            {
+                WICED_BT_TRACE("headset_button_trace:  >= %d us: %d\n",
+                               1 << (b + HEADSET_BUTTON_TRACE_HIST_SHIFT), p_hist->bucket[b]);
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Static Function Definitions
+*******************************************************************************/
+
+/*
+ * Log2 buckets: bucket b holds [2^(b + SHIFT), 2^(b + SHIFT + 1)) us, the first one also holds
+ * everything below and the last one everything above.
+ */
+static void headset_button_trace_hist_add(headset_button_trace_hist_t *p_hist, uint32_t latency_us)
+{
+    uint32_t v = latency_us >> (HEADSET_BUTTON_TRACE_HIST_SHIFT + 1);
+    uint8_t b = 0;
+
+    while ((v != 0) && (b < HEADSET_BUTTON_TRACE_HIST_BUCKETS - 1))
+    {
+        v >>= 1;
+        b++;
+    }
+
+    if ((p_hist->count == 0) || (latency_us < p_hist->min_us))
+    {
+        p_hist->min_us = latency_us;
+    }
+
+    if (latency_us > p_hist->max_us)
+    {
+        p_hist->max_us = latency_us;
+    }
+
+    p_hist->count++;
+    p_hist->sum_us += latency_us;
+    p_hist->bucket[b]++;
+}
+
+static void headset_button_trace_report_timeout(WICED_TIMER_PARAM_TYPE arg)
+{
+    (void) arg;
+
+    headset_button_trace_report();
+}
+
+/* [] END OF FILE */
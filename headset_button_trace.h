@@ -0,0 +1,190 @@
+/******************************************************************************
+* File Name:   headset_button_trace.h
+*
+* Description: Button input latency tracing.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#if !defined(HEADSET_BUTTON_TRACE_H)
+#define HEADSET_BUTTON_TRACE_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+#include "wiced_button_manager.h"
+#include "wiced_platform.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Stamp the button path and report the latencies over the trace (HCI) transport */
+#ifndef HEADSET_BUTTON_TRACE
+#define HEADSET_BUTTON_TRACE                    0
+#endif
+
+/* Number of stamps kept for the timeline dump, power of 2 */
+#define HEADSET_BUTTON_TRACE_RING_SIZE          32
+
+/* Latency histogram: bucket 0 is below 2^(SHIFT + 1) us, each next bucket doubles */
+#define HEADSET_BUTTON_TRACE_HIST_BUCKETS       16
+#define HEADSET_BUTTON_TRACE_HIST_SHIFT         4
+
+/* The report is traced once the buttons have been idle for this long */
+#ifndef HEADSET_BUTTON_TRACE_REPORT_IDLE
+#define HEADSET_BUTTON_TRACE_REPORT_IDLE        5000    /* ms */
+#endif
+
+/*******************************************************************************
+*        Data Types
+*******************************************************************************/
+typedef enum
+{
+    HEADSET_BUTTON_TRACE_STAGE_GPIO,        /* Debounced GPIO edge, from the button manager (ms resolution) */
+    HEADSET_BUTTON_TRACE_STAGE_EVENT,       /* Button manager event reaches the pre-handler */
+    HEADSET_BUTTON_TRACE_STAGE_DISPATCH,    /* Pre-handler done, event passed to bt_hs_spk or consumed */
+    HEADSET_BUTTON_TRACE_STAGE_ACTION,      /* bt_hs_spk returned from the action of a passed event */
+
+    HEADSET_BUTTON_TRACE_STAGE_NUM,
+} headset_button_trace_stage_t;
+
+/*
+ * Latency from the first stamp of the event to a later stage. The first stamp is the GPIO
+ * edge when the event follows one (release), else the EVENT stamp (hold timers).
+ */
+typedef struct
+{
+    uint32_t    count;
+    uint32_t    min_us;
+    uint32_t    max_us;
+    uint64_t    sum_us;
+    uint32_t    bucket[HEADSET_BUTTON_TRACE_HIST_BUCKETS];
+} headset_button_trace_hist_t;
+
+/*******************************************************************************
+*        External Variable Declarations
+*******************************************************************************/
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: headset_button_trace_init
+********************************************************************************
+* Summary:
+*   Initialize the button tracing and clear the histograms.
+*
+* Parameters:
+*   void
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_button_trace_init(void);
+
+/*******************************************************************************
+* Function Name: headset_button_trace_stamp
+********************************************************************************
+* Summary:
+*   Record a stage of a button event with the current time.
+*
+* Parameters:
+*   stage       : stage reached
+*   button      : button
+*   event       : button event
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_button_trace_stamp(headset_button_trace_stage_t stage, platform_button_t button,
+                                button_manager_event_t event);
+
+/*******************************************************************************
+* Function Name: headset_button_trace_record
+********************************************************************************
+* Summary:
+*   Record a stage with a given time. headset_button_trace_stamp uses the system
+*   clock, this entry point takes the times stamped elsewhere (the GPIO edges of
+*   the button manager) and replays recorded timelines.
+*
+* Parameters:
+*   time_us     : time of the stage in us
+*   stage       : stage reached
+*   button      : button
+*   event       : button event
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_button_trace_record(uint32_t time_us, headset_button_trace_stage_t stage,
+                                 platform_button_t button, button_manager_event_t event);
+
+/*******************************************************************************
+* Function Name: headset_button_trace_hist_get
+********************************************************************************
+* Summary:
+*   Get the latency histogram of a stage.
+*
+* Parameters:
+*   stage       : HEADSET_BUTTON_TRACE_STAGE_EVENT, _DISPATCH or _ACTION
+*
+* Return:
+*   histogram, NULL for HEADSET_BUTTON_TRACE_STAGE_GPIO
+*
+*******************************************************************************/
+const headset_button_trace_hist_t *headset_button_trace_hist_get(headset_button_trace_stage_t stage);
+
+/*******************************************************************************
+* Function Name: headset_button_trace_report
+********************************************************************************
+* Summary:
+*   Trace the stamps recorded since the last report and the latency histograms.
+*
+* Parameters:
+*   void
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_button_trace_report(void);
+
+#endif /* HEADSET_BUTTON_TRACE_H */
+/* [] END OF FILE */
@@ -46,15 +46,26 @@
 
 #include "bt_hs_spk_control.h"
 #include "bt_hs_spk_handsfree.h"
+#include "headset_adv_sched.h"
+#include "headset_btm_evt.h"
 #include "headset_control.h"
 #include "headset_control_le.h"
+#include "headset_defer.h"
+#include "headset_eir.h"
+#include "headset_le_conn_param.h"
+#include "headset_link_state.h"
 #include "headset_nvram.h"
+#include "headset_power.h"
+#include "headset_sniff.h"
 #include "wiced_app_cfg.h"
 #include "wiced_bt_dev.h"
 #include "wiced_bt_stack.h"
 #include "wiced_memory.h"
 #include "wiced_result.h"
 #include "wiced.h"
+#ifdef OTA_FW_UPGRADE
+#include "wiced_bt_ota_firmware_upgrade.h"
+#endif
 
 /*******************************************************************************
 * Macros
@@ -69,6 +80,9 @@ typedef struct
 {
     wiced_bt_local_identity_keys_t  local_irk;
     wiced_result_t                  result;
+
+    wiced_bt_local_identity_keys_t  pending;        /* Key waiting for its NVRAM write */
+    wiced_bool_t                    write_queued;
 } headset_control_local_irk_info_t;
 
 /*******************************************************************************
@@ -85,10 +99,52 @@ extern wiced_bt_audio_config_buffer_t wiced_bt_audio_buf_config;
 /*******************************************************************************
 * Function Prototypes
 ********************************************************************************/
-static wiced_result_t   btheadset_control_management_callback(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data);
+static wiced_result_t   headset_control_btm_device_handler(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data);
+static wiced_result_t   headset_control_btm_keys_handler(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data);
+static wiced_result_t   headset_control_btm_le_handler(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data);
+static wiced_result_t   headset_control_btm_power_handler(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data);
+static wiced_result_t   headset_control_btm_sco_handler(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data);
+static wiced_result_t   headset_control_btm_security_handler(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data);
 static wiced_result_t   btheadset_post_bt_init(void);
+static void             headset_control_bt_start(void *p_arg);
 static void             headset_control_local_irk_restore(void);
 static void             headset_control_local_irk_update(uint8_t *p_key);
+static void             headset_control_local_irk_write(void *p_arg);
+
+/*
+ * Management event handlers, one per event. A handler that feeds several modules calls them
+ * itself, in the order they need (see headset_control_btm_sco_handler).
+ */
+static const struct
+{
+    wiced_bt_management_evt_t   event;
+    headset_btm_evt_handler_t   p_handler;
+} headset_control_btm_evt_handlers[] =
+{
+    { BTM_ENABLED_EVT,                                  &headset_control_btm_device_handler },
+    { BTM_DISABLED_EVT,                                 &headset_control_btm_device_handler },
+    { BTM_POWER_MANAGEMENT_STATUS_EVT,                  &headset_control_btm_power_handler },
+    { BTM_PIN_REQUEST_EVT,                              &headset_control_btm_security_handler },
+    { BTM_USER_CONFIRMATION_REQUEST_EVT,                &headset_control_btm_security_handler },
+    { BTM_PASSKEY_NOTIFICATION_EVT,                     &headset_control_btm_security_handler },
+    { BTM_PAIRING_IO_CAPABILITIES_BR_EDR_REQUEST_EVT,   &headset_control_btm_security_handler },
+    { BTM_PAIRING_IO_CAPABILITIES_BR_EDR_RESPONSE_EVT,  &headset_control_btm_security_handler },
+    { BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT,      &headset_control_btm_security_handler },
+    { BTM_PAIRING_COMPLETE_EVT,                         &headset_control_btm_security_handler },
+    { BTM_ENCRYPTION_STATUS_EVT,                        &headset_control_btm_security_handler },
+    { BTM_SECURITY_REQUEST_EVT,                         &headset_control_btm_security_handler },
+    { BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT,           &headset_control_btm_keys_handler },
+    { BTM_PAIRED_DEVICE_LINK_KEYS_REQUEST_EVT,          &headset_control_btm_keys_handler },
+    { BTM_LOCAL_IDENTITY_KEYS_UPDATE_EVT,               &headset_control_btm_keys_handler },
+    { BTM_LOCAL_IDENTITY_KEYS_REQUEST_EVT,              &headset_control_btm_keys_handler },
+    { BTM_BLE_ADVERT_STATE_CHANGED_EVT,                 &headset_control_btm_le_handler },
+    { BTM_BLE_CONNECTION_PARAM_UPDATE,                  &headset_control_btm_le_handler },
+    { BTM_BLE_PHY_UPDATE_EVT,                           &headset_control_btm_le_handler },
+    { BTM_SCO_CONNECTION_REQUEST_EVT,                   &headset_control_btm_sco_handler },
+    { BTM_SCO_CONNECTED_EVT,                            &headset_control_btm_sco_handler },
+    { BTM_SCO_DISCONNECTED_EVT,                         &headset_control_btm_sco_handler },
+    { BTM_SCO_CONNECTION_CHANGE_EVT,                    &headset_control_btm_sco_handler },
+};
 
 /*******************************************************************************
 * Global Function Definitions
@@ -104,25 +160,39 @@ static void             headset_control_local_irk_update(uint8_t *p_key);
 * Return:       void
 *
 *******************************************************************************/
-void btheadset_control_init( void )
+wiced_result_t btheadset_control_init( void )
 {
     wiced_result_t ret = WICED_BT_ERROR;
+    uint8_t i;
 
     /* Create default heap */
     p_default_heap = wiced_bt_create_heap("default_heap", NULL, BT_STACK_HEAP_SIZE, NULL, WICED_TRUE);
     if (p_default_heap == NULL)
     {
         WICED_BT_TRACE("create default heap error: size %d\n", BT_STACK_HEAP_SIZE);
-        return;
+        return WICED_BT_NO_RESOURCES;
+    }
+
+    /* A handler lost here would leave the stack with default answers, don't start without it. */
+    for (i = 0; i < sizeof(headset_control_btm_evt_handlers) / sizeof(headset_control_btm_evt_handlers[0]); i++)
+    {
+        ret = headset_btm_evt_register(headset_control_btm_evt_handlers[i].event,
+                                       headset_control_btm_evt_handlers[i].p_handler);
+        if (ret != WICED_BT_SUCCESS)
+        {
+            WICED_BT_TRACE("headset_btm_evt_register event %d error: %d\n",
+                           headset_control_btm_evt_handlers[i].event, ret);
+            return ret;
+        }
     }
 
     /* Initialize/Enable the BT stack. */
-    ret = wiced_bt_stack_init(btheadset_control_management_callback, &wiced_bt_cfg_settings);
+    ret = wiced_bt_stack_init(headset_btm_evt_dispatch, &wiced_bt_cfg_settings);
 
     if( ret != WICED_BT_SUCCESS )
     {
         WICED_BT_TRACE("wiced_bt_stack_init returns error: %d\n", ret);
-        return;
+        return ret;
     }
 
     WICED_BT_TRACE("Device Class: 0x%02x%02x%02x\n",
@@ -135,11 +205,13 @@ void btheadset_control_init( void )
     if( ret != WICED_BT_SUCCESS )
     {
         WICED_BT_TRACE("wiced_audio_buffer_initialize returns error: %d\n", ret);
-        return;
+        return ret;
     }
 
     /* Restore local Identify Resolving Key (IRK) for LE Private Resolvable Address. */
     headset_control_local_irk_restore();
+
+    return WICED_BT_SUCCESS;
 }
 
 /*******************************************************************************
@@ -147,18 +219,11 @@ void btheadset_control_init( void )
 *******************************************************************************/
 
 /*
- *  Management callback receives various notifications from the stack
+ * Device: stack enabled / disabled
  */
-static wiced_result_t btheadset_control_management_callback( wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data )
+static wiced_result_t headset_control_btm_device_handler(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data)
 {
-    wiced_result_t                     result = WICED_BT_SUCCESS;
-    wiced_bt_dev_encryption_status_t  *p_encryption_status;
-    wiced_bt_dev_pairing_cplt_t        *p_pairing_cmpl;
-    uint8_t                             pairing_result;
-
-    WICED_BT_TRACE("%s(%u)\n", __FUNCTION__, event);
-
-    switch(event)
+    switch (event)
     {
     case BTM_ENABLED_EVT:
         if( p_event_data->enabled.status != WICED_BT_SUCCESS )
@@ -167,23 +232,41 @@ static wiced_result_t btheadset_control_management_callback( wiced_bt_management
         }
         else
         {
-            btheadset_post_bt_init();
+            /* Profiles and buttons are set up from the work queue, after the stack is done with this event. */
+            headset_defer_init();
 
-            if (WICED_SUCCESS != btheadset_init_button_interface())
-                WICED_BT_TRACE("btheadset button init failed\n");
-
-            WICED_BT_TRACE("Free RAM sizes: %ld\n", wiced_memory_get_free_bytes());
+            if (headset_defer(HEADSET_DEFER_PRIORITY_HIGH, &headset_control_bt_start, NULL) != WICED_BT_SUCCESS)
+            {
+                headset_control_bt_start(NULL);
+            }
         }
         break;
 
     case BTM_DISABLED_EVT:
         //hci_control_send_device_error_evt( p_event_data->disabled.reason, 0 );
+        headset_btm_evt_stats_report();
+        headset_defer_stats_report();
         break;
 
-    case BTM_POWER_MANAGEMENT_STATUS_EVT:
-        bt_hs_spk_control_btm_event_handler_power_management_status(&p_event_data->power_mgmt_notification);
+    default:
         break;
+    }
+
+    return WICED_BT_SUCCESS;
+}
+
+/*
+ * Security: pairing and encryption
+ */
+static wiced_result_t headset_control_btm_security_handler(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data)
+{
+    wiced_result_t                     result = WICED_BT_SUCCESS;
+    wiced_bt_dev_encryption_status_t  *p_encryption_status;
+    wiced_bt_dev_pairing_cplt_t        *p_pairing_cmpl;
+    uint8_t                             pairing_result;
 
+    switch (event)
+    {
     case BTM_PIN_REQUEST_EVT:
         WICED_BT_TRACE("remote address= %B\n", p_event_data->pin_request.bd_addr);
         //wiced_bt_dev_pin_code_reply(*p_event_data->pin_request.bd_addr, WICED_BT_SUCCESS, WICED_PIN_CODE_LEN, (uint8_t *)&pincode[0]);
@@ -279,7 +362,7 @@ static wiced_result_t btheadset_control_management_callback( wiced_bt_management
         {
             pairing_result = p_pairing_cmpl->pairing_complete_info.ble.reason;
             WICED_BT_TRACE("LE Pairing Result: %02x\n", pairing_result);
-        }        
+        }
         break;
 
     case BTM_ENCRYPTION_STATUS_EVT:
@@ -304,6 +387,22 @@ static wiced_result_t btheadset_control_management_callback( wiced_bt_management
         }
         break;
 
+    default:
+        break;
+    }
+
+    return result;
+}
+
+/*
+ * Keys: link keys and local identity keys storage
+ */
+static wiced_result_t headset_control_btm_keys_handler(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data)
+{
+    wiced_result_t result = WICED_BT_SUCCESS;
+
+    switch (event)
+    {
     case BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT:
         result = bt_hs_spk_control_btm_event_handler_link_key(event, &p_event_data->paired_device_link_keys_update) ? WICED_BT_SUCCESS : WICED_BT_ERROR;
         break;
@@ -337,15 +436,69 @@ static wiced_result_t btheadset_control_management_callback( wiced_bt_management
         }
         break;
 
+    default:
+        break;
+    }
+
+    return result;
+}
+
+/*
+ * SCO: handled by the handsfree library. Sniff is left before the library answers the
+ * connection request, the link loads follow the connection once the library has handled it.
+ */
+static wiced_result_t headset_control_btm_sco_handler(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data)
+{
+    if (event == BTM_SCO_CONNECTION_REQUEST_EVT)
+    {
+        /* Leave sniff at once for the incoming call setup. */
+        headset_sniff_wake();
+    }
+
+    hf_sco_management_callback(event, p_event_data);
+
+    if ((event == BTM_SCO_CONNECTED_EVT) || (event == BTM_SCO_DISCONNECTED_EVT))
+    {
+        headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_ESCO, event == BTM_SCO_CONNECTED_EVT);
+        headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_CALL, event == BTM_SCO_CONNECTED_EVT);
+        headset_power_input_set(HEADSET_POWER_INPUT_CALL, event == BTM_SCO_CONNECTED_EVT);
+    }
+
+    return WICED_BT_SUCCESS;
+}
+
+/*
+ * Power: sniff mode
+ */
+static wiced_result_t headset_control_btm_power_handler(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data)
+{
+    switch (event)
+    {
+    case BTM_POWER_MANAGEMENT_STATUS_EVT:
+        bt_hs_spk_control_btm_event_handler_power_management_status(&p_event_data->power_mgmt_notification);
+
+        headset_sniff_mode_change(p_event_data->power_mgmt_notification.bd_addr,
+                                  p_event_data->power_mgmt_notification.status);
+        break;
+
+    default:
+        break;
+    }
+
+    return WICED_BT_SUCCESS;
+}
+
+/*
+ * LE: advertising state and connection updates
+ */
+static wiced_result_t headset_control_btm_le_handler(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data)
+{
+    switch (event)
+    {
     case BTM_BLE_ADVERT_STATE_CHANGED_EVT:
         WICED_BT_TRACE("BLE_ADVERT_STATE_CHANGED_EVT:%d\n", p_event_data->ble_advert_state_changed);
-        break;
 
-    case BTM_SCO_CONNECTED_EVT:
-    case BTM_SCO_DISCONNECTED_EVT:
-    case BTM_SCO_CONNECTION_REQUEST_EVT:
-    case BTM_SCO_CONNECTION_CHANGE_EVT:
-        hf_sco_management_callback(event, p_event_data);
+        headset_adv_sched_advert_state_changed(p_event_data->ble_advert_state_changed);
         break;
 
     case BTM_BLE_CONNECTION_PARAM_UPDATE:
@@ -355,6 +508,10 @@ static wiced_result_t btheadset_control_management_callback( wiced_bt_management
                        p_event_data->ble_connection_param_update.conn_interval,
                        p_event_data->ble_connection_param_update.conn_latency,
                        p_event_data->ble_connection_param_update.supervision_timeout);
+
+        headset_le_conn_param_update_evt(p_event_data->ble_connection_param_update.status,
+                                         p_event_data->ble_connection_param_update.conn_interval,
+                                         p_event_data->ble_connection_param_update.conn_latency);
         break;
 
     case BTM_BLE_PHY_UPDATE_EVT:
@@ -362,14 +519,16 @@ static wiced_result_t btheadset_control_management_callback( wiced_bt_management
         WICED_BT_TRACE("PHY config is updated as TX_PHY : %dM, RX_PHY : %dM\n",
                 p_event_data->ble_phy_update_event.tx_phy,
                 p_event_data->ble_phy_update_event.rx_phy);
+
+        headset_le_conn_param_phy_update_evt(p_event_data->ble_phy_update_event.tx_phy,
+                                             p_event_data->ble_phy_update_event.rx_phy);
         break;
 
     default:
-        result = WICED_BT_USE_DEFAULT_SECURITY;
         break;
     }
 
-    return result;
+    return WICED_BT_SUCCESS;
 }
 
 /*
@@ -394,49 +553,84 @@ static void headset_control_local_irk_restore(void)
  */
 static void headset_control_local_irk_update(uint8_t *p_key)
 {
-    uint16_t nb_bytes;
-    wiced_result_t result;
-
     /* Check if the IRK shall be updated. */
     if (memcmp((void *) p_key,
                (void *) &local_irk_info.local_irk,
                BTM_SECURITY_LOCAL_KEY_DATA_LEN) != 0)
     {
-        nb_bytes = wiced_hal_write_nvram(HEADSET_NVRAM_ID_LOCAL_IRK,
-                                         BTM_SECURITY_LOCAL_KEY_DATA_LEN,
-                                         p_key,
-                                         &result);
+        /* Write from the work queue. Updates in a row share one write of the latest key. */
+        memcpy((void *) &local_irk_info.pending,
+               (void *) p_key,
+               BTM_SECURITY_LOCAL_KEY_DATA_LEN);
 
-        WICED_BT_TRACE("Update local IRK (result: %d, nb_bytes: %d)\n",
-               result,
-               nb_bytes);
-
-        if ((nb_bytes == BTM_SECURITY_LOCAL_KEY_DATA_LEN) &&
-            (result == WICED_BT_SUCCESS))
+        if (local_irk_info.write_queued)
         {
-            memcpy((void *) &local_irk_info.local_irk,
-                   (void *) p_key,
-                   BTM_SECURITY_LOCAL_KEY_DATA_LEN);
+            return;
+        }
+
+        local_irk_info.write_queued = WICED_TRUE;
 
-            local_irk_info.result = result;
+        if (headset_defer(HEADSET_DEFER_PRIORITY_LOW, &headset_control_local_irk_write, NULL) != WICED_BT_SUCCESS)
+        {
+            headset_control_local_irk_write(NULL);
         }
     }
 }
 
+static void headset_control_local_irk_write(void *p_arg)
+{
+    uint16_t nb_bytes;
+    wiced_result_t result;
+
+    (void) p_arg;
+
+    local_irk_info.write_queued = WICED_FALSE;
+
+    nb_bytes = wiced_hal_write_nvram(HEADSET_NVRAM_ID_LOCAL_IRK,
+                                     BTM_SECURITY_LOCAL_KEY_DATA_LEN,
+                                     (uint8_t *) &local_irk_info.pending,
+                                     &result);
+
+    WICED_BT_TRACE("Update local IRK (result: %d, nb_bytes: %d)\n",
+           result,
+           nb_bytes);
+
+    if ((nb_bytes == BTM_SECURITY_LOCAL_KEY_DATA_LEN) &&
+        (result == WICED_BT_SUCCESS))
+    {
+        memcpy((void *) &local_irk_info.local_irk,
+               (void *) &local_irk_info.pending,
+               BTM_SECURITY_LOCAL_KEY_DATA_LEN);
+
+        local_irk_info.result = result;
+    }
+}
+
+/*
+ * Set up the profiles and the buttons once the stack is enabled
+ */
+static void headset_control_bt_start(void *p_arg)
+{
+    (void) p_arg;
+
+    btheadset_post_bt_init();
+
+    if (WICED_SUCCESS != btheadset_init_button_interface())
+        WICED_BT_TRACE("btheadset button init failed\n");
+
+    WICED_BT_TRACE("Free RAM sizes: %ld\n", wiced_memory_get_free_bytes());
+}
+
 static wiced_result_t btheadset_post_bt_init(void)
 {
     wiced_bool_t ret = WICED_FALSE;
     bt_hs_spk_control_config_t config = {0};
-    bt_hs_spk_eir_config_t eir = {0};
 
-    eir.p_dev_name              = (char *) wiced_bt_cfg_settings.device_name;
-    eir.default_uuid_included   = WICED_TRUE;
-    
-    if (WICED_SUCCESS != bt_hs_spk_write_eir(&eir))
+    if (WICED_SUCCESS != headset_eir_write((const char *) wiced_bt_cfg_settings.device_name))
     {
         WICED_BT_TRACE("Write EIR Failed\n");
     }
-    
+
     ret = wiced_bt_sdp_db_init((uint8_t *) btheadset_sdp_db, wiced_app_cfg_sdp_record_get_size());
     if (ret != TRUE)
     {
@@ -444,7 +638,7 @@ static wiced_result_t btheadset_post_bt_init(void)
         return WICED_BT_ERROR;
     }
 
-    config.conn_status_change_cb            = NULL;
+    config.conn_status_change_cb            = headset_link_state_conn_status_change;
 #ifdef LOW_POWER_MEASURE_MODE
     config.discoverable_timeout             = 60;   /* 60 Sec */
 #else
@@ -453,7 +647,7 @@ static wiced_result_t btheadset_post_bt_init(void)
     config.acl3mbpsPacketSupport            = WICED_TRUE;
     config.audio.a2dp.p_audio_config        = &bt_audio_config;
     config.audio.a2dp.p_pre_handler         = NULL;
-    config.audio.a2dp.post_handler          = NULL;
+    config.audio.a2dp.post_handler          = headset_link_state_a2dp_post_handler;
     config.audio.avrc_ct.p_supported_events = bt_avrc_ct_supported_events;
     config.hfp.rfcomm.buffer_size           = 700;
     config.hfp.rfcomm.buffer_count          = 4;
@@ -492,6 +686,9 @@ static wiced_result_t btheadset_post_bt_init(void)
     WICED_BT_TRACE("Default Application: Headset\n");
 #endif
 
+    headset_sniff_init();
+    headset_power_init();
+
 #if (WICED_APP_LE_INCLUDED == TRUE)
     hci_control_le_enable();
 #endif
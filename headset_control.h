@@ -64,10 +64,11 @@
 *
 * Parameters:   void
 *
-* Return:       void
+* Return:       WICED_BT_SUCCESS, or the error of the first step that failed (audio buffer
+*               layout check, heap creation, stack or audio buffer initialization)
 *
 **************************************************************************************************/
-void btheadset_control_init(void);
+wiced_result_t btheadset_control_init(void);
 wiced_result_t btheadset_init_button_interface(void);
 
 #endif /* HEADSET_CONTROL_H */
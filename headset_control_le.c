@@ -44,9 +44,13 @@
 * Header Files
 *******************************************************************************/
 #include <stdint.h>
+#include <string.h>
 
 #include "bt_hs_spk_control.h"
+#include "headset_adv_sched.h"
 #include "headset_control_le.h"
+#include "headset_le_conn_param.h"
+#include "headset_power.h"
 #include "wiced.h"
 #include "wiced_app_cfg.h"
 #include "wiced_bt_gatt.h"
@@ -54,11 +58,30 @@
 #include "wiced_bt_trace.h"
 #include "wiced_bt_types.h"
 #include "wiced_memory.h"
+#ifdef FASTPAIR_ENABLE
+#include "headset_nvram.h"
+#include "wiced_bt_gfps.h"
+#endif
+#ifdef OTA_FW_UPGRADE
+#include "clock_timer.h"
+#include "wiced_bt_ota_firmware_upgrade.h"
+#endif
 
 
 /*******************************************************************************
 * Macros
 ********************************************************************************/
+/* LE name, built at compile time from the BR/EDR name */
+#define HEADSET_CONTROL_LE_DEV_NAME     WICED_DEVICE_NAME " LE"
+
+#ifdef FASTPAIR_ENABLE
+/*
+ * Room left for appended elements in the discoverable Fast Pair advertisement:
+ * 31 bytes - flags (3) - Tx power (3) - Fast Pair service data with model id (7)
+ */
+#define HEADSET_CONTROL_LE_ADV_APPEND_MAX   (31 - 3 - 3 - 7)
+#endif
+
 typedef struct
 {
     uint16_t handle;
@@ -71,6 +94,12 @@ typedef struct
 ********************************************************************************/
 wiced_bt_db_hash_t headset_db_hash;
 
+#ifdef FASTPAIR_ENABLE
+/* Anti-spoofing key pair of the Fast Pair model, provided with FASTPAIR_MODEL_ID by the product build */
+extern const uint8_t anti_spoofing_public_key[WICED_BT_GFPS_ANTI_SPOOFING_KEY_LEN_PUBLIC];
+extern const uint8_t anti_spoofing_private_key[WICED_BT_GFPS_ANTI_SPOOFING_KEY_LEN_PRIVATE];
+#endif
+
 /******************************************************************************
  *                                GATT DATABASE
  ******************************************************************************/
@@ -176,16 +205,28 @@ const uint8_t gatt_server_db[]=
         CHAR_DESCRIPTOR_UUID16_WRITABLE(HANDLE_OTA_FW_UPGRADE_CLIENT_CONFIGURATION_DESCRIPTOR, UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION,
             GATTDB_PERM_READABLE | GATTDB_PERM_WRITE_REQ),
 
-        /* characteristic Data. */
+        /* characteristic Data. Write without response lets the peer stream image data back to back. */
         CHARACTERISTIC_UUID128_WRITABLE(HANDLE_OTA_FW_UPGRADE_CHARACTERISTIC_DATA, HANDLE_OTA_FW_UPGRADE_DATA,
-            UUID_OTA_FW_UPGRADE_CHARACTERISTIC_DATA, GATTDB_CHAR_PROP_WRITE,
-            GATTDB_PERM_VARIABLE_LENGTH | GATTDB_PERM_WRITE_REQ | LEGATTDB_PERM_RELIABLE_WRITE),
+            UUID_OTA_FW_UPGRADE_CHARACTERISTIC_DATA, GATTDB_CHAR_PROP_WRITE | GATTDB_CHAR_PROP_WRITE_NO_RESPONSE,
+            GATTDB_PERM_VARIABLE_LENGTH | GATTDB_PERM_WRITE_REQ | GATTDB_PERM_WRITE_CMD | LEGATTDB_PERM_RELIABLE_WRITE),
 #endif /* OTA_FW_UPGRADE */
 };
 
 static uint8_t  headset_speaker_battery_level;
 
-static uint8_t  headset_speaker_device_name[]           = "HSPK LE";
+#ifdef OTA_FW_UPGRADE
+/* Image transfer statistics of the current LE link */
+static struct
+{
+    uint32_t    bytes;
+    uint32_t    packets;
+    uint64_t    start_us;
+    uint64_t    last_us;
+    uint16_t    mtu;        /* ATT MTU agreed with the peer, 23 until the exchange */
+} headset_control_le_ota_stats;
+#endif
+
+static uint8_t  headset_speaker_device_name[]           = HEADSET_CONTROL_LE_DEV_NAME;
 static uint8_t  headset_speaker_appearance_name[2]      = {BIT16_TO_8(APPEARANCE_GENERIC_TAG)};
 static char     headset_speaker_char_mfr_name_value[]   = { 'C', 'y', 'p', 'r', 'e', 's', 's', 0, };
 static char     headset_speaker_char_model_num_value[]  = { '1', '2', '3', '4',   0,   0,   0,   0 };
@@ -201,6 +242,19 @@ static attribute_t gauAttributes[] =
     { HANDLE_HSENS_BATTERY_SERVICE_CHAR_LEVEL_VAL,      1,                                              &headset_speaker_battery_level },
 };
 
+#ifdef FASTPAIR_ENABLE
+/* Element appended to the Fast Pair advertisement, complete name without the NUL */
+static wiced_bt_ble_advert_elem_t headset_control_le_adv_elem =
+{
+    .advert_type    = BTM_BLE_ADVERT_TYPE_NAME_COMPLETE,
+    .len            = sizeof(HEADSET_CONTROL_LE_DEV_NAME) - 1,
+    .p_data         = headset_speaker_device_name,
+};
+
+_Static_assert((sizeof(HEADSET_CONTROL_LE_DEV_NAME) - 1 + 2) <= HEADSET_CONTROL_LE_ADV_APPEND_MAX,
+               "LE device name does not fit in the Fast Pair advertisement");
+#endif
+
 /*******************************************************************************
 * Function Prototypes
 ********************************************************************************/
@@ -219,9 +273,10 @@ static wiced_bt_gatt_status_t   hci_control_le_read_multi_handler(uint16_t conn_
         wiced_bt_gatt_read_multiple_req_t *p_read_req, uint16_t len_requested);
 static wiced_bt_gatt_status_t   hci_control_le_write_handler(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
         wiced_bt_gatt_write_req_t* p_data);
-#ifdef FASTPAIR_ENABLE        
-static void                     headset_control_le_discoverabilty_change_callback(wiced_bool_t discoverable);
+#ifdef OTA_FW_UPGRADE
+static void                     hci_control_le_ota_stats_report(void);
 #endif
+static void                     headset_control_le_discoverabilty_change_callback(wiced_bool_t discoverable);
 static attribute_t              *hci_control_get_attribute(uint16_t handle);
 
 /*******************************************************************************
@@ -246,9 +301,6 @@ void hci_control_le_enable(void)
     wiced_bt_gatt_status_t gatt_status;
 #ifdef FASTPAIR_ENABLE
     wiced_bt_gfps_provider_conf_t fastpair_conf = {0};
-    char appended_ble_dev_name[] = " LE";
-    uint8_t *p_index;
-    uint16_t dev_name_len;
 #endif // FASTPAIR_ENABLE
 
     WICED_BT_TRACE( "hci_control_le_enable\n" );
@@ -298,35 +350,7 @@ void hci_control_le_enable(void)
     // NVRAM id for Account Key list
     fastpair_conf.account_key_list_nvram_id = HEADSET_NVRAM_ID_GFPS_ACCOUNT_KEY;
 
-    // LE advertisement appended to fast pair advertisement data
-    dev_name_len = strlen((char *) wiced_bt_cfg_settings.device_name) +
-                   strlen(appended_ble_dev_name);
-
-    p_headset_control_le_dev_name = (char *) wiced_memory_allocate(dev_name_len);
-
-    if (p_headset_control_le_dev_name)
-    {
-        p_index = (uint8_t *) p_headset_control_le_dev_name;
-
-        memcpy((void *) p_index,
-               (void *) wiced_bt_cfg_settings.device_name,
-               strlen((char *) wiced_bt_cfg_settings.device_name));
-
-        p_index += strlen((char *) wiced_bt_cfg_settings.device_name);
-
-        memcpy((void *) p_index,
-               (void *) appended_ble_dev_name,
-               strlen(appended_ble_dev_name));
-    }
-    else
-    {
-        dev_name_len = 0;
-    }
-
-    headset_control_le_adv_elem.advert_type    = BTM_BLE_ADVERT_TYPE_NAME_COMPLETE;
-    headset_control_le_adv_elem.len            = dev_name_len;
-    headset_control_le_adv_elem.p_data         = (uint8_t *) p_headset_control_le_dev_name;
-
+    // LE advertisement appended to fast pair advertisement data, static and sized at build time
     fastpair_conf.appended_adv_data.p_elem      = &headset_control_le_adv_elem;
     fastpair_conf.appended_adv_data.elem_num    = 1;
 
@@ -335,16 +359,19 @@ void hci_control_le_enable(void)
     {
         WICED_BT_TRACE("wiced_bt_gfps_provider_init fail\n");
     }
+    else
+    {
+        /* The Fast Pair provider owns the advertising data, let the scheduler pick the duty cycle. */
+        headset_adv_sched_enable();
+    }
 #else
     /* GATT registration */
     gatt_status = wiced_bt_gatt_register(hci_control_le_gatt_callback);
     WICED_BT_TRACE("wiced_bt_gatt_register status %d\n", gatt_status);
 #endif
 
-#ifdef FASTPAIR_ENABLE
     /* Register the LE discoverability change callback. */
     bt_hs_spk_ble_discoverability_change_callback_register(&headset_control_le_discoverabilty_change_callback);
-#endif    
 }
 
 /*******************************************************************************
@@ -402,12 +429,20 @@ wiced_bt_gatt_status_t hci_control_le_gatt_callback(wiced_bt_gatt_evt_t event, w
 
     return result;
 }
-#ifdef FASTPAIR_ENABLE
+
 static void headset_control_le_discoverabilty_change_callback(wiced_bool_t discoverable)
 {
+#ifdef FASTPAIR_ENABLE
     wiced_bt_gfps_provider_discoverablility_set(discoverable);
-}
+
+    /* A Seeker connecting while discoverable runs the key-based pairing over GATT. */
+    headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_FASTPAIR, discoverable);
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_DISCOVERABLE, discoverable);
 #endif
+
+    headset_power_input_set(HEADSET_POWER_INPUT_DISCOVERABLE, discoverable);
+}
+
 /*
 * Process connection status callback
 */
@@ -465,6 +500,13 @@ static wiced_bt_gatt_status_t hci_control_le_gatt_req_cb(wiced_bt_gatt_attribute
             result = hci_control_le_write_handler(p_req->conn_id,
                                                   p_req->opcode,
                                                   &(p_req->data.write_req));
+
+            /* Write commands are not answered, neither on success nor on error. */
+            if (p_req->opcode != GATT_REQ_WRITE)
+            {
+                break;
+            }
+
             if (result == WICED_BT_GATT_SUCCESS)
             {
                 wiced_bt_gatt_server_send_write_rsp(p_req->conn_id,
@@ -507,6 +549,9 @@ static wiced_result_t hci_control_le_connection_up(wiced_bt_gatt_connection_stat
 {
     WICED_BT_TRACE("le_connection_up, id:%d bd (%B) role:%d\n:", p_status->conn_id, p_status->bd_addr);
 
+    headset_le_conn_param_link_up(p_status->bd_addr);
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_LE_CONNECTED, WICED_TRUE);
+
     return WICED_SUCCESS;
 }
 
@@ -517,6 +562,13 @@ static wiced_result_t hci_control_le_connection_down(wiced_bt_gatt_connection_st
 {
     WICED_BT_TRACE("le_connection_down id:%x Disc_Reason: %02x\n", p_status->conn_id, p_status->reason);
 
+    headset_le_conn_param_link_down();
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_LE_CONNECTED, WICED_FALSE);
+
+#ifdef OTA_FW_UPGRADE
+    hci_control_le_ota_stats_report();
+#endif
+
     return WICED_SUCCESS;
 }
 
@@ -532,7 +584,7 @@ static wiced_bt_gatt_status_t hci_control_le_read_handler(uint16_t conn_id, wice
     int         to_send;
 
 #ifdef OTA_FW_UPGRADE
-    if (wiced_ota_fw_upgrade_is_gatt_handle(p_req->handle))
+    if (wiced_ota_fw_upgrade_is_gatt_handle(p_read_req->handle))
     {
         return wiced_ota_fw_upgrade_read_handler(conn_id,
                                                  opcode,
@@ -796,8 +848,23 @@ static wiced_bt_gatt_status_t hci_control_le_write_handler(uint16_t conn_id, wic
         wiced_bt_gatt_write_req_t* p_data)
 {
 #ifdef OTA_FW_UPGRADE
-    if (wiced_ota_fw_upgrade_is_gatt_handle(p_req->handle))
+    if (wiced_ota_fw_upgrade_is_gatt_handle(p_data->handle))
     {
+        /* Bulk load: short interval, no latency and 2M PHY for the rest of the link. */
+        headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_OTA, WICED_TRUE);
+
+        if (p_data->handle == HANDLE_OTA_FW_UPGRADE_DATA)
+        {
+            headset_control_le_ota_stats.last_us = clock_SystemTimeMicroseconds64();
+
+            if (headset_control_le_ota_stats.packets++ == 0)
+            {
+                headset_control_le_ota_stats.start_us = headset_control_le_ota_stats.last_us;
+            }
+
+            headset_control_le_ota_stats.bytes += p_data->val_len;
+        }
+
         return wiced_ota_fw_upgrade_write_handler(conn_id, opcode, p_data);
     }
 #endif
@@ -810,6 +877,32 @@ static wiced_bt_gatt_status_t hci_control_le_write_handler(uint16_t conn_id, wic
     return WICED_BT_GATT_SUCCESS;
 }
 
+#ifdef OTA_FW_UPGRADE
+/*
+ * Trace the image transfer rate of the link with the MTU and PHY it ran on, and reset the
+ * statistics
+ */
+static void hci_control_le_ota_stats_report(void)
+{
+    uint32_t elapsed_ms;
+
+    if (headset_control_le_ota_stats.packets != 0)
+    {
+        elapsed_ms = (uint32_t) ((headset_control_le_ota_stats.last_us - headset_control_le_ota_stats.start_us) / 1000);
+
+        WICED_BT_TRACE("ota: %d bytes in %d packets, %d ms, %d kB/s, MTU %d, %dM PHY\n",
+                       headset_control_le_ota_stats.bytes,
+                       headset_control_le_ota_stats.packets,
+                       elapsed_ms,
+                       (elapsed_ms != 0) ? (headset_control_le_ota_stats.bytes / elapsed_ms) : 0,
+                       (headset_control_le_ota_stats.mtu != 0) ? headset_control_le_ota_stats.mtu : GATT_DEF_BLE_MTU_SIZE,
+                       headset_le_conn_param_tx_phy_get());
+    }
+
+    memset((void *) &headset_control_le_ota_stats, 0, sizeof(headset_control_le_ota_stats));
+}
+#endif
+
 /*
  * Process MTU request from the peer
  */
@@ -817,6 +910,10 @@ static wiced_bt_gatt_status_t hci_control_le_mtu_handler(uint16_t conn_id, uint1
 {
     WICED_BT_TRACE("req_mtu: %d\n", mtu);
 
+#ifdef OTA_FW_UPGRADE
+    headset_control_le_ota_stats.mtu = MIN(mtu, wiced_bt_cfg_settings.p_ble_cfg->ble_max_rx_pdu_size);
+#endif
+
     wiced_bt_gatt_server_send_mtu_rsp(conn_id,
                                       mtu,
                                       wiced_bt_cfg_settings.p_ble_cfg->ble_max_rx_pdu_size);
@@ -0,0 +1,299 @@
+/******************************************************************************
+* File Name:   headset_defer.c
+*
+* Description: Deferred work queue.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include "headset_defer.h"
+#include "wiced_bt_trace.h"
+#include "wiced_timer.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* Shortest timer, the work runs as soon as the stack returns to its event loop */
+#define HEADSET_DEFER_DELAY     1   /* ms */
+
+/* First position of the lap of pos */
+#define HEADSET_DEFER_LAP(pos)  ((pos) & ~(uint32_t) (HEADSET_DEFER_QUEUE_SIZE - 1))
+
+/*******************************************************************************
+* Structures
+********************************************************************************/
+typedef struct
+{
+    uint32_t                seq;        /* Slot state, see headset_defer_push */
+    headset_defer_func_t    p_func;
+    void                   *p_arg;
+} headset_defer_slot_t;
+
+/* Bounded multi-producer, single consumer ring */
+typedef struct
+{
+    headset_defer_slot_t    slot[HEADSET_DEFER_QUEUE_SIZE];
+    uint32_t                tail;       /* Next position to reserve, shared by the producers */
+    uint32_t                head;       /* Next position to run, consumer only */
+
+    uint32_t                run;
+    uint32_t                dropped;
+    uint32_t                max_depth;
+} headset_defer_queue_t;
+
+typedef struct
+{
+    headset_defer_queue_t   queue[HEADSET_DEFER_PRIORITY_NUM];
+    uint8_t                 initialized;
+    uint8_t                 scheduled;  /* Drain timer started and not run yet */
+    wiced_timer_t           timer;
+} headset_defer_cb_t;
+
+_Static_assert((HEADSET_DEFER_QUEUE_SIZE & (HEADSET_DEFER_QUEUE_SIZE - 1)) == 0,
+               "HEADSET_DEFER_QUEUE_SIZE must be a power of 2");
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static headset_defer_cb_t headset_defer_cb;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static wiced_bool_t headset_defer_push(headset_defer_queue_t *p_queue, headset_defer_func_t p_func, void *p_arg);
+static wiced_bool_t headset_defer_pop(headset_defer_queue_t *p_queue, headset_defer_slot_t *p_item);
+static void         headset_defer_schedule(void);
+static void         headset_defer_timeout(WICED_TIMER_PARAM_TYPE arg);
+
+/*******************************************************************************
+* Global Function Definitions
+*******************************************************************************/
+
+void headset_defer_init(void)
+{
+    headset_defer_cb_t *p_cb = &headset_defer_cb;
+
+    wiced_init_timer(&p_cb->timer, headset_defer_timeout, 0, WICED_MILLI_SECONDS_TIMER);
+
+    __atomic_store_n(&p_cb->initialized, 1, __ATOMIC_RELEASE);
+
+    headset_defer_schedule();
+}
+
+wiced_result_t headset_defer(headset_defer_priority_t priority, headset_defer_func_t p_func, void *p_arg)
+{
+    headset_defer_queue_t *p_queue;
+
+    if ((priority >= HEADSET_DEFER_PRIORITY_NUM) || (p_func == NULL))
+    {
+        return WICED_BT_BADARG;
+    }
+
+    p_queue = &headset_defer_cb.queue[priority];
+
+    if (!headset_defer_push(p_queue, p_func, p_arg))
+    {
+        __atomic_fetch_add(&p_queue->dropped, 1, __ATOMIC_RELAXED);
+        return WICED_BT_NO_RESOURCES;
+    }
+
+    headset_defer_schedule();
+
+    return WICED_BT_SUCCESS;
+}
+
+void headset_defer_stats_report(void)
+{
+    headset_defer_queue_t *p_queue;
+    uint8_t priority;
+
+    for (priority = 0; priority < HEADSET_DEFER_PRIORITY_NUM; priority++)
+    {
+        p_queue = &headset_defer_cb.queue[priority];
+
+        WICED_BT_TRACE("headset_defer: priority %d run %d max depth %d dropped %d\n",
+                       priority, p_queue->run, p_queue->max_depth, p_queue->dropped);
+    }
+}
+
+/*******************************************************************************
+* Static Function Definitions
+*******************************************************************************/
+
+/*
+ * seq counts from the start of the lap of a position (pos & ~mask), so the zeroed queue is
+ * valid before headset_defer_init. The slot of pos is free when seq is the lap start and holds
+ * the item of pos at lap start + 1. A producer reserves pos by moving tail on with a compare and
+ * swap, fills the slot and publishes it with seq; the consumer frees it for the next lap.
+ */
+static wiced_bool_t headset_defer_push(headset_defer_queue_t *p_queue, headset_defer_func_t p_func, void *p_arg)
+{
+    headset_defer_slot_t *p_slot;
+    uint32_t pos = __atomic_load_n(&p_queue->tail, __ATOMIC_RELAXED);
+    uint32_t depth;
+    uint32_t max_depth;
+    int32_t diff;
+
+    while (1)
+    {
+        p_slot  = &p_queue->slot[pos & (HEADSET_DEFER_QUEUE_SIZE - 1)];
+        diff    = (int32_t) (__atomic_load_n(&p_slot->seq, __ATOMIC_ACQUIRE) - HEADSET_DEFER_LAP(pos));
+
+        if (diff == 0)
+        {
+            if (__atomic_compare_exchange_n(&p_queue->tail, &pos, pos + 1, WICED_TRUE,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            /* The slot still holds the item of the previous lap: full. */
+            return WICED_FALSE;
+        }
+        else
+        {
+            pos = __atomic_load_n(&p_queue->tail, __ATOMIC_RELAXED);
+        }
+    }
+
+    p_slot->p_func  = p_func;
+    p_slot->p_arg   = p_arg;
+    __atomic_store_n(&p_slot->seq, HEADSET_DEFER_LAP(pos) + 1, __ATOMIC_RELEASE);
+
+    /* Producers race on the high-water mark as on tail: raise it with a compare and swap. */
+    depth       = pos + 1 - __atomic_load_n(&p_queue->head, __ATOMIC_RELAXED);
+    max_depth   = __atomic_load_n(&p_queue->max_depth, __ATOMIC_RELAXED);
+    while ((depth > max_depth) &&
+           !__atomic_compare_exchange_n(&p_queue->max_depth, &max_depth, depth, WICED_TRUE,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+
+    return WICED_TRUE;
+}
+
+static wiced_bool_t headset_defer_pop(headset_defer_queue_t *p_queue, headset_defer_slot_t *p_item)
+{
+    uint32_t pos = p_queue->head;
+    headset_defer_slot_t *p_slot = &p_queue->slot[pos & (HEADSET_DEFER_QUEUE_SIZE - 1)];
+
+    if (__atomic_load_n(&p_slot->seq, __ATOMIC_ACQUIRE) != HEADSET_DEFER_LAP(pos) + 1)
+    {
+        return WICED_FALSE;
+    }
+
+    p_item->p_func  = p_slot->p_func;
+    p_item->p_arg   = p_slot->p_arg;
+
+    __atomic_store_n(&p_slot->seq, HEADSET_DEFER_LAP(pos) + HEADSET_DEFER_QUEUE_SIZE, __ATOMIC_RELEASE);
+    __atomic_store_n(&p_queue->head, pos + 1, __ATOMIC_RELAXED);
+    p_queue->run++;
+
+    return WICED_TRUE;
+}
+
+/*
+ * Start the drain timer unless it is already started. Nothing runs before headset_defer_init,
+ * the init schedules what was queued until then.
+ */
+static void headset_defer_schedule(void)
+{
+    headset_defer_cb_t *p_cb = &headset_defer_cb;
+
+    if (!__atomic_load_n(&p_cb->initialized, __ATOMIC_ACQUIRE))
+    {
+        return;
+    }
+
+    if (__atomic_exchange_n(&p_cb->scheduled, 1, __ATOMIC_ACQ_REL) == 0)
+    {
+        wiced_start_timer(&p_cb->timer, HEADSET_DEFER_DELAY);
+    }
+}
+
+/*
+ * Run up to HEADSET_DEFER_BATCH items, looking at the highest priority again after each one so
+ * urgent work queued meanwhile is not stuck behind a backlog of low priority work.
+ */
+static void headset_defer_timeout(WICED_TIMER_PARAM_TYPE arg)
+{
+    headset_defer_cb_t *p_cb = &headset_defer_cb;
+    headset_defer_slot_t item;
+    wiced_bool_t pending = WICED_FALSE;
+    uint8_t n, priority;
+
+    (void) arg;
+
+    for (n = 0; n < HEADSET_DEFER_BATCH; n++)
+    {
+        for (priority = 0; priority < HEADSET_DEFER_PRIORITY_NUM; priority++)
+        {
+            if (headset_defer_pop(&p_cb->queue[priority], &item))
+            {
+                break;
+            }
+        }
+
+        if (priority == HEADSET_DEFER_PRIORITY_NUM)
+        {
+            break;
+        }
+
+        item.p_func(item.p_arg);
+    }
+
+    __atomic_store_n(&p_cb->scheduled, 0, __ATOMIC_RELEASE);
+
+    /* Work left over, or queued by a producer that saw the timer still scheduled. */
+    for (priority = 0; priority < HEADSET_DEFER_PRIORITY_NUM; priority++)
+    {
+        if (__atomic_load_n(&p_cb->queue[priority].tail, __ATOMIC_ACQUIRE) != p_cb->queue[priority].head)
+        {
+            pending = WICED_TRUE;
+        }
+    }
+
+    if (pending)
+    {
+        headset_defer_schedule();
+    }
+}
+
+/* [] END OF FILE */
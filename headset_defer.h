@@ -0,0 +1,134 @@
+/******************************************************************************
+* File Name:   headset_defer.h
+*
+* Description: Deferred work queue.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#if !defined(HEADSET_DEFER_H)
+#define HEADSET_DEFER_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+#include "wiced.h"
+#include "wiced_result.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/* Work items queued per priority, power of 2 */
+#define HEADSET_DEFER_QUEUE_SIZE        8
+
+/* Work items run in one pass before the stack gets the thread back */
+#define HEADSET_DEFER_BATCH             4
+
+/*******************************************************************************
+*        Data Types
+*******************************************************************************/
+typedef enum
+{
+    HEADSET_DEFER_PRIORITY_HIGH,        /* Start up, user feedback */
+    HEADSET_DEFER_PRIORITY_NORMAL,
+    HEADSET_DEFER_PRIORITY_LOW,         /* NVRAM writes */
+    HEADSET_DEFER_PRIORITY_NUM,
+} headset_defer_priority_t;
+
+typedef void (*headset_defer_func_t)(void *p_arg);
+
+/*******************************************************************************
+*        External Variable Declarations
+*******************************************************************************/
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: headset_defer_init
+********************************************************************************
+* Summary:
+*   Start running deferred work. Work queued before is run from now on.
+*   Call once the BT stack is enabled.
+*
+* Parameters:
+*   void
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_defer_init(void);
+
+/*******************************************************************************
+* Function Name: headset_defer
+********************************************************************************
+* Summary:
+*   Queue a function to run on the application thread after the current callback
+*   has returned. Higher priorities run first, work of the same priority runs in
+*   queue order, so a subsystem keeps its order by always using the same priority.
+*   May be called from any thread.
+*
+* Parameters:
+*   priority    : priority
+*   p_func      : function to run
+*   p_arg       : argument of p_func, must stay valid until it runs
+*
+* Return:
+*   WICED_BT_SUCCESS
+*   WICED_BT_NO_RESOURCES if the queue of the priority is full
+*
+*******************************************************************************/
+wiced_result_t headset_defer(headset_defer_priority_t priority, headset_defer_func_t p_func, void *p_arg);
+
+/*******************************************************************************
+* Function Name: headset_defer_stats_report
+********************************************************************************
+* Summary:
+*   Trace the number of items run, the deepest queue and the items dropped, per priority.
+*
+* Parameters:
+*   void
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_defer_stats_report(void);
+
+#endif /* HEADSET_DEFER_H */
+/* [] END OF FILE */
@@ -0,0 +1,154 @@
+/******************************************************************************
+* File Name:   headset_eir.c
+*
+* Description: BR/EDR extended inquiry response.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+
+#include "headset_eir.h"
+#include "wiced_app_cfg.h"
+#include "wiced_bt_dev.h"
+#include "wiced_bt_trace.h"
+#include "wiced_memory.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/* Longest name fitting next to the UUID list */
+#define HEADSET_EIR_NAME_MAX    (WICED_APP_CFG_EIR_MAX - 2 - 2 - sizeof(btheadset_eir.uuid))
+
+/*******************************************************************************
+* Structures
+********************************************************************************/
+typedef struct
+{
+    uint8_t     *p_eir;     /* EIR built for a runtime name, NULL until needed */
+    uint16_t    len;
+} headset_eir_cb_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static headset_eir_cb_t headset_eir_cb = {0};
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static wiced_bool_t     headset_eir_name_match(const uint8_t *p_eir, const char *p_name, size_t name_len);
+static uint16_t         headset_eir_build(uint8_t *p_eir, const char *p_name, size_t name_len);
+
+/*******************************************************************************
+* Global Function Definitions
+*******************************************************************************/
+
+wiced_result_t headset_eir_write(const char *p_name)
+{
+    headset_eir_cb_t *p_cb = &headset_eir_cb;
+    size_t name_len = strlen(p_name);
+
+    if (headset_eir_name_match((const uint8_t *) &btheadset_eir, p_name, name_len))
+    {
+        return wiced_bt_dev_write_eir((uint8_t *) &btheadset_eir, sizeof(btheadset_eir));
+    }
+
+    if ((p_cb->p_eir == NULL) ||
+        !headset_eir_name_match(p_cb->p_eir, p_name, name_len))
+    {
+        if (p_cb->p_eir == NULL)
+        {
+            p_cb->p_eir = (uint8_t *) wiced_bt_get_buffer(WICED_APP_CFG_EIR_MAX);
+            if (p_cb->p_eir == NULL)
+            {
+                return WICED_BT_NO_RESOURCES;
+            }
+        }
+
+        p_cb->len = headset_eir_build(p_cb->p_eir, p_name, name_len);
+
+        WICED_BT_TRACE("headset_eir: built for %s, %d bytes\n", p_name, p_cb->len);
+    }
+
+    return wiced_bt_dev_write_eir(p_cb->p_eir, p_cb->len);
+}
+
+/*******************************************************************************
+* Static Function Definitions
+*******************************************************************************/
+
+/*
+ * A shortened name never matches, so a name too long for the EIR is rebuilt each time.
+ */
+static wiced_bool_t headset_eir_name_match(const uint8_t *p_eir, const char *p_name, size_t name_len)
+{
+    return (p_eir[0] == name_len + 1) &&
+           (p_eir[1] == BTM_EIR_COMPLETE_LOCAL_NAME_TYPE) &&
+           (memcmp(&p_eir[2], p_name, name_len) == 0);
+}
+
+/*
+ * Name element, then the UUID element taken from btheadset_eir.
+ */
+static uint16_t headset_eir_build(uint8_t *p_eir, const char *p_name, size_t name_len)
+{
+    uint8_t *p = p_eir;
+
+    if (name_len > HEADSET_EIR_NAME_MAX)
+    {
+        *p++ = HEADSET_EIR_NAME_MAX + 1;
+        *p++ = BTM_EIR_SHORTENED_LOCAL_NAME_TYPE;
+        name_len = HEADSET_EIR_NAME_MAX;
+    }
+    else
+    {
+        *p++ = name_len + 1;
+        *p++ = BTM_EIR_COMPLETE_LOCAL_NAME_TYPE;
+    }
+
+    memcpy(p, p_name, name_len);
+    p += name_len;
+
+    memcpy(p, &btheadset_eir.uuid_len, 2 + sizeof(btheadset_eir.uuid));
+    p += 2 + sizeof(btheadset_eir.uuid);
+
+    return (uint16_t) (p - p_eir);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,85 @@
+/******************************************************************************
+* File Name:   headset_eir.h
+*
+* Description: BR/EDR extended inquiry response.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#if !defined(HEADSET_EIR_H)
+#define HEADSET_EIR_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced.h"
+#include "wiced_result.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+
+/*******************************************************************************
+*        Data Types
+*******************************************************************************/
+
+/*******************************************************************************
+*        External Variable Declarations
+*******************************************************************************/
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: headset_eir_write
+********************************************************************************
+* Summary:
+*   Write the EIR to the controller. For the build time device name the EIR built at
+*   compile time (btheadset_eir) is written as is. For another name the EIR is built
+*   once and kept until the name changes again.
+*
+* Parameters:
+*   p_name      : local device name, NUL terminated
+*
+* Return:
+*   WICED_BT_SUCCESS
+*   WICED_BT_NO_RESOURCES if no buffer is left to build the EIR
+*   Result of wiced_bt_dev_write_eir otherwise
+*
+*******************************************************************************/
+wiced_result_t headset_eir_write(const char *p_name);
+
+#endif /* HEADSET_EIR_H */
+/* [] END OF FILE */
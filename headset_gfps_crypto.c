@@ -0,0 +1,783 @@
+/******************************************************************************
+* File Name:   headset_gfps_crypto.c
+*
+* Description: Instrumented P-256 ECDH and AES-128 for Fast Pair key-based pairing.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+
+#include "clock_timer.h"
+#include "headset_gfps_crypto.h"
+#include "wiced_bt_trace.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define HEADSET_GFPS_CRYPTO_WORDS       8   /* 256-bit field element in 32-bit words, little endian */
+#define HEADSET_GFPS_CRYPTO_WINDOW      4   /* Scalar multiplication window in bits */
+#define HEADSET_GFPS_CRYPTO_TABLE_SIZE  (1 << HEADSET_GFPS_CRYPTO_WINDOW)
+
+/*******************************************************************************
+* Structures
+********************************************************************************/
+typedef uint32_t headset_gfps_crypto_fe_t[HEADSET_GFPS_CRYPTO_WORDS];
+
+/* Projective point (X : Y : Z), coordinates in the Montgomery domain. Infinity is (0 : 1 : 0). */
+typedef struct
+{
+    headset_gfps_crypto_fe_t    x;
+    headset_gfps_crypto_fe_t    y;
+    headset_gfps_crypto_fe_t    z;
+} headset_gfps_crypto_point_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Field prime p = 2^256 - 2^224 + 2^192 + 2^96 - 1 */
+static const headset_gfps_crypto_fe_t headset_gfps_crypto_p =
+{
+    0xffffffff, 0xffffffff, 0xffffffff, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xffffffff
+};
+
+/* Group order n */
+static const headset_gfps_crypto_fe_t headset_gfps_crypto_n =
+{
+    0xfc632551, 0xf3b9cac2, 0xa7179e84, 0xbce6faad, 0xffffffff, 0xffffffff, 0x00000000, 0xffffffff
+};
+
+/* 1, 2^512 and b in the Montgomery domain (R = 2^256) */
+/* Plain 1, multiplying by it leaves the Montgomery domain */
+static const headset_gfps_crypto_fe_t headset_gfps_crypto_fe_1 = {1};
+
+static const headset_gfps_crypto_fe_t headset_gfps_crypto_one =
+{
+    0x00000001, 0x00000000, 0x00000000, 0xffffffff, 0xffffffff, 0xffffffff, 0xfffffffe, 0x00000000
+};
+
+static const headset_gfps_crypto_fe_t headset_gfps_crypto_rr =
+{
+    0x00000003, 0x00000000, 0xffffffff, 0xfffffffb, 0xfffffffe, 0xffffffff, 0xfffffffd, 0x00000004
+};
+
+static const headset_gfps_crypto_fe_t headset_gfps_crypto_b =
+{
+    0x29c4bddf, 0xd89cdf62, 0x78843090, 0xacf005cd, 0xf7212ed6, 0xe5a220ab, 0x04874834, 0xdc30061d
+};
+
+static const uint8_t headset_gfps_crypto_sbox[256] =
+{
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+
+static const uint8_t headset_gfps_crypto_inv_sbox[256] =
+{
+    0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
+    0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
+    0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
+    0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
+    0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
+    0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
+    0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
+    0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
+    0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
+    0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
+    0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
+    0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
+    0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
+    0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
+    0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
+    0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d,
+};
+
+static const uint8_t headset_gfps_crypto_rcon[10] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36};
+
+static headset_gfps_crypto_stats_t headset_gfps_crypto_stats[HEADSET_GFPS_CRYPTO_OP_NUM] = {0};
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void     headset_gfps_crypto_fe_add(uint32_t *p_r, const uint32_t *p_a, const uint32_t *p_b);
+static void     headset_gfps_crypto_fe_sub(uint32_t *p_r, const uint32_t *p_a, const uint32_t *p_b);
+static void     headset_gfps_crypto_fe_mul(uint32_t *p_r, const uint32_t *p_a, const uint32_t *p_b);
+static void     headset_gfps_crypto_fe_inv(uint32_t *p_r, const uint32_t *p_a);
+static uint32_t headset_gfps_crypto_fe_lt(const uint32_t *p_a, const uint32_t *p_b);
+static void     headset_gfps_crypto_fe_from_bytes(uint32_t *p_r, const uint8_t *p_in);
+static void     headset_gfps_crypto_fe_to_bytes(uint8_t *p_out, const uint32_t *p_a);
+static void     headset_gfps_crypto_point_add(headset_gfps_crypto_point_t *p_r, const headset_gfps_crypto_point_t *p_a,
+                                              const headset_gfps_crypto_point_t *p_b);
+static void     headset_gfps_crypto_point_double(headset_gfps_crypto_point_t *p_r, const headset_gfps_crypto_point_t *p_a);
+static void     headset_gfps_crypto_point_select(headset_gfps_crypto_point_t *p_r, const headset_gfps_crypto_point_t *p_table,
+                                                 uint32_t index);
+static void     headset_gfps_crypto_aes_mix_column(uint8_t *p_col);
+static void     headset_gfps_crypto_stats_update(headset_gfps_crypto_op_t op, uint64_t start_us);
+static uint8_t  headset_gfps_crypto_xtime(uint8_t a);
+
+/*******************************************************************************
+* Global Function Definitions
+*******************************************************************************/
+
+/*
+ * Fixed 4-bit window scalar multiplication with complete projective formulas, so every
+ * iteration runs the same operations whatever the key bits and the peer point are.
+ */
+wiced_result_t headset_gfps_crypto_ecdh(const uint8_t *p_private, const uint8_t *p_peer, uint8_t *p_shared)
+{
+    headset_gfps_crypto_point_t table[HEADSET_GFPS_CRYPTO_TABLE_SIZE];
+    headset_gfps_crypto_point_t r;
+    headset_gfps_crypto_point_t t;
+    headset_gfps_crypto_fe_t k;
+    headset_gfps_crypto_fe_t lhs;
+    headset_gfps_crypto_fe_t rhs;
+    headset_gfps_crypto_fe_t zero = {0};
+    uint64_t start_us = clock_SystemTimeMicroseconds64();
+    uint32_t nibble;
+    int i, j;
+
+    /* Private key in [1, n - 1] */
+    headset_gfps_crypto_fe_from_bytes(k, p_private);
+
+    if (!headset_gfps_crypto_fe_lt(zero, k) || !headset_gfps_crypto_fe_lt(k, headset_gfps_crypto_n))
+    {
+        return WICED_BADARG;
+    }
+
+    /* Peer point: coordinates below p and on the curve y^2 = x^3 - 3x + b */
+    headset_gfps_crypto_fe_from_bytes(table[1].x, p_peer);
+    headset_gfps_crypto_fe_from_bytes(table[1].y, p_peer + HEADSET_GFPS_CRYPTO_P256_SHARED_LEN);
+
+    if (!headset_gfps_crypto_fe_lt(table[1].x, headset_gfps_crypto_p) ||
+        !headset_gfps_crypto_fe_lt(table[1].y, headset_gfps_crypto_p))
+    {
+        return WICED_BADARG;
+    }
+
+    headset_gfps_crypto_fe_mul(table[1].x, table[1].x, headset_gfps_crypto_rr);
+    headset_gfps_crypto_fe_mul(table[1].y, table[1].y, headset_gfps_crypto_rr);
+    memcpy((void *) table[1].z, (const void *) headset_gfps_crypto_one, sizeof(headset_gfps_crypto_fe_t));
+
+    headset_gfps_crypto_fe_mul(lhs, table[1].y, table[1].y);
+    headset_gfps_crypto_fe_mul(rhs, table[1].x, table[1].x);
+    headset_gfps_crypto_fe_mul(rhs, rhs, table[1].x);
+    headset_gfps_crypto_fe_sub(rhs, rhs, table[1].x);
+    headset_gfps_crypto_fe_sub(rhs, rhs, table[1].x);
+    headset_gfps_crypto_fe_sub(rhs, rhs, table[1].x);
+    headset_gfps_crypto_fe_add(rhs, rhs, headset_gfps_crypto_b);
+
+    if (memcmp((const void *) lhs, (const void *) rhs, sizeof(headset_gfps_crypto_fe_t)) != 0)
+    {
+        return WICED_BADARG;
+    }
+
+    /* table[i] = i * P */
+    memset((void *) &table[0], 0, sizeof(table[0]));
+    memcpy((void *) table[0].y, (const void *) headset_gfps_crypto_one, sizeof(headset_gfps_crypto_fe_t));
+
+    for (i = 2; i < HEADSET_GFPS_CRYPTO_TABLE_SIZE; i++)
+    {
+        if (i & 1)
+        {
+            headset_gfps_crypto_point_add(&table[i], &table[i - 1], &table[1]);
+        }
+        else
+        {
+            headset_gfps_crypto_point_double(&table[i], &table[i / 2]);
+        }
+    }
+
+    /* Most significant window first */
+    memcpy((void *) &r, (const void *) &table[0], sizeof(r));
+
+    for (i = (HEADSET_GFPS_CRYPTO_WORDS * 32 / HEADSET_GFPS_CRYPTO_WINDOW) - 1; i >= 0; i--)
+    {
+        for (j = 0; j < HEADSET_GFPS_CRYPTO_WINDOW; j++)
+        {
+            headset_gfps_crypto_point_double(&r, &r);
+        }
+
+        nibble = (k[i / 8] >> ((i % 8) * HEADSET_GFPS_CRYPTO_WINDOW)) & (HEADSET_GFPS_CRYPTO_TABLE_SIZE - 1);
+
+        headset_gfps_crypto_point_select(&t, table, nibble);
+        headset_gfps_crypto_point_add(&r, &r, &t);
+    }
+
+    /* Affine x = X / Z. k < n so the result is never the point at infinity. */
+    headset_gfps_crypto_fe_inv(r.z, r.z);
+    headset_gfps_crypto_fe_mul(r.x, r.x, r.z);
+    headset_gfps_crypto_fe_mul(r.x, r.x, headset_gfps_crypto_fe_1);
+
+    headset_gfps_crypto_fe_to_bytes(p_shared, r.x);
+
+    memset((void *) k, 0, sizeof(k));
+    memset((void *) table, 0, sizeof(table));
+
+    headset_gfps_crypto_stats_update(HEADSET_GFPS_CRYPTO_OP_ECDH, start_us);
+
+    return WICED_SUCCESS;
+}
+
+void headset_gfps_crypto_aes_key_set(headset_gfps_crypto_aes_t *p_aes, const uint8_t *p_key)
+{
+    uint64_t start_us = clock_SystemTimeMicroseconds64();
+    uint8_t *p_prev;
+    uint8_t *p_rk;
+    uint8_t i, j;
+
+    memcpy((void *) p_aes->round_key[0], (const void *) p_key, HEADSET_GFPS_CRYPTO_AES_KEY_LEN);
+
+    for (i = 1; i < 11; i++)
+    {
+        p_prev  = p_aes->round_key[i - 1];
+        p_rk    = p_aes->round_key[i];
+
+        /* RotWord, SubWord, Rcon */
+        p_rk[0] = p_prev[0] ^ headset_gfps_crypto_sbox[p_prev[13]] ^ headset_gfps_crypto_rcon[i - 1];
+        p_rk[1] = p_prev[1] ^ headset_gfps_crypto_sbox[p_prev[14]];
+        p_rk[2] = p_prev[2] ^ headset_gfps_crypto_sbox[p_prev[15]];
+        p_rk[3] = p_prev[3] ^ headset_gfps_crypto_sbox[p_prev[12]];
+
+        for (j = 4; j < HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN; j++)
+        {
+            p_rk[j] = p_prev[j] ^ p_rk[j - 4];
+        }
+    }
+
+    headset_gfps_crypto_stats_update(HEADSET_GFPS_CRYPTO_OP_AES_KEY, start_us);
+}
+
+void headset_gfps_crypto_aes_encrypt(const headset_gfps_crypto_aes_t *p_aes, const uint8_t *p_in, uint8_t *p_out)
+{
+    uint64_t start_us = clock_SystemTimeMicroseconds64();
+    uint8_t s[HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN];
+    uint8_t round, i;
+    uint8_t t;
+
+    for (i = 0; i < HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN; i++)
+    {
+        s[i] = p_in[i] ^ p_aes->round_key[0][i];
+    }
+
+    for (round = 1; round < 11; round++)
+    {
+        /* SubBytes */
+        for (i = 0; i < HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN; i++)
+        {
+            s[i] = headset_gfps_crypto_sbox[s[i]];
+        }
+
+        /* ShiftRows, the state is column major */
+        t = s[1];  s[1]  = s[5];  s[5]  = s[9];  s[9]  = s[13]; s[13] = t;
+        t = s[2];  s[2]  = s[10]; s[10] = t;
+        t = s[6];  s[6]  = s[14]; s[14] = t;
+        t = s[15]; s[15] = s[11]; s[11] = s[7];  s[7]  = s[3];  s[3]  = t;
+
+        if (round != 10)
+        {
+            for (i = 0; i < HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN; i += 4)
+            {
+                headset_gfps_crypto_aes_mix_column(&s[i]);
+            }
+        }
+
+        for (i = 0; i < HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN; i++)
+        {
+            s[i] ^= p_aes->round_key[round][i];
+        }
+    }
+
+    memcpy((void *) p_out, (const void *) s, HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN);
+
+    headset_gfps_crypto_stats_update(HEADSET_GFPS_CRYPTO_OP_AES_BLOCK, start_us);
+}
+
+void headset_gfps_crypto_aes_decrypt(const headset_gfps_crypto_aes_t *p_aes, const uint8_t *p_in, uint8_t *p_out)
+{
+    uint64_t start_us = clock_SystemTimeMicroseconds64();
+    uint8_t s[HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN];
+    int8_t round;
+    uint8_t i;
+    uint8_t t, u, v;
+
+    for (i = 0; i < HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN; i++)
+    {
+        s[i] = p_in[i] ^ p_aes->round_key[10][i];
+    }
+
+    for (round = 9; round >= 0; round--)
+    {
+        /* InvShiftRows */
+        t = s[13]; s[13] = s[9];  s[9]  = s[5];  s[5]  = s[1];  s[1]  = t;
+        t = s[2];  s[2]  = s[10]; s[10] = t;
+        t = s[6];  s[6]  = s[14]; s[14] = t;
+        t = s[3];  s[3]  = s[7];  s[7]  = s[11]; s[11] = s[15]; s[15] = t;
+
+        /* InvSubBytes and AddRoundKey */
+        for (i = 0; i < HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN; i++)
+        {
+            s[i] = headset_gfps_crypto_inv_sbox[s[i]] ^ p_aes->round_key[round][i];
+        }
+
+        if (round != 0)
+        {
+            /* InvMixColumns = MixColumns after multiplying the column by (4x^2 + 5) */
+            for (i = 0; i < HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN; i += 4)
+            {
+                u = headset_gfps_crypto_xtime(headset_gfps_crypto_xtime(s[i] ^ s[i + 2]));
+                v = headset_gfps_crypto_xtime(headset_gfps_crypto_xtime(s[i + 1] ^ s[i + 3]));
+
+                s[i]        ^= u;
+                s[i + 1]    ^= v;
+                s[i + 2]    ^= u;
+                s[i + 3]    ^= v;
+
+                headset_gfps_crypto_aes_mix_column(&s[i]);
+            }
+        }
+    }
+
+    memcpy((void *) p_out, (const void *) s, HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN);
+
+    headset_gfps_crypto_stats_update(HEADSET_GFPS_CRYPTO_OP_AES_BLOCK, start_us);
+}
+
+void headset_gfps_crypto_stats_get(headset_gfps_crypto_op_t op, headset_gfps_crypto_stats_t *p_stats)
+{
+    if (op >= HEADSET_GFPS_CRYPTO_OP_NUM)
+    {
+        memset((void *) p_stats, 0, sizeof(*p_stats));
+        return;
+    }
+
+    *p_stats = headset_gfps_crypto_stats[op];
+}
+
+void headset_gfps_crypto_stats_report(void)
+{
+    static const char *op_name[HEADSET_GFPS_CRYPTO_OP_NUM] = {"ecdh", "aes key", "aes block"};
+    headset_gfps_crypto_stats_t *p_stats;
+    uint8_t op;
+
+    for (op = 0; op < HEADSET_GFPS_CRYPTO_OP_NUM; op++)
+    {
+        p_stats = &headset_gfps_crypto_stats[op];
+
+        if (p_stats->count == 0)
+        {
+            continue;
+        }
+
+        WICED_BT_TRACE("headset_gfps_crypto: %s count %d avg %d us max %d us\n",
+                       op_name[op],
+                       p_stats->count,
+                       p_stats->total_us / p_stats->count,
+                       p_stats->max_us);
+    }
+}
+
+/*******************************************************************************
+* Static Function Definitions
+*******************************************************************************/
+
+/*
+ * Field arithmetic mod p. Inputs and outputs are fully reduced, no branch depends on the values.
+ */
+static void headset_gfps_crypto_fe_add(uint32_t *p_r, const uint32_t *p_a, const uint32_t *p_b)
+{
+    headset_gfps_crypto_fe_t d;
+    uint64_t c = 0;
+    int64_t borrow = 0;
+    uint32_t carry;
+    uint32_t mask;
+    uint8_t i;
+
+    for (i = 0; i < HEADSET_GFPS_CRYPTO_WORDS; i++)
+    {
+        c       += (uint64_t) p_a[i] + p_b[i];
+        p_r[i]  = (uint32_t) c;
+        c       >>= 32;
+    }
+    carry = (uint32_t) c;
+
+    for (i = 0; i < HEADSET_GFPS_CRYPTO_WORDS; i++)
+    {
+        borrow  += (int64_t) p_r[i] - headset_gfps_crypto_p[i];
+        d[i]    = (uint32_t) borrow;
+        borrow  >>= 32;
+    }
+
+    /* Keep a + b - p unless it went negative without a carry out of a + b */
+    mask = 0 - (carry | (uint32_t) (borrow + 1));
+
+    for (i = 0; i < HEADSET_GFPS_CRYPTO_WORDS; i++)
+    {
+        p_r[i] = (d[i] & mask) | (p_r[i] & ~mask);
+    }
+}
+
+static void headset_gfps_crypto_fe_sub(uint32_t *p_r, const uint32_t *p_a, const uint32_t *p_b)
+{
+    int64_t borrow = 0;
+    uint64_t c = 0;
+    uint32_t mask;
+    uint8_t i;
+
+    for (i = 0; i < HEADSET_GFPS_CRYPTO_WORDS; i++)
+    {
+        borrow  += (int64_t) p_a[i] - p_b[i];
+        p_r[i]  = (uint32_t) borrow;
+        borrow  >>= 32;
+    }
+
+    /* Add p back when a < b */
+    mask = (uint32_t) borrow;
+
+    for (i = 0; i < HEADSET_GFPS_CRYPTO_WORDS; i++)
+    {
+        c       += (uint64_t) p_r[i] + (headset_gfps_crypto_p[i] & mask);
+        p_r[i]  = (uint32_t) c;
+        c       >>= 32;
+    }
+}
+
+/*
+ * Montgomery product a * b / 2^256 mod p (CIOS). -p^-1 mod 2^32 is 1 for this prime,
+ * so the reduction factor of each step is the low word itself.
+ */
+static void headset_gfps_crypto_fe_mul(uint32_t *p_r, const uint32_t *p_a, const uint32_t *p_b)
+{
+    uint32_t t[HEADSET_GFPS_CRYPTO_WORDS + 2] = {0};
+    headset_gfps_crypto_fe_t d;
+    int64_t borrow = 0;
+    uint64_t c;
+    uint32_t m;
+    uint32_t mask;
+    uint8_t i, j;
+
+    for (i = 0; i < HEADSET_GFPS_CRYPTO_WORDS; i++)
+    {
+        c = 0;
+        for (j = 0; j < HEADSET_GFPS_CRYPTO_WORDS; j++)
+        {
+            c       += (uint64_t) t[j] + (uint64_t) p_a[j] * p_b[i];
+            t[j]    = (uint32_t) c;
+            c       >>= 32;
+        }
+        c                               += t[HEADSET_GFPS_CRYPTO_WORDS];
+        t[HEADSET_GFPS_CRYPTO_WORDS]    = (uint32_t) c;
+        t[HEADSET_GFPS_CRYPTO_WORDS + 1]= (uint32_t) (c >> 32);
+
+        m = t[0];
+        c = ((uint64_t) t[0] + (uint64_t) m * headset_gfps_crypto_p[0]) >> 32;
+        for (j = 1; j < HEADSET_GFPS_CRYPTO_WORDS; j++)
+        {
+            c           += (uint64_t) t[j] + (uint64_t) m * headset_gfps_crypto_p[j];
+            t[j - 1]    = (uint32_t) c;
+            c           >>= 32;
+        }
+        c                                   += t[HEADSET_GFPS_CRYPTO_WORDS];
+        t[HEADSET_GFPS_CRYPTO_WORDS - 1]    = (uint32_t) c;
+        t[HEADSET_GFPS_CRYPTO_WORDS]        = t[HEADSET_GFPS_CRYPTO_WORDS + 1] + (uint32_t) (c >> 32);
+    }
+
+    /* t < 2p, subtract p once if t >= p */
+    for (i = 0; i < HEADSET_GFPS_CRYPTO_WORDS; i++)
+    {
+        borrow  += (int64_t) t[i] - headset_gfps_crypto_p[i];
+        d[i]    = (uint32_t) borrow;
+        borrow  >>= 32;
+    }
+
+    mask = 0 - (t[HEADSET_GFPS_CRYPTO_WORDS] | (uint32_t) (borrow + 1));
+
+    for (i = 0; i < HEADSET_GFPS_CRYPTO_WORDS; i++)
+    {
+        p_r[i] = (d[i] & mask) | (t[i] & ~mask);
+    }
+}
+
+/*
+ * a^(p - 2). The exponent is public so the square and multiply sequence is fixed.
+ */
+static void headset_gfps_crypto_fe_inv(uint32_t *p_r, const uint32_t *p_a)
+{
+    headset_gfps_crypto_fe_t r;
+    uint32_t e;
+    int i;
+
+    memcpy((void *) r, (const void *) headset_gfps_crypto_one, sizeof(r));
+
+    for (i = 255; i >= 0; i--)
+    {
+        headset_gfps_crypto_fe_mul(r, r, r);
+
+        e = headset_gfps_crypto_p[i / 32];
+        if (i < 32)
+        {
+            e -= 2;
+        }
+
+        if ((e >> (i % 32)) & 1)
+        {
+            headset_gfps_crypto_fe_mul(r, r, p_a);
+        }
+    }
+
+    memcpy((void *) p_r, (const void *) r, sizeof(r));
+}
+
+/* 1 if a < b */
+static uint32_t headset_gfps_crypto_fe_lt(const uint32_t *p_a, const uint32_t *p_b)
+{
+    int64_t borrow = 0;
+    uint8_t i;
+
+    for (i = 0; i < HEADSET_GFPS_CRYPTO_WORDS; i++)
+    {
+        borrow  += (int64_t) p_a[i] - p_b[i];
+        borrow  >>= 32;
+    }
+
+    return (uint32_t) (borrow & 1);
+}
+
+static void headset_gfps_crypto_fe_from_bytes(uint32_t *p_r, const uint8_t *p_in)
+{
+    uint8_t i;
+
+    for (i = 0; i < HEADSET_GFPS_CRYPTO_WORDS; i++)
+    {
+        p_r[HEADSET_GFPS_CRYPTO_WORDS - 1 - i] = ((uint32_t) p_in[4 * i] << 24) |
+                                                 ((uint32_t) p_in[4 * i + 1] << 16) |
+                                                 ((uint32_t) p_in[4 * i + 2] << 8) |
+                                                 ((uint32_t) p_in[4 * i + 3]);
+    }
+}
+
+static void headset_gfps_crypto_fe_to_bytes(uint8_t *p_out, const uint32_t *p_a)
+{
+    uint32_t w;
+    uint8_t i;
+
+    for (i = 0; i < HEADSET_GFPS_CRYPTO_WORDS; i++)
+    {
+        w = p_a[HEADSET_GFPS_CRYPTO_WORDS - 1 - i];
+
+        p_out[4 * i]        = (uint8_t) (w >> 24);
+        p_out[4 * i + 1]    = (uint8_t) (w >> 16);
+        p_out[4 * i + 2]    = (uint8_t) (w >> 8);
+        p_out[4 * i + 3]    = (uint8_t) w;
+    }
+}
+
+/*
+ * Complete addition for a = -3 (Renes, Costello, Batina 2016, algorithm 4).
+ * Valid for every input pair including doubling and infinity. p_r may alias an input.
+ */
+static void headset_gfps_crypto_point_add(headset_gfps_crypto_point_t *p_r, const headset_gfps_crypto_point_t *p_a,
+                                          const headset_gfps_crypto_point_t *p_b)
+{
+    headset_gfps_crypto_fe_t t0, t1, t2, t3, t4, x3, y3, z3;
+
+    headset_gfps_crypto_fe_mul(t0, p_a->x, p_b->x);
+    headset_gfps_crypto_fe_mul(t1, p_a->y, p_b->y);
+    headset_gfps_crypto_fe_mul(t2, p_a->z, p_b->z);
+    headset_gfps_crypto_fe_add(t3, p_a->x, p_a->y);
+    headset_gfps_crypto_fe_add(t4, p_b->x, p_b->y);
+    headset_gfps_crypto_fe_mul(t3, t3, t4);
+    headset_gfps_crypto_fe_add(t4, t0, t1);
+    headset_gfps_crypto_fe_sub(t3, t3, t4);
+    headset_gfps_crypto_fe_add(t4, p_a->y, p_a->z);
+    headset_gfps_crypto_fe_add(x3, p_b->y, p_b->z);
+    headset_gfps_crypto_fe_mul(t4, t4, x3);
+    headset_gfps_crypto_fe_add(x3, t1, t2);
+    headset_gfps_crypto_fe_sub(t4, t4, x3);
+    headset_gfps_crypto_fe_add(x3, p_a->x, p_a->z);
+    headset_gfps_crypto_fe_add(y3, p_b->x, p_b->z);
+    headset_gfps_crypto_fe_mul(x3, x3, y3);
+    headset_gfps_crypto_fe_add(y3, t0, t2);
+    headset_gfps_crypto_fe_sub(y3, x3, y3);
+    headset_gfps_crypto_fe_mul(z3, headset_gfps_crypto_b, t2);
+    headset_gfps_crypto_fe_sub(x3, y3, z3);
+    headset_gfps_crypto_fe_add(z3, x3, x3);
+    headset_gfps_crypto_fe_add(x3, x3, z3);
+    headset_gfps_crypto_fe_sub(z3, t1, x3);
+    headset_gfps_crypto_fe_add(x3, t1, x3);
+    headset_gfps_crypto_fe_mul(y3, headset_gfps_crypto_b, y3);
+    headset_gfps_crypto_fe_add(t1, t2, t2);
+    headset_gfps_crypto_fe_add(t2, t1, t2);
+    headset_gfps_crypto_fe_sub(y3, y3, t2);
+    headset_gfps_crypto_fe_sub(y3, y3, t0);
+    headset_gfps_crypto_fe_add(t1, y3, y3);
+    headset_gfps_crypto_fe_add(y3, t1, y3);
+    headset_gfps_crypto_fe_add(t1, t0, t0);
+    headset_gfps_crypto_fe_add(t0, t1, t0);
+    headset_gfps_crypto_fe_sub(t0, t0, t2);
+    headset_gfps_crypto_fe_mul(t1, t4, y3);
+    headset_gfps_crypto_fe_mul(t2, t0, y3);
+    headset_gfps_crypto_fe_mul(y3, x3, z3);
+    headset_gfps_crypto_fe_add(y3, y3, t2);
+    headset_gfps_crypto_fe_mul(x3, t3, x3);
+    headset_gfps_crypto_fe_sub(x3, x3, t1);
+    headset_gfps_crypto_fe_mul(z3, t4, z3);
+    headset_gfps_crypto_fe_mul(t1, t3, t0);
+    headset_gfps_crypto_fe_add(z3, z3, t1);
+
+    memcpy((void *) p_r->x, (const void *) x3, sizeof(x3));
+    memcpy((void *) p_r->y, (const void *) y3, sizeof(y3));
+    memcpy((void *) p_r->z, (const void *) z3, sizeof(z3));
+}
+
+/*
+ * Exception free doubling for a = -3 (Renes, Costello, Batina 2016, algorithm 6). p_r may alias p_a.
+ */
+static void headset_gfps_crypto_point_double(headset_gfps_crypto_point_t *p_r, const headset_gfps_crypto_point_t *p_a)
+{
+    headset_gfps_crypto_fe_t t0, t1, t2, t3, x3, y3, z3;
+
+    headset_gfps_crypto_fe_mul(t0, p_a->x, p_a->x);
+    headset_gfps_crypto_fe_mul(t1, p_a->y, p_a->y);
+    headset_gfps_crypto_fe_mul(t2, p_a->z, p_a->z);
+    headset_gfps_crypto_fe_mul(t3, p_a->x, p_a->y);
+    headset_gfps_crypto_fe_add(t3, t3, t3);
+    headset_gfps_crypto_fe_mul(z3, p_a->x, p_a->z);
+    headset_gfps_crypto_fe_add(z3, z3, z3);
+    headset_gfps_crypto_fe_mul(y3, headset_gfps_crypto_b, t2);
+    headset_gfps_crypto_fe_sub(y3, y3, z3);
+    headset_gfps_crypto_fe_add(x3, y3, y3);
+    headset_gfps_crypto_fe_add(y3, x3, y3);
+    headset_gfps_crypto_fe_sub(x3, t1, y3);
+    headset_gfps_crypto_fe_add(y3, t1, y3);
+    headset_gfps_crypto_fe_mul(y3, x3, y3);
+    headset_gfps_crypto_fe_mul(x3, x3, t3);
+    headset_gfps_crypto_fe_add(t3, t2, t2);
+    headset_gfps_crypto_fe_add(t2, t2, t3);
+    headset_gfps_crypto_fe_mul(z3, headset_gfps_crypto_b, z3);
+    headset_gfps_crypto_fe_sub(z3, z3, t2);
+    headset_gfps_crypto_fe_sub(z3, z3, t0);
+    headset_gfps_crypto_fe_add(t3, z3, z3);
+    headset_gfps_crypto_fe_add(z3, z3, t3);
+    headset_gfps_crypto_fe_add(t3, t0, t0);
+    headset_gfps_crypto_fe_add(t0, t3, t0);
+    headset_gfps_crypto_fe_sub(t0, t0, t2);
+    headset_gfps_crypto_fe_mul(t0, t0, z3);
+    headset_gfps_crypto_fe_add(y3, y3, t0);
+    headset_gfps_crypto_fe_mul(t0, p_a->y, p_a->z);
+    headset_gfps_crypto_fe_add(t0, t0, t0);
+    headset_gfps_crypto_fe_mul(z3, t0, z3);
+    headset_gfps_crypto_fe_sub(x3, x3, z3);
+    headset_gfps_crypto_fe_mul(z3, t0, t1);
+    headset_gfps_crypto_fe_add(z3, z3, z3);
+    headset_gfps_crypto_fe_add(z3, z3, z3);
+
+    memcpy((void *) p_r->x, (const void *) x3, sizeof(x3));
+    memcpy((void *) p_r->y, (const void *) y3, sizeof(y3));
+    memcpy((void *) p_r->z, (const void *) z3, sizeof(z3));
+}
+
+/*
+ * Read table[index] touching every entry so the access pattern does not depend on the index.
+ */
+static void headset_gfps_crypto_point_select(headset_gfps_crypto_point_t *p_r, const headset_gfps_crypto_point_t *p_table,
+                                             uint32_t index)
+{
+    uint32_t mask;
+    uint32_t i;
+    uint8_t j;
+
+    memset((void *) p_r, 0, sizeof(*p_r));
+
+    for (i = 0; i < HEADSET_GFPS_CRYPTO_TABLE_SIZE; i++)
+    {
+        mask = 0 - (((i ^ index) - 1) >> 31);
+
+        for (j = 0; j < HEADSET_GFPS_CRYPTO_WORDS; j++)
+        {
+            p_r->x[j] |= p_table[i].x[j] & mask;
+            p_r->y[j] |= p_table[i].y[j] & mask;
+            p_r->z[j] |= p_table[i].z[j] & mask;
+        }
+    }
+}
+
+static uint8_t headset_gfps_crypto_xtime(uint8_t a)
+{
+    return (uint8_t) ((a << 1) ^ (0x1b & (0 - (a >> 7))));
+}
+
+static void headset_gfps_crypto_aes_mix_column(uint8_t *p_col)
+{
+    uint8_t a0 = p_col[0], a1 = p_col[1], a2 = p_col[2], a3 = p_col[3];
+    uint8_t all = a0 ^ a1 ^ a2 ^ a3;
+
+    p_col[0] = a0 ^ all ^ headset_gfps_crypto_xtime(a0 ^ a1);
+    p_col[1] = a1 ^ all ^ headset_gfps_crypto_xtime(a1 ^ a2);
+    p_col[2] = a2 ^ all ^ headset_gfps_crypto_xtime(a2 ^ a3);
+    p_col[3] = a3 ^ all ^ headset_gfps_crypto_xtime(a3 ^ a0);
+}
+
+static void headset_gfps_crypto_stats_update(headset_gfps_crypto_op_t op, uint64_t start_us)
+{
+    headset_gfps_crypto_stats_t *p_stats = &headset_gfps_crypto_stats[op];
+    uint32_t elapsed_us = (uint32_t) (clock_SystemTimeMicroseconds64() - start_us);
+
+    p_stats->count++;
+    p_stats->total_us += elapsed_us;
+
+    if (elapsed_us > p_stats->max_us)
+    {
+        p_stats->max_us = elapsed_us;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,191 @@
+/******************************************************************************
+* File Name:   headset_gfps_crypto.h
+*
+* Description: Instrumented P-256 ECDH and AES-128 for Fast Pair key-based pairing.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#if !defined(HEADSET_GFPS_CRYPTO_H)
+#define HEADSET_GFPS_CRYPTO_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+#include "wiced_result.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN       16
+#define HEADSET_GFPS_CRYPTO_AES_KEY_LEN         16
+#define HEADSET_GFPS_CRYPTO_P256_PRIVATE_LEN    32
+#define HEADSET_GFPS_CRYPTO_P256_PUBLIC_LEN     64  /* X || Y, big endian */
+#define HEADSET_GFPS_CRYPTO_P256_SHARED_LEN     32  /* X, big endian */
+
+/*******************************************************************************
+*        Data Types
+*******************************************************************************/
+/* Expanded AES-128 key, set once per shared key and used for every block */
+typedef struct
+{
+    uint8_t     round_key[11][HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN];
+} headset_gfps_crypto_aes_t;
+
+typedef enum
+{
+    HEADSET_GFPS_CRYPTO_OP_ECDH,
+    HEADSET_GFPS_CRYPTO_OP_AES_KEY,
+    HEADSET_GFPS_CRYPTO_OP_AES_BLOCK,
+    HEADSET_GFPS_CRYPTO_OP_NUM,
+} headset_gfps_crypto_op_t;
+
+typedef struct
+{
+    uint32_t    count;
+    uint32_t    total_us;
+    uint32_t    max_us;
+} headset_gfps_crypto_stats_t;
+
+/*******************************************************************************
+*        External Variable Declarations
+*******************************************************************************/
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: headset_gfps_crypto_ecdh
+********************************************************************************
+* Summary:
+*   Compute the P-256 ECDH shared secret. Runs in constant time with respect to
+*   the private key.
+*
+* Parameters:
+*   p_private   : private key, HEADSET_GFPS_CRYPTO_P256_PRIVATE_LEN bytes
+*   p_peer      : peer public key, HEADSET_GFPS_CRYPTO_P256_PUBLIC_LEN bytes
+*   p_shared    : output, HEADSET_GFPS_CRYPTO_P256_SHARED_LEN bytes
+*
+* Return:
+*   WICED_SUCCESS, or WICED_BADARG if either key is invalid
+*
+*******************************************************************************/
+wiced_result_t headset_gfps_crypto_ecdh(const uint8_t *p_private, const uint8_t *p_peer, uint8_t *p_shared);
+
+/*******************************************************************************
+* Function Name: headset_gfps_crypto_aes_key_set
+********************************************************************************
+* Summary:
+*   Expand an AES-128 key.
+*
+* Parameters:
+*   p_aes       : key context
+*   p_key       : key, HEADSET_GFPS_CRYPTO_AES_KEY_LEN bytes
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_gfps_crypto_aes_key_set(headset_gfps_crypto_aes_t *p_aes, const uint8_t *p_key);
+
+/*******************************************************************************
+* Function Name: headset_gfps_crypto_aes_encrypt
+********************************************************************************
+* Summary:
+*   Encrypt one block with AES-128. p_in and p_out may overlap.
+*
+* Parameters:
+*   p_aes       : expanded key
+*   p_in        : plain text block
+*   p_out       : cipher text block
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_gfps_crypto_aes_encrypt(const headset_gfps_crypto_aes_t *p_aes, const uint8_t *p_in, uint8_t *p_out);
+
+/*******************************************************************************
+* Function Name: headset_gfps_crypto_aes_decrypt
+********************************************************************************
+* Summary:
+*   Decrypt one block with AES-128. p_in and p_out may overlap.
+*
+* Parameters:
+*   p_aes       : expanded key
+*   p_in        : cipher text block
+*   p_out       : plain text block
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_gfps_crypto_aes_decrypt(const headset_gfps_crypto_aes_t *p_aes, const uint8_t *p_in, uint8_t *p_out);
+
+/*******************************************************************************
+* Function Name: headset_gfps_crypto_stats_get
+********************************************************************************
+* Summary:
+*   Get the timing statistics of an operation.
+*
+* Parameters:
+*   op          : operation
+*   p_stats     : output
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_gfps_crypto_stats_get(headset_gfps_crypto_op_t op, headset_gfps_crypto_stats_t *p_stats);
+
+/*******************************************************************************
+* Function Name: headset_gfps_crypto_stats_report
+********************************************************************************
+* Summary:
+*   Trace the timing statistics of every operation.
+*
+* Parameters:
+*   void
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_gfps_crypto_stats_report(void);
+
+#endif /* HEADSET_GFPS_CRYPTO_H */
+/* [] END OF FILE */
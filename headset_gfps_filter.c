@@ -0,0 +1,201 @@
+/******************************************************************************
+* File Name:   headset_gfps_filter.c
+*
+* Description: Fast Pair account key filter with per-key precomputed hash state.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+
+#include "headset_gfps_filter.h"
+#include "headset_sha256.h"
+#include "wiced_bt_types.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+/*
+ * The hashed value is the 16 byte key followed by the 1 byte salt, i.e. a single SHA-256 block
+ * whose message words 0 - 3 only depend on the key. The first four rounds only consume those
+ * words, so the working variables after round 3 are cached per key and each filter refresh
+ * starts at round 4 with the salt patched into word 4.
+ */
+#define HEADSET_GFPS_FILTER_CACHED_ROUNDS   4
+
+/*******************************************************************************
+* Structures
+********************************************************************************/
+typedef struct
+{
+    uint32_t    w[4];       /* Message words 0 - 3 (the key) */
+    uint32_t    state[8];   /* Working variables a - h after HEADSET_GFPS_FILTER_CACHED_ROUNDS rounds */
+} headset_gfps_filter_key_t;
+
+typedef struct
+{
+    uint8_t                     num_keys;
+    headset_gfps_filter_key_t   key[HEADSET_GFPS_FILTER_MAX_KEYS];
+
+    /* Last generated filter */
+    wiced_bool_t                filter_valid;
+    uint8_t                     filter_salt;
+    uint8_t                     filter[HEADSET_GFPS_FILTER_MAX_LEN];
+} headset_gfps_filter_cb_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static headset_gfps_filter_cb_t headset_gfps_filter_cb = {0};
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void headset_gfps_filter_hash(const headset_gfps_filter_key_t *p_key, uint8_t salt, uint32_t *p_hash);
+
+/*******************************************************************************
+* Global Function Definitions
+*******************************************************************************/
+
+wiced_result_t headset_gfps_filter_keys_set(const uint8_t (*p_keys)[HEADSET_GFPS_FILTER_KEY_LEN], uint8_t num_keys)
+{
+    headset_gfps_filter_key_t *p_key;
+    uint8_t i, j;
+
+    if ((num_keys > HEADSET_GFPS_FILTER_MAX_KEYS) || ((num_keys != 0) && (p_keys == NULL)))
+    {
+        return WICED_BADARG;
+    }
+
+    for (i = 0; i < num_keys; i++)
+    {
+        p_key = &headset_gfps_filter_cb.key[i];
+
+        for (j = 0; j < 4; j++)
+        {
+            p_key->w[j] = ((uint32_t) p_keys[i][4 * j] << 24) |
+                          ((uint32_t) p_keys[i][4 * j + 1] << 16) |
+                          ((uint32_t) p_keys[i][4 * j + 2] << 8) |
+                          ((uint32_t) p_keys[i][4 * j + 3]);
+        }
+
+        memcpy((void *) p_key->state, (const void *) headset_sha256_iv, sizeof(p_key->state));
+        headset_sha256_rounds(p_key->state, p_key->w, 0, HEADSET_GFPS_FILTER_CACHED_ROUNDS);
+    }
+
+    headset_gfps_filter_cb.num_keys     = num_keys;
+    headset_gfps_filter_cb.filter_valid = WICED_FALSE;
+
+    return WICED_SUCCESS;
+}
+
+/*
+ * Each key sets the 8 bits selected by the 8 big endian 32-bit words of SHA-256(key || salt),
+ * taken modulo the filter size in bits.
+ */
+uint8_t headset_gfps_filter_get(uint8_t salt, uint8_t *p_filter)
+{
+    headset_gfps_filter_cb_t *p_cb = &headset_gfps_filter_cb;
+    uint8_t len = HEADSET_GFPS_FILTER_LEN(p_cb->num_keys);
+    uint32_t hash[8];
+    uint32_t bit;
+    uint8_t i, j;
+
+    if (p_cb->num_keys == 0)
+    {
+        return 0;
+    }
+
+    if (!p_cb->filter_valid || (p_cb->filter_salt != salt))
+    {
+        memset((void *) p_cb->filter, 0, sizeof(p_cb->filter));
+
+        for (i = 0; i < p_cb->num_keys; i++)
+        {
+            headset_gfps_filter_hash(&p_cb->key[i], salt, hash);
+
+            for (j = 0; j < 8; j++)
+            {
+                bit = hash[j] % ((uint32_t) len * 8);
+                p_cb->filter[bit / 8] |= (uint8_t) (1 << (bit % 8));
+            }
+        }
+
+        p_cb->filter_salt   = salt;
+        p_cb->filter_valid  = WICED_TRUE;
+    }
+
+    memcpy((void *) p_filter, (void *) p_cb->filter, len);
+
+    return len;
+}
+
+/*******************************************************************************
+* Static Function Definitions
+*******************************************************************************/
+
+static void headset_gfps_filter_hash(const headset_gfps_filter_key_t *p_key, uint8_t salt, uint32_t *p_hash)
+{
+    uint32_t w[64];
+    uint8_t i;
+
+    /* key (16 bytes) || salt || 0x80 padding || zeros || message length (136 bits) */
+    w[0] = p_key->w[0];
+    w[1] = p_key->w[1];
+    w[2] = p_key->w[2];
+    w[3] = p_key->w[3];
+    w[4] = ((uint32_t) salt << 24) | 0x00800000;
+
+    for (i = 5; i < 15; i++)
+    {
+        w[i] = 0;
+    }
+    w[15] = (HEADSET_GFPS_FILTER_KEY_LEN + 1) * 8;
+
+    headset_sha256_schedule(w);
+
+    memcpy((void *) p_hash, (const void *) p_key->state, sizeof(p_key->state));
+    headset_sha256_rounds(p_hash, w, HEADSET_GFPS_FILTER_CACHED_ROUNDS, 64);
+
+    for (i = 0; i < 8; i++)
+    {
+        p_hash[i] += headset_sha256_iv[i];
+    }
+}
+
+/* [] END OF FILE */
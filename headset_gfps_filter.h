@@ -0,0 +1,108 @@
+/******************************************************************************
+* File Name:   headset_gfps_filter.h
+*
+* Description: Fast Pair account key filter with per-key precomputed hash state.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#if !defined(HEADSET_GFPS_FILTER_H)
+#define HEADSET_GFPS_FILTER_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+#include "wiced_result.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define HEADSET_GFPS_FILTER_KEY_LEN         16
+
+/* Maximum number of account keys */
+#ifndef HEADSET_GFPS_FILTER_MAX_KEYS
+#define HEADSET_GFPS_FILTER_MAX_KEYS        5
+#endif
+
+/* Filter length in bytes for n keys: floor(1.2 * n) + 3 */
+#define HEADSET_GFPS_FILTER_LEN(n)          (((n) * 6) / 5 + 3)
+
+#define HEADSET_GFPS_FILTER_MAX_LEN         HEADSET_GFPS_FILTER_LEN(HEADSET_GFPS_FILTER_MAX_KEYS)
+
+/*******************************************************************************
+*        External Variable Declarations
+*******************************************************************************/
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: headset_gfps_filter_keys_set
+********************************************************************************
+* Summary:
+*   Load the account key list and precompute the salt independent part of each key hash.
+*   Call when the list changes.
+*
+* Parameters:
+*   p_keys      : account keys, HEADSET_GFPS_FILTER_KEY_LEN bytes each
+*   num_keys    : number of keys (0 - HEADSET_GFPS_FILTER_MAX_KEYS)
+*
+* Return:
+*   WICED_SUCCESS or WICED_BADARG
+*
+*******************************************************************************/
+wiced_result_t headset_gfps_filter_keys_set(const uint8_t (*p_keys)[HEADSET_GFPS_FILTER_KEY_LEN], uint8_t num_keys);
+
+/*******************************************************************************
+* Function Name: headset_gfps_filter_get
+********************************************************************************
+* Summary:
+*   Get the account key filter for a salt. The last filter is kept so a refresh with the
+*   same salt and key list costs nothing.
+*
+* Parameters:
+*   salt        : salt advertised with the filter
+*   p_filter    : output, HEADSET_GFPS_FILTER_MAX_LEN bytes
+*
+* Return:
+*   filter length in bytes, 0 if there is no account key
+*
+*******************************************************************************/
+uint8_t headset_gfps_filter_get(uint8_t salt, uint8_t *p_filter);
+
+#endif /* HEADSET_GFPS_FILTER_H */
+/* [] END OF FILE */
@@ -0,0 +1,249 @@
+/******************************************************************************
+* File Name:   headset_le_conn_param.c
+*
+* Description: LE connection parameter policy following the BR/EDR audio load.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+
+#include "headset_le_conn_param.h"
+#include "wiced_bt_ble.h"
+#include "wiced_bt_l2c.h"
+#include "wiced_bt_trace.h"
+
+/*******************************************************************************
+* Structures
+********************************************************************************/
+typedef struct
+{
+    uint16_t    min_interval;   /* 1.25 ms */
+    uint16_t    max_interval;   /* 1.25 ms */
+    uint16_t    latency;        /* connection events */
+    uint16_t    timeout;        /* 10 ms */
+} headset_le_conn_param_t;
+
+typedef struct
+{
+    wiced_bool_t                connected;
+    wiced_bt_device_address_t   bd_addr;
+    uint8_t                     load;
+    headset_le_conn_param_set_t requested;      /* Last set requested to the peer */
+    wiced_bool_t                phy_2m;         /* 2M PHY requested on this link */
+    uint8_t                     tx_phy;         /* Current TX PHY, Mbit/s */
+    uint16_t                    interval;       /* Current interval, 1.25 ms */
+    uint16_t                    latency;
+} headset_le_conn_param_cb_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/*
+ * BR/EDR audio owns most of the air time while streaming (A2DP) and reserves fixed slots every
+ * few ms for a voice call (eSCO). Every LE connection event competes with those slots, so the
+ * LE link is slowed down while audio runs and sped up for GATT transfers when the air is free.
+ */
+static const headset_le_conn_param_t headset_le_conn_param_table[HEADSET_LE_CONN_PARAM_MAX] =
+{
+    [HEADSET_LE_CONN_PARAM_IDLE]        = { 24,  40,  4, 500 },     /* 30 - 50 ms */
+    [HEADSET_LE_CONN_PARAM_BULK]        = { 6,   12,  0, 500 },     /* 7.5 - 15 ms */
+    [HEADSET_LE_CONN_PARAM_A2DP]        = { 72,  96,  4, 600 },     /* 90 - 120 ms */
+    [HEADSET_LE_CONN_PARAM_A2DP_BULK]   = { 24,  36,  0, 500 },     /* 30 - 45 ms */
+    [HEADSET_LE_CONN_PARAM_ESCO]        = { 144, 160, 2, 600 },     /* 180 - 200 ms */
+};
+
+static headset_le_conn_param_cb_t headset_le_conn_param_cb = {0};
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void headset_le_conn_param_apply(void);
+
+/*******************************************************************************
+* Global Function Definitions
+*******************************************************************************/
+
+headset_le_conn_param_set_t headset_le_conn_param_select(uint8_t load)
+{
+    if (load & HEADSET_LE_CONN_PARAM_LOAD_ESCO)
+    {
+        return HEADSET_LE_CONN_PARAM_ESCO;
+    }
+
+    if (load & HEADSET_LE_CONN_PARAM_LOAD_A2DP)
+    {
+        return (load & HEADSET_LE_CONN_PARAM_LOAD_BULK) ? HEADSET_LE_CONN_PARAM_A2DP_BULK : HEADSET_LE_CONN_PARAM_A2DP;
+    }
+
+    if (load & HEADSET_LE_CONN_PARAM_LOAD_BULK)
+    {
+        return HEADSET_LE_CONN_PARAM_BULK;
+    }
+
+    return HEADSET_LE_CONN_PARAM_IDLE;
+}
+
+void headset_le_conn_param_load_set(uint8_t load, wiced_bool_t active)
+{
+    uint8_t previous = headset_le_conn_param_cb.load;
+
+    if (active)
+    {
+        headset_le_conn_param_cb.load |= load;
+    }
+    else
+    {
+        headset_le_conn_param_cb.load &= ~load;
+    }
+
+    if (headset_le_conn_param_cb.load != previous)
+    {
+        headset_le_conn_param_apply();
+    }
+}
+
+void headset_le_conn_param_link_up(wiced_bt_device_address_t bd_addr)
+{
+    headset_le_conn_param_cb.connected  = WICED_TRUE;
+    headset_le_conn_param_cb.phy_2m     = WICED_FALSE;
+    headset_le_conn_param_cb.tx_phy     = 1;
+    headset_le_conn_param_cb.requested  = HEADSET_LE_CONN_PARAM_MAX;
+    headset_le_conn_param_cb.interval   = 0;
+    headset_le_conn_param_cb.latency    = 0;
+    memcpy((void *) headset_le_conn_param_cb.bd_addr, (void *) bd_addr, sizeof(wiced_bt_device_address_t));
+
+    headset_le_conn_param_apply();
+}
+
+void headset_le_conn_param_link_down(void)
+{
+    headset_le_conn_param_cb.connected = WICED_FALSE;
+
+    /* Transfers end with the link. */
+    headset_le_conn_param_cb.load &= ~HEADSET_LE_CONN_PARAM_LOAD_OTA;
+}
+
+void headset_le_conn_param_update_evt(uint8_t status, uint16_t conn_interval, uint16_t conn_latency)
+{
+    if (status != 0)
+    {
+        /* Keep the set as requested so a refused request is not repeated until the load changes. */
+        WICED_BT_TRACE("headset_le_conn_param: set %d refused (%d)\n", headset_le_conn_param_cb.requested, status);
+        return;
+    }
+
+    headset_le_conn_param_cb.interval   = conn_interval;
+    headset_le_conn_param_cb.latency    = conn_latency;
+}
+
+void headset_le_conn_param_phy_update_evt(uint8_t tx_phy, uint8_t rx_phy)
+{
+    headset_le_conn_param_cb.tx_phy = tx_phy;
+
+    if ((tx_phy != 2) || (rx_phy != 2))
+    {
+        /* The peer does not support or refused 2M, phy_2m stays set so it is not asked again on this link. */
+        WICED_BT_TRACE("headset_le_conn_param: PHY %dM/%dM\n", tx_phy, rx_phy);
+    }
+}
+
+uint8_t headset_le_conn_param_tx_phy_get(void)
+{
+    return headset_le_conn_param_cb.tx_phy;
+}
+
+/*******************************************************************************
+* Static Function Definitions
+*******************************************************************************/
+
+/*
+ * Request the parameter set for the current load. A set is requested at most once per
+ * load change and not at all when the current interval already fits it.
+ */
+static void headset_le_conn_param_apply(void)
+{
+    headset_le_conn_param_cb_t *p_cb = &headset_le_conn_param_cb;
+    headset_le_conn_param_set_t set = headset_le_conn_param_select(p_cb->load);
+    const headset_le_conn_param_t *p_param = &headset_le_conn_param_table[set];
+    wiced_bt_ble_phy_preferences_t phy_preferences;
+
+    if (!p_cb->connected)
+    {
+        return;
+    }
+
+    /* Bulk transfers take less air time at 2M. */
+    if ((p_cb->load & HEADSET_LE_CONN_PARAM_LOAD_BULK) && !p_cb->phy_2m)
+    {
+        memset((void *) &phy_preferences, 0, sizeof(phy_preferences));
+        memcpy((void *) phy_preferences.remote_bd_addr, (void *) p_cb->bd_addr, sizeof(wiced_bt_device_address_t));
+        phy_preferences.tx_phys = BTM_BLE_PREFER_2M_PHY;
+        phy_preferences.rx_phys = BTM_BLE_PREFER_2M_PHY;
+
+        p_cb->phy_2m = WICED_TRUE;
+        wiced_bt_ble_set_phy(&phy_preferences);
+    }
+
+    if ((set == p_cb->requested) ||
+        ((p_cb->interval >= p_param->min_interval) &&
+         (p_cb->interval <= p_param->max_interval) &&
+         (p_cb->latency == p_param->latency)))
+    {
+        p_cb->requested = set;
+        return;
+    }
+
+    WICED_BT_TRACE("headset_le_conn_param: load 0x%x -> set %d (%d - %d, %d)\n",
+                   p_cb->load,
+                   set,
+                   p_param->min_interval,
+                   p_param->max_interval,
+                   p_param->latency);
+
+    if (wiced_bt_l2cap_update_ble_conn_params(p_cb->bd_addr,
+                                              p_param->min_interval,
+                                              p_param->max_interval,
+                                              p_param->latency,
+                                              p_param->timeout))
+    {
+        p_cb->requested = set;
+    }
+}
+
+/* [] END OF FILE */
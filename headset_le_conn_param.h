@@ -0,0 +1,192 @@
+/******************************************************************************
+* File Name:   headset_le_conn_param.h
+*
+* Description: LE connection parameter policy following the BR/EDR audio load.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#if !defined(HEADSET_LE_CONN_PARAM_H)
+#define HEADSET_LE_CONN_PARAM_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_dev.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/*
+ * Activities affecting the LE connection parameters (bit mask).
+ */
+#define HEADSET_LE_CONN_PARAM_LOAD_A2DP         (1 << 0)    /* A2DP stream running */
+#define HEADSET_LE_CONN_PARAM_LOAD_ESCO         (1 << 1)    /* (e)SCO link up */
+#define HEADSET_LE_CONN_PARAM_LOAD_FASTPAIR     (1 << 2)    /* Fast Pair procedure possible */
+#define HEADSET_LE_CONN_PARAM_LOAD_OTA          (1 << 3)    /* Firmware download running */
+
+#define HEADSET_LE_CONN_PARAM_LOAD_BULK         (HEADSET_LE_CONN_PARAM_LOAD_FASTPAIR | HEADSET_LE_CONN_PARAM_LOAD_OTA)
+
+/*
+ * Connection parameter sets.
+ */
+typedef enum
+{
+    HEADSET_LE_CONN_PARAM_IDLE,         /* Nothing else on air */
+    HEADSET_LE_CONN_PARAM_BULK,         /* GATT transfer, no audio */
+    HEADSET_LE_CONN_PARAM_A2DP,         /* Music streaming */
+    HEADSET_LE_CONN_PARAM_A2DP_BULK,    /* GATT transfer during music streaming */
+    HEADSET_LE_CONN_PARAM_ESCO,         /* Voice call, always wins */
+    HEADSET_LE_CONN_PARAM_MAX,
+} headset_le_conn_param_set_t;
+
+/*******************************************************************************
+*        External Variable Declarations
+*******************************************************************************/
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: headset_le_conn_param_select
+********************************************************************************
+* Summary:
+*   Policy: parameter set to use for a combination of activities.
+*
+* Parameters:
+*   load    : HEADSET_LE_CONN_PARAM_LOAD_xxx mask
+*
+* Return:
+*   parameter set
+*
+*******************************************************************************/
+headset_le_conn_param_set_t headset_le_conn_param_select(uint8_t load);
+
+/*******************************************************************************
+* Function Name: headset_le_conn_param_load_set
+********************************************************************************
+* Summary:
+*   Report the start or the end of an activity and update the LE link if needed.
+*
+* Parameters:
+*   load    : HEADSET_LE_CONN_PARAM_LOAD_xxx bit(s)
+*   active  : WICED_TRUE when started
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_le_conn_param_load_set(uint8_t load, wiced_bool_t active);
+
+/*******************************************************************************
+* Function Name: headset_le_conn_param_link_up
+********************************************************************************
+* Summary:
+*   LE link established.
+*
+* Parameters:
+*   bd_addr : peer address
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_le_conn_param_link_up(wiced_bt_device_address_t bd_addr);
+
+/*******************************************************************************
+* Function Name: headset_le_conn_param_link_down
+********************************************************************************
+* Summary:
+*   LE link released.
+*
+* Parameters:
+*   void
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_le_conn_param_link_down(void);
+
+/*******************************************************************************
+* Function Name: headset_le_conn_param_update_evt
+********************************************************************************
+* Summary:
+*   Handle BTM_BLE_CONNECTION_PARAM_UPDATE.
+*
+* Parameters:
+*   status          : HCI status
+*   conn_interval   : new interval in 1.25 ms
+*   conn_latency    : new peripheral latency
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_le_conn_param_update_evt(uint8_t status, uint16_t conn_interval, uint16_t conn_latency);
+
+/*******************************************************************************
+* Function Name: headset_le_conn_param_phy_update_evt
+********************************************************************************
+* Summary:
+*   Handle BTM_BLE_PHY_UPDATE_EVT.
+*
+* Parameters:
+*   tx_phy  : TX PHY in Mbit/s
+*   rx_phy  : RX PHY in Mbit/s
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_le_conn_param_phy_update_evt(uint8_t tx_phy, uint8_t rx_phy);
+
+/*******************************************************************************
+* Function Name: headset_le_conn_param_tx_phy_get
+********************************************************************************
+* Summary:
+*   TX PHY of the LE link, kept after the link is down.
+*
+* Parameters:
+*   void
+*
+* Return:
+*   TX PHY in Mbit/s, 1 until a PHY update
+*
+*******************************************************************************/
+uint8_t headset_le_conn_param_tx_phy_get(void);
+
+#endif /* HEADSET_LE_CONN_PARAM_H */
+/* [] END OF FILE */
@@ -0,0 +1,289 @@
+/******************************************************************************
+* File Name:   headset_link_state.c
+*
+* Description: State of the connected BR/EDR source devices.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+
+#include "headset_adv_sched.h"
+#include "headset_le_conn_param.h"
+#include "headset_link_state.h"
+#include "headset_power.h"
+#include "headset_sniff.h"
+#include "wiced_bt_trace.h"
+
+/*******************************************************************************
+* Structures
+********************************************************************************/
+typedef struct
+{
+    wiced_bool_t                in_use;
+    wiced_bt_device_address_t   bd_addr;
+    uint16_t                    a2dp_handle;
+    wiced_bool_t                a2dp_connected;
+    wiced_bool_t                streaming;
+} headset_link_state_link_t;
+
+typedef struct
+{
+    headset_link_state_link_t   link[HEADSET_LINK_STATE_MAX_LINKS];
+} headset_link_state_cb_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static headset_link_state_cb_t headset_link_state_cb = {0};
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static headset_link_state_link_t *headset_link_state_link_find(const wiced_bt_device_address_t bd_addr);
+static headset_link_state_link_t *headset_link_state_link_find_by_handle(uint16_t a2dp_handle);
+static headset_link_state_link_t *headset_link_state_link_alloc(const wiced_bt_device_address_t bd_addr);
+static void                       headset_link_state_state_update(void);
+
+/*******************************************************************************
+* Global Function Definitions
+*******************************************************************************/
+
+void headset_link_state_conn_status_change(wiced_bt_device_address_t bd_addr,
+                                           uint8_t *p_features,
+                                           wiced_bool_t is_connected,
+                                           uint16_t handle,
+                                           wiced_bt_transport_t transport,
+                                           uint8_t reason)
+{
+    headset_link_state_link_t *p_link;
+
+    (void) p_features;
+    (void) handle;
+
+    if (transport != BT_TRANSPORT_BR_EDR)
+    {
+        return;
+    }
+
+    WICED_BT_TRACE("headset_link_state: %B %s (reason 0x%02x)\n",
+                   bd_addr,
+                   is_connected ? "connected" : "disconnected",
+                   reason);
+
+    headset_sniff_link_set(bd_addr, is_connected);
+
+    if (is_connected)
+    {
+        if (headset_link_state_link_alloc(bd_addr) == NULL)
+        {
+            WICED_BT_TRACE("headset_link_state: no free link for %B\n", bd_addr);
+        }
+
+        headset_link_state_state_update();
+        return;
+    }
+
+    p_link = headset_link_state_link_find(bd_addr);
+    if (p_link != NULL)
+    {
+        memset((void *) p_link, 0, sizeof(*p_link));
+        headset_link_state_state_update();
+    }
+}
+
+void headset_link_state_a2dp_post_handler(wiced_bt_a2dp_sink_event_t event,
+                                          wiced_bt_a2dp_sink_event_data_t *p_data)
+{
+    headset_link_state_link_t *p_link;
+
+    switch (event)
+    {
+    case WICED_BT_A2DP_SINK_CONNECT_EVT:
+        if (p_data->connect.result != WICED_SUCCESS)
+        {
+            break;
+        }
+
+        p_link = headset_link_state_link_find(p_data->connect.bd_addr);
+        if (p_link == NULL)
+        {
+            p_link = headset_link_state_link_alloc(p_data->connect.bd_addr);
+        }
+
+        if (p_link != NULL)
+        {
+            p_link->a2dp_handle     = p_data->connect.handle;
+            p_link->a2dp_connected  = WICED_TRUE;
+        }
+        break;
+
+    case WICED_BT_A2DP_SINK_DISCONNECT_EVT:
+        p_link = headset_link_state_link_find_by_handle(p_data->disconnect.handle);
+        if (p_link != NULL)
+        {
+            p_link->a2dp_connected  = WICED_FALSE;
+            p_link->streaming       = WICED_FALSE;
+            headset_link_state_state_update();
+        }
+        break;
+
+    case WICED_BT_A2DP_SINK_START_IND_EVT:
+    case WICED_BT_A2DP_SINK_START_CFM_EVT:
+        p_link = headset_link_state_link_find_by_handle((event == WICED_BT_A2DP_SINK_START_IND_EVT) ?
+                                                        p_data->start_ind.handle :
+                                                        p_data->start_cfm.handle);
+        if ((p_link != NULL) && !p_link->streaming)
+        {
+            p_link->streaming = WICED_TRUE;
+            headset_link_state_state_update();
+        }
+        break;
+
+    case WICED_BT_A2DP_SINK_SUSPEND_EVT:
+        p_link = headset_link_state_link_find_by_handle(p_data->suspend.handle);
+        if (p_link != NULL)
+        {
+            p_link->streaming = WICED_FALSE;
+            headset_link_state_state_update();
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/*******************************************************************************
+* Static Function Definitions
+*******************************************************************************/
+
+static headset_link_state_link_t *headset_link_state_link_find(const wiced_bt_device_address_t bd_addr)
+{
+    uint8_t i;
+
+    for (i = 0; i < HEADSET_LINK_STATE_MAX_LINKS; i++)
+    {
+        if (headset_link_state_cb.link[i].in_use &&
+            (memcmp((void *) headset_link_state_cb.link[i].bd_addr, (void *) bd_addr, sizeof(wiced_bt_device_address_t)) == 0))
+        {
+            return &headset_link_state_cb.link[i];
+        }
+    }
+
+    return NULL;
+}
+
+static headset_link_state_link_t *headset_link_state_link_find_by_handle(uint16_t a2dp_handle)
+{
+    uint8_t i;
+
+    for (i = 0; i < HEADSET_LINK_STATE_MAX_LINKS; i++)
+    {
+        if (headset_link_state_cb.link[i].in_use &&
+            headset_link_state_cb.link[i].a2dp_connected &&
+            (headset_link_state_cb.link[i].a2dp_handle == a2dp_handle))
+        {
+            return &headset_link_state_cb.link[i];
+        }
+    }
+
+    return NULL;
+}
+
+static headset_link_state_link_t *headset_link_state_link_alloc(const wiced_bt_device_address_t bd_addr)
+{
+    headset_link_state_link_t *p_link = headset_link_state_link_find(bd_addr);
+    uint8_t i;
+
+    if (p_link != NULL)
+    {
+        return p_link;
+    }
+
+    for (i = 0; i < HEADSET_LINK_STATE_MAX_LINKS; i++)
+    {
+        if (!headset_link_state_cb.link[i].in_use)
+        {
+            p_link = &headset_link_state_cb.link[i];
+
+            memset((void *) p_link, 0, sizeof(*p_link));
+            p_link->in_use = WICED_TRUE;
+            memcpy((void *) p_link->bd_addr, (void *) bd_addr, sizeof(wiced_bt_device_address_t));
+
+            return p_link;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * The bt_hs_spk library routes the audio between the sources. The link states are only
+ * aggregated here for the modules tuning sniff, LE connection, advertising and power.
+ */
+static void headset_link_state_state_update(void)
+{
+    headset_link_state_cb_t *p_cb = &headset_link_state_cb;
+    headset_link_state_link_t *p_link;
+    wiced_bool_t streaming = WICED_FALSE;
+    wiced_bool_t connected = WICED_FALSE;
+    uint8_t i;
+
+    for (i = 0; i < HEADSET_LINK_STATE_MAX_LINKS; i++)
+    {
+        p_link = &p_cb->link[i];
+
+        if (!p_link->in_use)
+        {
+            continue;
+        }
+
+        streaming |= p_link->streaming;
+        headset_sniff_busy_set(p_link->bd_addr, p_link->streaming);
+        connected = WICED_TRUE;
+    }
+
+    headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_A2DP, streaming);
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_STREAMING, streaming);
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_BREDR_CONNECTED, connected);
+    headset_power_input_set(HEADSET_POWER_INPUT_STREAMING, streaming);
+    headset_power_input_set(HEADSET_POWER_INPUT_CONNECTED, connected);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,109 @@
+/******************************************************************************
+* File Name:   headset_link_state.h
+*
+* Description: State of the connected BR/EDR source devices.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#if !defined(HEADSET_LINK_STATE_H)
+#define HEADSET_LINK_STATE_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_a2dp_sink.h"
+#include "wiced_bt_dev.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#ifndef BT_HS_SPK_CONTROL_BR_EDR_MAX_CONNECTIONS
+#define BT_HS_SPK_CONTROL_BR_EDR_MAX_CONNECTIONS    1
+#endif
+
+#define HEADSET_LINK_STATE_MAX_LINKS                BT_HS_SPK_CONTROL_BR_EDR_MAX_CONNECTIONS
+
+/*******************************************************************************
+*        External Variable Declarations
+*******************************************************************************/
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: headset_link_state_conn_status_change
+********************************************************************************
+* Summary:
+*   Connection status callback of the bt_hs_spk library (conn_status_change_cb).
+*
+* Parameters:
+*   bd_addr         : peer address
+*   p_features      : peer features
+*   is_connected    : WICED_TRUE when the link is up
+*   handle          : ACL connection handle
+*   transport       : BT_TRANSPORT_BR_EDR or BT_TRANSPORT_LE
+*   reason          : disconnection reason
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_link_state_conn_status_change(wiced_bt_device_address_t bd_addr,
+                                           uint8_t *p_features,
+                                           wiced_bool_t is_connected,
+                                           uint16_t handle,
+                                           wiced_bt_transport_t transport,
+                                           uint8_t reason);
+
+/*******************************************************************************
+* Function Name: headset_link_state_a2dp_post_handler
+********************************************************************************
+* Summary:
+*   A2DP sink event handler called by the bt_hs_spk library after its own handling.
+*
+* Parameters:
+*   event   : A2DP sink event
+*   p_data  : event data
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_link_state_a2dp_post_handler(wiced_bt_a2dp_sink_event_t event,
+                                          wiced_bt_a2dp_sink_event_data_t *p_data);
+
+#endif /* HEADSET_LINK_STATE_H */
+/* [] END OF FILE */
@@ -0,0 +1,454 @@
+/******************************************************************************
+* File Name:   headset_ota_delta.c
+*
+* Description: Streaming OTA delta image reconstruction.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+
+#include "headset_ota_delta.h"
+#include "headset_sha256.h"
+#include "wiced_bt_trace.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define HEADSET_OTA_DELTA_OP_COPY       0
+#define HEADSET_OTA_DELTA_OP_INSERT     1
+
+/*******************************************************************************
+* Structures
+********************************************************************************/
+typedef enum
+{
+    HEADSET_OTA_DELTA_STATE_IDLE,
+    HEADSET_OTA_DELTA_STATE_HEADER,
+    HEADSET_OTA_DELTA_STATE_OP,             /* Reading an op varint */
+    HEADSET_OTA_DELTA_STATE_COPY_OFFSET,    /* Reading the source offset of a COPY */
+    HEADSET_OTA_DELTA_STATE_INSERT,         /* Receiving INSERT literals */
+    HEADSET_OTA_DELTA_STATE_DONE,
+    HEADSET_OTA_DELTA_STATE_ERROR,
+} headset_ota_delta_state_t;
+
+typedef struct
+{
+    headset_ota_delta_state_t   state;
+    headset_ota_delta_read_t    p_read;
+    headset_ota_delta_write_t   p_write;
+    uint32_t                    source_len;
+
+    uint8_t                     header[HEADSET_OTA_DELTA_HEADER_LEN];
+    uint8_t                     header_len;
+    uint32_t                    target_len;
+
+    /* Varint being decoded */
+    uint32_t                    varint;
+    uint8_t                     varint_shift;
+
+    uint32_t                    op_len;     /* Bytes left in the current op */
+    uint32_t                    src_pos;
+
+    /* Target image: bytes already written and the chunk being filled */
+    uint32_t                    written;
+    uint16_t                    page_fill;
+    uint8_t                     page[HEADSET_OTA_DELTA_PAGE_SIZE];
+
+    headset_sha256_t            sha;
+} headset_ota_delta_cb_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static headset_ota_delta_cb_t headset_ota_delta_cb = {0};
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static wiced_bool_t headset_ota_delta_header_parse(void);
+static wiced_bool_t headset_ota_delta_varint(uint8_t byte, wiced_bool_t *p_complete);
+static wiced_bool_t headset_ota_delta_op_start(void);
+static wiced_bool_t headset_ota_delta_copy(int32_t offset);
+static wiced_bool_t headset_ota_delta_page_commit(uint16_t len);
+static wiced_bool_t headset_ota_delta_page_flush(void);
+static uint32_t     headset_ota_delta_le32(const uint8_t *p);
+
+/*******************************************************************************
+* Global Function Definitions
+*******************************************************************************/
+
+wiced_result_t headset_ota_delta_start(headset_ota_delta_read_t p_read, headset_ota_delta_write_t p_write,
+                                       uint32_t source_len)
+{
+    if ((p_read == NULL) || (p_write == NULL))
+    {
+        return WICED_BADARG;
+    }
+
+    memset((void *) &headset_ota_delta_cb, 0, sizeof(headset_ota_delta_cb));
+
+    headset_ota_delta_cb.p_read     = p_read;
+    headset_ota_delta_cb.p_write    = p_write;
+    headset_ota_delta_cb.source_len = source_len;
+    headset_ota_delta_cb.state      = HEADSET_OTA_DELTA_STATE_HEADER;
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t headset_ota_delta_data(const uint8_t *p_data, uint32_t len)
+{
+    headset_ota_delta_cb_t *p_cb = &headset_ota_delta_cb;
+    wiced_bool_t complete;
+    wiced_bool_t ok = WICED_TRUE;
+    uint32_t n;
+
+    while ((len != 0) && ok)
+    {
+        switch (p_cb->state)
+        {
+        case HEADSET_OTA_DELTA_STATE_HEADER:
+            n = HEADSET_OTA_DELTA_HEADER_LEN - p_cb->header_len;
+            if (n > len)
+            {
+                n = len;
+            }
+
+            memcpy((void *) &p_cb->header[p_cb->header_len], (const void *) p_data, n);
+            p_cb->header_len    += n;
+            p_data              += n;
+            len                 -= n;
+
+            if (p_cb->header_len == HEADSET_OTA_DELTA_HEADER_LEN)
+            {
+                ok = headset_ota_delta_header_parse();
+            }
+            break;
+
+        case HEADSET_OTA_DELTA_STATE_OP:
+            ok = headset_ota_delta_varint(*p_data++, &complete);
+            len--;
+
+            if (ok && complete)
+            {
+                ok = headset_ota_delta_op_start();
+            }
+            break;
+
+        case HEADSET_OTA_DELTA_STATE_COPY_OFFSET:
+            ok = headset_ota_delta_varint(*p_data++, &complete);
+            len--;
+
+            if (ok && complete)
+            {
+                /* zigzag */
+                ok = headset_ota_delta_copy((int32_t) ((p_cb->varint >> 1) ^ (0 - (p_cb->varint & 1))));
+            }
+            break;
+
+        case HEADSET_OTA_DELTA_STATE_INSERT:
+            n = HEADSET_OTA_DELTA_PAGE_SIZE - p_cb->page_fill;
+            if (n > p_cb->op_len)
+            {
+                n = p_cb->op_len;
+            }
+            if (n > len)
+            {
+                n = len;
+            }
+
+            memcpy((void *) &p_cb->page[p_cb->page_fill], (const void *) p_data, n);
+            p_data          += n;
+            len             -= n;
+            p_cb->op_len    -= n;
+
+            ok = headset_ota_delta_page_commit((uint16_t) n);
+
+            if (ok && (p_cb->op_len == 0))
+            {
+                p_cb->state = ((p_cb->written + p_cb->page_fill) == p_cb->target_len) ?
+                              HEADSET_OTA_DELTA_STATE_DONE : HEADSET_OTA_DELTA_STATE_OP;
+            }
+            break;
+
+        default:
+            /* Data after the end of the image or after an error */
+            ok = WICED_FALSE;
+            break;
+        }
+    }
+
+    if (!ok)
+    {
+        WICED_BT_TRACE("headset_ota_delta: stream error at target offset %d\n",
+                       p_cb->written + p_cb->page_fill);
+        p_cb->state = HEADSET_OTA_DELTA_STATE_ERROR;
+        return WICED_ERROR;
+    }
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t headset_ota_delta_finish(void)
+{
+    headset_ota_delta_cb_t *p_cb = &headset_ota_delta_cb;
+    uint8_t digest[HEADSET_SHA256_DIGEST_LEN];
+
+    /* An empty target completes with the header. */
+    if ((p_cb->state != HEADSET_OTA_DELTA_STATE_DONE) ||
+        !headset_ota_delta_page_flush())
+    {
+        WICED_BT_TRACE("headset_ota_delta: incomplete image %d / %d\n",
+                       p_cb->written + p_cb->page_fill,
+                       p_cb->target_len);
+        p_cb->state = HEADSET_OTA_DELTA_STATE_ERROR;
+        return WICED_ERROR;
+    }
+
+    headset_sha256_final(&p_cb->sha, digest);
+
+    p_cb->state = HEADSET_OTA_DELTA_STATE_IDLE;
+
+    if (memcmp((const void *) digest,
+               (const void *) &p_cb->header[16 + HEADSET_SHA256_DIGEST_LEN],
+               HEADSET_SHA256_DIGEST_LEN) != 0)
+    {
+        WICED_BT_TRACE("headset_ota_delta: image hash mismatch\n");
+        return WICED_ERROR;
+    }
+
+    WICED_BT_TRACE("headset_ota_delta: image %d bytes verified\n", p_cb->written);
+
+    return WICED_SUCCESS;
+}
+
+/*******************************************************************************
+* Static Function Definitions
+*******************************************************************************/
+
+/*
+ * Check the header against the running image. The source is hashed once up front so a delta
+ * built for another release is refused before anything is written.
+ */
+static wiced_bool_t headset_ota_delta_header_parse(void)
+{
+    headset_ota_delta_cb_t *p_cb = &headset_ota_delta_cb;
+    uint8_t digest[HEADSET_SHA256_DIGEST_LEN];
+    uint32_t offset;
+    uint32_t n;
+
+    if ((memcmp((const void *) p_cb->header, (const void *) "HDLT", 4) != 0) ||
+        (p_cb->header[4] != HEADSET_OTA_DELTA_VERSION))
+    {
+        WICED_BT_TRACE("headset_ota_delta: bad header\n");
+        return WICED_FALSE;
+    }
+
+    if (headset_ota_delta_le32(&p_cb->header[8]) != p_cb->source_len)
+    {
+        WICED_BT_TRACE("headset_ota_delta: source length %d, running image %d\n",
+                       headset_ota_delta_le32(&p_cb->header[8]),
+                       p_cb->source_len);
+        return WICED_FALSE;
+    }
+
+    headset_sha256_init(&p_cb->sha);
+
+    for (offset = 0; offset < p_cb->source_len; offset += n)
+    {
+        n = p_cb->source_len - offset;
+        if (n > HEADSET_OTA_DELTA_PAGE_SIZE)
+        {
+            n = HEADSET_OTA_DELTA_PAGE_SIZE;
+        }
+
+        if (!p_cb->p_read(offset, p_cb->page, n))
+        {
+            return WICED_FALSE;
+        }
+
+        headset_sha256_update(&p_cb->sha, p_cb->page, n);
+    }
+
+    headset_sha256_final(&p_cb->sha, digest);
+
+    if (memcmp((const void *) digest, (const void *) &p_cb->header[16], HEADSET_SHA256_DIGEST_LEN) != 0)
+    {
+        WICED_BT_TRACE("headset_ota_delta: delta is for another image\n");
+        return WICED_FALSE;
+    }
+
+    /* The same context now hashes the target as it is produced. */
+    headset_sha256_init(&p_cb->sha);
+
+    p_cb->target_len    = headset_ota_delta_le32(&p_cb->header[12]);
+    p_cb->state         = (p_cb->target_len == 0) ? HEADSET_OTA_DELTA_STATE_DONE : HEADSET_OTA_DELTA_STATE_OP;
+
+    return WICED_TRUE;
+}
+
+/*
+ * LEB128, at most 32 bits
+ */
+static wiced_bool_t headset_ota_delta_varint(uint8_t byte, wiced_bool_t *p_complete)
+{
+    headset_ota_delta_cb_t *p_cb = &headset_ota_delta_cb;
+
+    if ((p_cb->varint_shift > 28) || ((p_cb->varint_shift == 28) && ((byte & 0x70) != 0)))
+    {
+        return WICED_FALSE;
+    }
+
+    p_cb->varint        |= (uint32_t) (byte & 0x7f) << p_cb->varint_shift;
+    p_cb->varint_shift  += 7;
+
+    *p_complete = (byte & 0x80) ? WICED_FALSE : WICED_TRUE;
+
+    return WICED_TRUE;
+}
+
+static wiced_bool_t headset_ota_delta_op_start(void)
+{
+    headset_ota_delta_cb_t *p_cb = &headset_ota_delta_cb;
+    uint32_t op = p_cb->varint;
+
+    p_cb->varint        = 0;
+    p_cb->varint_shift  = 0;
+    p_cb->op_len        = op >> 1;
+
+    if ((p_cb->op_len == 0) ||
+        (p_cb->op_len > (p_cb->target_len - p_cb->written - p_cb->page_fill)))
+    {
+        return WICED_FALSE;
+    }
+
+    p_cb->state = ((op & 1) == HEADSET_OTA_DELTA_OP_INSERT) ?
+                  HEADSET_OTA_DELTA_STATE_INSERT : HEADSET_OTA_DELTA_STATE_COPY_OFFSET;
+
+    return WICED_TRUE;
+}
+
+/*
+ * Copy op_len bytes of the running image, straight into the chunk buffer.
+ */
+static wiced_bool_t headset_ota_delta_copy(int32_t offset)
+{
+    headset_ota_delta_cb_t *p_cb = &headset_ota_delta_cb;
+    uint32_t n;
+
+    p_cb->varint        = 0;
+    p_cb->varint_shift  = 0;
+    p_cb->src_pos       += (uint32_t) offset;
+
+    if ((p_cb->src_pos > p_cb->source_len) || (p_cb->op_len > (p_cb->source_len - p_cb->src_pos)))
+    {
+        return WICED_FALSE;
+    }
+
+    while (p_cb->op_len != 0)
+    {
+        n = HEADSET_OTA_DELTA_PAGE_SIZE - p_cb->page_fill;
+        if (n > p_cb->op_len)
+        {
+            n = p_cb->op_len;
+        }
+
+        if (!p_cb->p_read(p_cb->src_pos, &p_cb->page[p_cb->page_fill], n))
+        {
+            return WICED_FALSE;
+        }
+
+        p_cb->src_pos   += n;
+        p_cb->op_len    -= n;
+
+        if (!headset_ota_delta_page_commit((uint16_t) n))
+        {
+            return WICED_FALSE;
+        }
+    }
+
+    p_cb->state = ((p_cb->written + p_cb->page_fill) == p_cb->target_len) ?
+                  HEADSET_OTA_DELTA_STATE_DONE : HEADSET_OTA_DELTA_STATE_OP;
+
+    return WICED_TRUE;
+}
+
+/*
+ * Account for len new bytes at the end of the chunk buffer, write it out once full.
+ */
+static wiced_bool_t headset_ota_delta_page_commit(uint16_t len)
+{
+    headset_ota_delta_cb_t *p_cb = &headset_ota_delta_cb;
+
+    headset_sha256_update(&p_cb->sha, &p_cb->page[p_cb->page_fill], len);
+    p_cb->page_fill += len;
+
+    if (p_cb->page_fill < HEADSET_OTA_DELTA_PAGE_SIZE)
+    {
+        return WICED_TRUE;
+    }
+
+    return headset_ota_delta_page_flush();
+}
+
+static wiced_bool_t headset_ota_delta_page_flush(void)
+{
+    headset_ota_delta_cb_t *p_cb = &headset_ota_delta_cb;
+
+    if (p_cb->page_fill == 0)
+    {
+        return WICED_TRUE;
+    }
+
+    if (!p_cb->p_write(p_cb->written, p_cb->page, p_cb->page_fill))
+    {
+        return WICED_FALSE;
+    }
+
+    p_cb->written   += p_cb->page_fill;
+    p_cb->page_fill = 0;
+
+    return WICED_TRUE;
+}
+
+static uint32_t headset_ota_delta_le32(const uint8_t *p)
+{
+    return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,139 @@
+/******************************************************************************
+* File Name:   headset_ota_delta.h
+*
+* Description: Streaming OTA delta image reconstruction.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#if !defined(HEADSET_OTA_DELTA_H)
+#define HEADSET_OTA_DELTA_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+#include "wiced_bt_types.h"
+#include "wiced_result.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/*
+ * Delta stream layout (little endian), produced by scripts/ota_delta.py:
+ *
+ *  header  : "HDLT", version (1), 3 reserved bytes, source length (4), target length (4),
+ *            SHA-256 of the source (32), SHA-256 of the target (32)
+ *  ops     : varint (length << 1 | type) until the target is complete
+ *            type 0 COPY   : followed by a zigzag varint added to the source position, then
+ *                            length bytes are copied from the source
+ *            type 1 INSERT : followed by length literal bytes
+ */
+#define HEADSET_OTA_DELTA_VERSION       1
+#define HEADSET_OTA_DELTA_HEADER_LEN    80
+
+/* Target image is written in chunks of this size, aligned to the start of the image */
+#ifndef HEADSET_OTA_DELTA_PAGE_SIZE
+#define HEADSET_OTA_DELTA_PAGE_SIZE     256
+#endif
+
+/*******************************************************************************
+*        Data Types
+*******************************************************************************/
+/* Read from the running image */
+typedef wiced_bool_t (*headset_ota_delta_read_t)(uint32_t offset, uint8_t *p_data, uint32_t len);
+
+/* Write the new image. offset is a multiple of HEADSET_OTA_DELTA_PAGE_SIZE. */
+typedef wiced_bool_t (*headset_ota_delta_write_t)(uint32_t offset, const uint8_t *p_data, uint32_t len);
+
+/*******************************************************************************
+*        External Variable Declarations
+*******************************************************************************/
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: headset_ota_delta_start
+********************************************************************************
+* Summary:
+*   Start reconstructing an image from a delta stream.
+*
+* Parameters:
+*   p_read      : source image reader
+*   p_write     : target image writer
+*   source_len  : size of the running image
+*
+* Return:
+*   WICED_SUCCESS or WICED_BADARG
+*
+*******************************************************************************/
+wiced_result_t headset_ota_delta_start(headset_ota_delta_read_t p_read, headset_ota_delta_write_t p_write,
+                                       uint32_t source_len);
+
+/*******************************************************************************
+* Function Name: headset_ota_delta_data
+********************************************************************************
+* Summary:
+*   Feed the next part of the delta stream. Parts may be split anywhere.
+*
+* Parameters:
+*   p_data      : delta stream data
+*   len         : length in bytes
+*
+* Return:
+*   WICED_SUCCESS, or WICED_ERROR if the stream does not apply to the running image
+*
+*******************************************************************************/
+wiced_result_t headset_ota_delta_data(const uint8_t *p_data, uint32_t len);
+
+/*******************************************************************************
+* Function Name: headset_ota_delta_finish
+********************************************************************************
+* Summary:
+*   Write the last chunk and check the new image against the hash in the header.
+*
+* Parameters:
+*   void
+*
+* Return:
+*   WICED_SUCCESS, or WICED_ERROR if the image is incomplete or does not match
+*
+*******************************************************************************/
+wiced_result_t headset_ota_delta_finish(void);
+
+#endif /* HEADSET_OTA_DELTA_H */
+/* [] END OF FILE */
@@ -0,0 +1,290 @@
+/******************************************************************************
+* File Name:   headset_power.c
+*
+* Description: Power state machine: per-state radio policy, auto-off and energy estimate.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+
+#include "clock_timer.h"
+#include "headset_adv_sched.h"
+#include "headset_power.h"
+#include "headset_sniff.h"
+#include "wiced_bt_trace.h"
+#include "wiced_timer.h"
+
+/*******************************************************************************
+* Structures
+********************************************************************************/
+typedef struct
+{
+    const char      *name;
+    uint16_t        current_ua;     /* Estimated average system current */
+    wiced_bool_t    sniff;          /* Idle links may enter sniff mode (see headset_sniff) */
+    wiced_bool_t    auto_off;       /* Auto-off timer runs */
+} headset_power_state_cfg_t;
+
+typedef struct
+{
+    headset_power_state_t   state;
+    uint8_t                 inputs;
+    wiced_bool_t            adv_off_requested;
+    wiced_timer_t           auto_off_timer;
+
+    /* Energy estimate */
+    uint64_t                state_entry_us;
+    uint64_t                state_time_ms[HEADSET_POWER_STATE_MAX];
+} headset_power_cb_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/*
+ * The currents are estimates for the whole board (radio, MCU, codec) and shall be replaced by
+ * measurements of the product. They are only used for the energy report.
+ * Page scan is left to the bt_hs_spk library in every state, the advertising off state only saves the adverts.
+ */
+static const headset_power_state_cfg_t headset_power_state_cfg[HEADSET_POWER_STATE_MAX] =
+{
+    [HEADSET_POWER_STATE_ADV_OFF]           = { "advertising off",   200,   WICED_TRUE,  WICED_FALSE },
+    [HEADSET_POWER_STATE_DISCONNECTED_IDLE] = { "disconnected idle", 250,   WICED_TRUE,  WICED_TRUE  },
+    [HEADSET_POWER_STATE_DISCOVERABLE]      = { "discoverable",      1500,  WICED_TRUE,  WICED_FALSE },
+    [HEADSET_POWER_STATE_CONNECTED_IDLE]    = { "connected idle",    400,   WICED_TRUE,  WICED_FALSE },
+    [HEADSET_POWER_STATE_STREAMING]         = { "streaming",         8000,  WICED_TRUE,  WICED_FALSE },
+    [HEADSET_POWER_STATE_CALL]              = { "call",              9000,  WICED_FALSE, WICED_FALSE },
+};
+
+static headset_power_cb_t headset_power_cb = {0};
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void                     headset_power_auto_off_timeout(WICED_TIMER_PARAM_TYPE arg);
+static headset_power_state_t    headset_power_select(void);
+static void                     headset_power_update(void);
+
+/*******************************************************************************
+* Global Function Definitions
+*******************************************************************************/
+
+void headset_power_init(void)
+{
+    memset((void *) &headset_power_cb, 0, sizeof(headset_power_cb));
+
+    wiced_init_timer(&headset_power_cb.auto_off_timer,
+                     headset_power_auto_off_timeout,
+                     0,
+                     WICED_SECONDS_TIMER);
+
+    headset_power_cb.state          = HEADSET_POWER_STATE_DISCONNECTED_IDLE;
+    headset_power_cb.state_entry_us = clock_SystemTimeMicroseconds64();
+
+#if HEADSET_POWER_AUTO_OFF
+    wiced_start_timer(&headset_power_cb.auto_off_timer, HEADSET_POWER_AUTO_OFF_TIMEOUT);
+#endif
+
+    headset_sniff_allowed_set(headset_power_state_cfg[headset_power_cb.state].sniff);
+}
+
+void headset_power_input_set(uint8_t input, wiced_bool_t set)
+{
+    uint8_t previous = headset_power_cb.inputs;
+
+    if (set)
+    {
+        headset_power_cb.inputs |= input;
+    }
+    else
+    {
+        headset_power_cb.inputs &= ~input;
+    }
+
+    if (headset_power_cb.inputs != previous)
+    {
+        headset_power_update();
+    }
+}
+
+void headset_power_user_activity(void)
+{
+    if (HEADSET_POWER_AUTO_OFF && (headset_power_cb.state == HEADSET_POWER_STATE_DISCONNECTED_IDLE))
+    {
+        wiced_start_timer(&headset_power_cb.auto_off_timer, HEADSET_POWER_AUTO_OFF_TIMEOUT);
+    }
+
+    if (headset_power_cb.adv_off_requested)
+    {
+        headset_power_cb.adv_off_requested = WICED_FALSE;
+        headset_power_update();
+    }
+}
+
+headset_power_state_t headset_power_state_get(void)
+{
+    return headset_power_cb.state;
+}
+
+void headset_power_energy_report(void)
+{
+    uint64_t now_us = clock_SystemTimeMicroseconds64();
+    uint64_t time_ms;
+    uint32_t total_uah = 0;
+    uint32_t uah;
+    uint8_t i;
+
+    for (i = 0; i < HEADSET_POWER_STATE_MAX; i++)
+    {
+        time_ms = headset_power_cb.state_time_ms[i];
+
+        if (i == headset_power_cb.state)
+        {
+            time_ms += (now_us - headset_power_cb.state_entry_us) / 1000;
+        }
+
+        uah         = (uint32_t) ((time_ms * headset_power_state_cfg[i].current_ua) / 3600000);
+        total_uah  += uah;
+
+        WICED_BT_TRACE("headset_power: %s %d s %d uAh\n",
+                       headset_power_state_cfg[i].name,
+                       (uint32_t) (time_ms / 1000),
+                       uah);
+    }
+
+    WICED_BT_TRACE("headset_power: total %d uAh\n", total_uah);
+}
+
+/*******************************************************************************
+* Static Function Definitions
+*******************************************************************************/
+
+static void headset_power_auto_off_timeout(WICED_TIMER_PARAM_TYPE arg)
+{
+    (void) arg;
+
+    if (headset_power_cb.state == HEADSET_POWER_STATE_DISCONNECTED_IDLE)
+    {
+        headset_power_cb.adv_off_requested = WICED_TRUE;
+        headset_power_update();
+    }
+}
+
+static headset_power_state_t headset_power_select(void)
+{
+    uint8_t inputs = headset_power_cb.inputs;
+
+    if (inputs & HEADSET_POWER_INPUT_CALL)
+    {
+        return HEADSET_POWER_STATE_CALL;
+    }
+
+    if (inputs & HEADSET_POWER_INPUT_STREAMING)
+    {
+        return HEADSET_POWER_STATE_STREAMING;
+    }
+
+    if (inputs & HEADSET_POWER_INPUT_CONNECTED)
+    {
+        return HEADSET_POWER_STATE_CONNECTED_IDLE;
+    }
+
+    if (inputs & HEADSET_POWER_INPUT_DISCOVERABLE)
+    {
+        return HEADSET_POWER_STATE_DISCOVERABLE;
+    }
+
+    return headset_power_cb.adv_off_requested ? HEADSET_POWER_STATE_ADV_OFF : HEADSET_POWER_STATE_DISCONNECTED_IDLE;
+}
+
+static void headset_power_update(void)
+{
+    headset_power_state_t state = headset_power_select();
+    headset_power_state_t previous = headset_power_cb.state;
+    uint64_t now_us;
+
+    if (state == previous)
+    {
+        return;
+    }
+
+    now_us = clock_SystemTimeMicroseconds64();
+    headset_power_cb.state_time_ms[previous] += (now_us - headset_power_cb.state_entry_us) / 1000;
+    headset_power_cb.state_entry_us = now_us;
+    headset_power_cb.state          = state;
+
+    WICED_BT_TRACE("headset_power: %s -> %s\n",
+                   headset_power_state_cfg[previous].name,
+                   headset_power_state_cfg[state].name);
+
+    /* Any state change other than the timeout itself cancels a pending auto-off. */
+    if (state != HEADSET_POWER_STATE_ADV_OFF)
+    {
+        headset_power_cb.adv_off_requested = WICED_FALSE;
+    }
+
+    if (HEADSET_POWER_AUTO_OFF && headset_power_state_cfg[state].auto_off)
+    {
+        wiced_start_timer(&headset_power_cb.auto_off_timer, HEADSET_POWER_AUTO_OFF_TIMEOUT);
+    }
+    else if (wiced_is_timer_in_use(&headset_power_cb.auto_off_timer))
+    {
+        wiced_stop_timer(&headset_power_cb.auto_off_timer);
+    }
+
+    /*
+     * Advertising off: stop advertising until a button press. Page scan stays with the bt_hs_spk
+     * library so that paired sources can still reconnect.
+     */
+    if (state == HEADSET_POWER_STATE_ADV_OFF)
+    {
+        headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_AUTO_OFF, WICED_TRUE);
+    }
+    else if (previous == HEADSET_POWER_STATE_ADV_OFF)
+    {
+        headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_AUTO_OFF, WICED_FALSE);
+    }
+
+    headset_sniff_allowed_set(headset_power_state_cfg[state].sniff);
+
+#ifdef LOW_POWER_MEASURE_MODE
+    headset_power_energy_report();
+#endif
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,169 @@
+/******************************************************************************
+* File Name:   headset_power.h
+*
+* Description: Power state machine: per-state radio policy, auto-off and energy estimate.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#if !defined(HEADSET_POWER_H)
+#define HEADSET_POWER_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+#include "wiced_bt_dev.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+/*
+ * Inputs of the state machine (bit mask).
+ */
+#define HEADSET_POWER_INPUT_DISCOVERABLE        (1 << 0)
+#define HEADSET_POWER_INPUT_CONNECTED           (1 << 1)    /* At least one BR/EDR source connected */
+#define HEADSET_POWER_INPUT_STREAMING           (1 << 2)
+#define HEADSET_POWER_INPUT_CALL                (1 << 3)
+
+/* Stop advertising after HEADSET_POWER_AUTO_OFF_TIMEOUT without connection and user activity */
+#ifndef HEADSET_POWER_AUTO_OFF
+#define HEADSET_POWER_AUTO_OFF                  0
+#endif
+#ifndef HEADSET_POWER_AUTO_OFF_TIMEOUT
+#ifdef LOW_POWER_MEASURE_MODE
+#define HEADSET_POWER_AUTO_OFF_TIMEOUT          60      /* seconds */
+#else
+#define HEADSET_POWER_AUTO_OFF_TIMEOUT          600     /* seconds */
+#endif
+#endif
+
+typedef enum
+{
+    HEADSET_POWER_STATE_ADV_OFF,            /* Auto-off: advertising stopped until a button press */
+    HEADSET_POWER_STATE_DISCONNECTED_IDLE,  /* Page scan only */
+    HEADSET_POWER_STATE_DISCOVERABLE,       /* Pairing mode */
+    HEADSET_POWER_STATE_CONNECTED_IDLE,     /* Links idle, sniff when no stream */
+    HEADSET_POWER_STATE_STREAMING,
+    HEADSET_POWER_STATE_CALL,
+    HEADSET_POWER_STATE_MAX,
+} headset_power_state_t;
+
+/*******************************************************************************
+*        External Variable Declarations
+*******************************************************************************/
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: headset_power_init
+********************************************************************************
+* Summary:
+*   Initialize the state machine in the disconnected idle state.
+*
+* Parameters:
+*   void
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_power_init(void);
+
+/*******************************************************************************
+* Function Name: headset_power_input_set
+********************************************************************************
+* Summary:
+*   Set or clear inputs and run the state machine.
+*
+* Parameters:
+*   input   : HEADSET_POWER_INPUT_xxx bit(s)
+*   set     : WICED_TRUE to set, WICED_FALSE to clear
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_power_input_set(uint8_t input, wiced_bool_t set);
+
+/*******************************************************************************
+* Function Name: headset_power_user_activity
+********************************************************************************
+* Summary:
+*   User activity (button). Restarts the auto-off timer and restarts advertising.
+*
+* Parameters:
+*   void
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_power_user_activity(void);
+
+/*******************************************************************************
+* Function Name: headset_power_state_get
+********************************************************************************
+* Summary:
+*   Get the current power state.
+*
+* Parameters:
+*   void
+*
+* Return:
+*   power state
+*
+*******************************************************************************/
+headset_power_state_t headset_power_state_get(void);
+
+/*******************************************************************************
+* Function Name: headset_power_energy_report
+********************************************************************************
+* Summary:
+*   Trace the time spent and the estimated charge used in each state since start up.
+*
+* Parameters:
+*   void
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_power_energy_report(void);
+
+#endif /* HEADSET_POWER_H */
+/* [] END OF FILE */
@@ -0,0 +1,229 @@
+/******************************************************************************
+* File Name:   headset_sha256.c
+*
+* Description: SHA-256 used by the Fast Pair filter and the OTA delta image check.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+
+#include "headset_sha256.h"
+
+/*******************************************************************************
+* Macro Definitions
+*******************************************************************************/
+#define HEADSET_SHA256_ROTR(x, n)       (((x) >> (n)) | ((x) << (32 - (n))))
+#define HEADSET_SHA256_CH(x, y, z)      (((x) & (y)) ^ (~(x) & (z)))
+#define HEADSET_SHA256_MAJ(x, y, z)     (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define HEADSET_SHA256_S0(x)            (HEADSET_SHA256_ROTR(x, 2) ^ HEADSET_SHA256_ROTR(x, 13) ^ HEADSET_SHA256_ROTR(x, 22))
+#define HEADSET_SHA256_S1(x)            (HEADSET_SHA256_ROTR(x, 6) ^ HEADSET_SHA256_ROTR(x, 11) ^ HEADSET_SHA256_ROTR(x, 25))
+#define HEADSET_SHA256_G0(x)            (HEADSET_SHA256_ROTR(x, 7) ^ HEADSET_SHA256_ROTR(x, 18) ^ ((x) >> 3))
+#define HEADSET_SHA256_G1(x)            (HEADSET_SHA256_ROTR(x, 17) ^ HEADSET_SHA256_ROTR(x, 19) ^ ((x) >> 10))
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+const uint32_t headset_sha256_iv[8] =
+{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+static const uint32_t headset_sha256_k[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void headset_sha256_block(headset_sha256_t *p_ctx, const uint8_t *p_block);
+
+/*******************************************************************************
+* Global Function Definitions
+*******************************************************************************/
+
+void headset_sha256_init(headset_sha256_t *p_ctx)
+{
+    memcpy((void *) p_ctx->state, (const void *) headset_sha256_iv, sizeof(p_ctx->state));
+    p_ctx->length = 0;
+}
+
+void headset_sha256_update(headset_sha256_t *p_ctx, const uint8_t *p_data, uint32_t len)
+{
+    uint32_t used = (uint32_t) (p_ctx->length % HEADSET_SHA256_BLOCK_LEN);
+    uint32_t n;
+
+    p_ctx->length += len;
+
+    /* Complete the pending block first */
+    if (used != 0)
+    {
+        n = HEADSET_SHA256_BLOCK_LEN - used;
+        if (n > len)
+        {
+            n = len;
+        }
+
+        memcpy((void *) &p_ctx->block[used], (const void *) p_data, n);
+        p_data  += n;
+        len     -= n;
+
+        if ((used + n) < HEADSET_SHA256_BLOCK_LEN)
+        {
+            return;
+        }
+
+        headset_sha256_block(p_ctx, p_ctx->block);
+    }
+
+    while (len >= HEADSET_SHA256_BLOCK_LEN)
+    {
+        headset_sha256_block(p_ctx, p_data);
+        p_data  += HEADSET_SHA256_BLOCK_LEN;
+        len     -= HEADSET_SHA256_BLOCK_LEN;
+    }
+
+    memcpy((void *) p_ctx->block, (const void *) p_data, len);
+}
+
+void headset_sha256_final(headset_sha256_t *p_ctx, uint8_t *p_digest)
+{
+    uint32_t used = (uint32_t) (p_ctx->length % HEADSET_SHA256_BLOCK_LEN);
+    uint64_t bits = p_ctx->length * 8;
+    uint8_t i;
+
+    p_ctx->block[used++] = 0x80;
+
+    if (used > (HEADSET_SHA256_BLOCK_LEN - 8))
+    {
+        memset((void *) &p_ctx->block[used], 0, HEADSET_SHA256_BLOCK_LEN - used);
+        headset_sha256_block(p_ctx, p_ctx->block);
+        used = 0;
+    }
+
+    memset((void *) &p_ctx->block[used], 0, HEADSET_SHA256_BLOCK_LEN - 8 - used);
+
+    for (i = 0; i < 8; i++)
+    {
+        p_ctx->block[HEADSET_SHA256_BLOCK_LEN - 1 - i] = (uint8_t) (bits >> (8 * i));
+    }
+
+    headset_sha256_block(p_ctx, p_ctx->block);
+
+    for (i = 0; i < 8; i++)
+    {
+        p_digest[4 * i]     = (uint8_t) (p_ctx->state[i] >> 24);
+        p_digest[4 * i + 1] = (uint8_t) (p_ctx->state[i] >> 16);
+        p_digest[4 * i + 2] = (uint8_t) (p_ctx->state[i] >> 8);
+        p_digest[4 * i + 3] = (uint8_t) p_ctx->state[i];
+    }
+}
+
+void headset_sha256_rounds(uint32_t *p_state, const uint32_t *p_w, uint8_t first, uint8_t last)
+{
+    uint32_t a = p_state[0], b = p_state[1], c = p_state[2], d = p_state[3];
+    uint32_t e = p_state[4], f = p_state[5], g = p_state[6], h = p_state[7];
+    uint32_t t1, t2;
+    uint8_t i;
+
+    for (i = first; i < last; i++)
+    {
+        t1 = h + HEADSET_SHA256_S1(e) + HEADSET_SHA256_CH(e, f, g) + headset_sha256_k[i] + p_w[i];
+        t2 = HEADSET_SHA256_S0(a) + HEADSET_SHA256_MAJ(a, b, c);
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    p_state[0] = a; p_state[1] = b; p_state[2] = c; p_state[3] = d;
+    p_state[4] = e; p_state[5] = f; p_state[6] = g; p_state[7] = h;
+}
+
+void headset_sha256_schedule(uint32_t *p_w)
+{
+    uint8_t i;
+
+    for (i = 16; i < 64; i++)
+    {
+        p_w[i] = HEADSET_SHA256_G1(p_w[i - 2]) + p_w[i - 7] + HEADSET_SHA256_G0(p_w[i - 15]) + p_w[i - 16];
+    }
+}
+
+/*******************************************************************************
+* Static Function Definitions
+*******************************************************************************/
+
+static void headset_sha256_block(headset_sha256_t *p_ctx, const uint8_t *p_block)
+{
+    uint32_t w[64];
+    uint32_t s[8];
+    uint8_t i;
+
+    for (i = 0; i < 16; i++)
+    {
+        w[i] = ((uint32_t) p_block[4 * i] << 24) |
+               ((uint32_t) p_block[4 * i + 1] << 16) |
+               ((uint32_t) p_block[4 * i + 2] << 8) |
+               ((uint32_t) p_block[4 * i + 3]);
+    }
+
+    headset_sha256_schedule(w);
+
+    memcpy((void *) s, (const void *) p_ctx->state, sizeof(s));
+    headset_sha256_rounds(s, w, 0, 64);
+
+    for (i = 0; i < 8; i++)
+    {
+        p_ctx->state[i] += s[i];
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,157 @@
+/******************************************************************************
+* File Name:   headset_sha256.h
+*
+* Description: SHA-256 used by the Fast Pair filter and the OTA delta image check.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#if !defined(HEADSET_SHA256_H)
+#define HEADSET_SHA256_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include <stdint.h>
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#define HEADSET_SHA256_BLOCK_LEN    64
+#define HEADSET_SHA256_DIGEST_LEN   32
+
+/*******************************************************************************
+*        Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t    state[8];
+    uint64_t    length;                             /* Message length in bytes */
+    uint8_t     block[HEADSET_SHA256_BLOCK_LEN];    /* Pending partial block */
+} headset_sha256_t;
+
+/*******************************************************************************
+*        External Variable Declarations
+*******************************************************************************/
+/* Initial hash value */
+extern const uint32_t headset_sha256_iv[8];
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: headset_sha256_init
+********************************************************************************
+* Summary:
+*   Start a new digest.
+*
+* Parameters:
+*   p_ctx       : context
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_sha256_init(headset_sha256_t *p_ctx);
+
+/*******************************************************************************
+* Function Name: headset_sha256_update
+********************************************************************************
+* Summary:
+*   Add data to the digest.
+*
+* Parameters:
+*   p_ctx       : context
+*   p_data      : data
+*   len         : data length in bytes
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_sha256_update(headset_sha256_t *p_ctx, const uint8_t *p_data, uint32_t len);
+
+/*******************************************************************************
+* Function Name: headset_sha256_final
+********************************************************************************
+* Summary:
+*   Finish the digest.
+*
+* Parameters:
+*   p_ctx       : context
+*   p_digest    : output, HEADSET_SHA256_DIGEST_LEN bytes
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_sha256_final(headset_sha256_t *p_ctx, uint8_t *p_digest);
+
+/*******************************************************************************
+* Function Name: headset_sha256_rounds
+********************************************************************************
+* Summary:
+*   Run compression rounds first to last - 1 on the working variables a - h. Lets callers
+*   that hash many messages with a common prefix keep the state after the shared rounds.
+*
+* Parameters:
+*   p_state     : working variables a - h
+*   p_w         : message schedule, valid up to round last - 1
+*   first       : first round
+*   last        : round to stop before (at most 64)
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_sha256_rounds(uint32_t *p_state, const uint32_t *p_w, uint8_t first, uint8_t last);
+
+/*******************************************************************************
+* Function Name: headset_sha256_schedule
+********************************************************************************
+* Summary:
+*   Expand message words 0 - 15 into the 64 word schedule.
+*
+* Parameters:
+*   p_w         : 64 words, 0 - 15 set by the caller
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_sha256_schedule(uint32_t *p_w);
+
+#endif /* HEADSET_SHA256_H */
+/* [] END OF FILE */
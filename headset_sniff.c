@@ -0,0 +1,302 @@
+/******************************************************************************
+* File Name:   headset_sniff.c
+*
+* Description: Sniff and sniff subrating policy for idle BR/EDR links.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+/*******************************************************************************
+* Header Files
+*******************************************************************************/
+#include <string.h>
+
+#include "headset_sniff.h"
+#include "wiced_bt_trace.h"
+#include "wiced_timer.h"
+
+/*******************************************************************************
+* Structures
+********************************************************************************/
+typedef struct
+{
+    wiced_bool_t                in_use;
+    wiced_bt_device_address_t   bd_addr;
+    wiced_bool_t                busy;
+    wiced_bool_t                sniff;          /* Link in sniff or subrated sniff mode */
+    wiced_bool_t                requested;      /* Sniff mode requested, waiting for the status */
+    wiced_timer_t               idle_timer;
+} headset_sniff_link_t;
+
+typedef struct
+{
+    wiced_bool_t            allowed;
+    headset_sniff_link_t    link[HEADSET_SNIFF_MAX_LINKS];
+} headset_sniff_cb_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static headset_sniff_cb_t headset_sniff_cb = {0};
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static headset_sniff_link_t *headset_sniff_link_find(wiced_bt_device_address_t bd_addr);
+static void                  headset_sniff_idle_timeout(WICED_TIMER_PARAM_TYPE arg);
+static void                  headset_sniff_link_update(headset_sniff_link_t *p_link);
+
+/*******************************************************************************
+* Global Function Definitions
+*******************************************************************************/
+
+void headset_sniff_init(void)
+{
+    uint8_t i;
+
+    memset((void *) &headset_sniff_cb, 0, sizeof(headset_sniff_cb));
+
+    for (i = 0; i < HEADSET_SNIFF_MAX_LINKS; i++)
+    {
+        wiced_init_timer(&headset_sniff_cb.link[i].idle_timer,
+                         headset_sniff_idle_timeout,
+                         (WICED_TIMER_PARAM_TYPE) i,
+                         WICED_MILLI_SECONDS_TIMER);
+    }
+}
+
+void headset_sniff_link_set(wiced_bt_device_address_t bd_addr, wiced_bool_t connected)
+{
+    headset_sniff_link_t *p_link = headset_sniff_link_find(bd_addr);
+    uint8_t i;
+
+    if (!connected)
+    {
+        if (p_link != NULL)
+        {
+            wiced_stop_timer(&p_link->idle_timer);
+            p_link->in_use = WICED_FALSE;
+        }
+        return;
+    }
+
+    if (p_link != NULL)
+    {
+        return;
+    }
+
+    for (i = 0; i < HEADSET_SNIFF_MAX_LINKS; i++)
+    {
+        p_link = &headset_sniff_cb.link[i];
+
+        if (!p_link->in_use)
+        {
+            p_link->in_use      = WICED_TRUE;
+            p_link->busy        = WICED_FALSE;
+            p_link->sniff       = WICED_FALSE;
+            p_link->requested   = WICED_FALSE;
+            memcpy((void *) p_link->bd_addr, (void *) bd_addr, sizeof(wiced_bt_device_address_t));
+
+            headset_sniff_link_update(p_link);
+            return;
+        }
+    }
+}
+
+void headset_sniff_busy_set(wiced_bt_device_address_t bd_addr, wiced_bool_t busy)
+{
+    headset_sniff_link_t *p_link = headset_sniff_link_find(bd_addr);
+
+    if ((p_link == NULL) || (p_link->busy == busy))
+    {
+        return;
+    }
+
+    p_link->busy = busy;
+    headset_sniff_link_update(p_link);
+}
+
+void headset_sniff_allowed_set(wiced_bool_t allowed)
+{
+    uint8_t i;
+
+    if (headset_sniff_cb.allowed == allowed)
+    {
+        return;
+    }
+
+    headset_sniff_cb.allowed = allowed;
+
+    for (i = 0; i < HEADSET_SNIFF_MAX_LINKS; i++)
+    {
+        if (headset_sniff_cb.link[i].in_use)
+        {
+            headset_sniff_link_update(&headset_sniff_cb.link[i]);
+        }
+    }
+}
+
+void headset_sniff_wake(void)
+{
+    headset_sniff_link_t *p_link;
+    uint8_t i;
+
+    for (i = 0; i < HEADSET_SNIFF_MAX_LINKS; i++)
+    {
+        p_link = &headset_sniff_cb.link[i];
+
+        if (!p_link->in_use)
+        {
+            continue;
+        }
+
+        if (p_link->sniff || p_link->requested)
+        {
+            wiced_bt_dev_cancel_sniff_mode(p_link->bd_addr);
+            p_link->requested = WICED_FALSE;
+        }
+
+        /* Give the follow-up traffic (AVRC command, call setup) time before sniffing again. */
+        headset_sniff_link_update(p_link);
+    }
+}
+
+void headset_sniff_mode_change(wiced_bt_device_address_t bd_addr, uint8_t status)
+{
+    headset_sniff_link_t *p_link = headset_sniff_link_find(bd_addr);
+
+    if (p_link == NULL)
+    {
+        return;
+    }
+
+    switch (status)
+    {
+    case BTM_PM_STS_SNIFF:
+        p_link->sniff       = WICED_TRUE;
+        p_link->requested   = WICED_FALSE;
+
+        /* Subrating lets the idle link skip sniff anchors when both sides have nothing to send. */
+        wiced_bt_dev_set_sniff_subrating(p_link->bd_addr,
+                                         HEADSET_SNIFF_SSR_MAX_LATENCY,
+                                         HEADSET_SNIFF_SSR_MIN_REMOTE_TIMEOUT,
+                                         HEADSET_SNIFF_SSR_MIN_LOCAL_TIMEOUT);
+        break;
+
+    case BTM_PM_STS_SSR:
+        p_link->sniff       = WICED_TRUE;
+        p_link->requested   = WICED_FALSE;
+        break;
+
+    case BTM_PM_STS_ACTIVE:
+        p_link->sniff       = WICED_FALSE;
+        p_link->requested   = WICED_FALSE;
+
+        /* Left sniff because of traffic or the peer, try again once idle. */
+        headset_sniff_link_update(p_link);
+        break;
+
+    case BTM_PM_STS_ERROR:
+        p_link->requested   = WICED_FALSE;
+        break;
+
+    default:
+        break;
+    }
+}
+
+/*******************************************************************************
+* Static Function Definitions
+*******************************************************************************/
+
+static headset_sniff_link_t *headset_sniff_link_find(wiced_bt_device_address_t bd_addr)
+{
+    uint8_t i;
+
+    for (i = 0; i < HEADSET_SNIFF_MAX_LINKS; i++)
+    {
+        if (headset_sniff_cb.link[i].in_use &&
+            (memcmp((void *) headset_sniff_cb.link[i].bd_addr, (void *) bd_addr, sizeof(wiced_bt_device_address_t)) == 0))
+        {
+            return &headset_sniff_cb.link[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void headset_sniff_idle_timeout(WICED_TIMER_PARAM_TYPE arg)
+{
+    headset_sniff_link_t *p_link = &headset_sniff_cb.link[(uint32_t) arg];
+
+    if (!p_link->in_use || p_link->busy || !headset_sniff_cb.allowed || p_link->sniff || p_link->requested)
+    {
+        return;
+    }
+
+    if (wiced_bt_dev_set_sniff_mode(p_link->bd_addr,
+                                    HEADSET_SNIFF_MIN_PERIOD,
+                                    HEADSET_SNIFF_MAX_PERIOD,
+                                    HEADSET_SNIFF_ATTEMPT,
+                                    HEADSET_SNIFF_TIMEOUT) == WICED_BT_PENDING)
+    {
+        p_link->requested = WICED_TRUE;
+    }
+}
+
+/*
+ * An idle link enters sniff after HEADSET_SNIFF_IDLE_TIMEOUT, a busy one leaves it at once.
+ */
+static void headset_sniff_link_update(headset_sniff_link_t *p_link)
+{
+    if (p_link->busy || !headset_sniff_cb.allowed)
+    {
+        wiced_stop_timer(&p_link->idle_timer);
+
+        if (p_link->sniff || p_link->requested)
+        {
+            wiced_bt_dev_cancel_sniff_mode(p_link->bd_addr);
+            p_link->requested = WICED_FALSE;
+        }
+        return;
+    }
+
+    if (!p_link->sniff && !p_link->requested)
+    {
+        wiced_start_timer(&p_link->idle_timer, HEADSET_SNIFF_IDLE_TIMEOUT);
+    }
+}
+
+/* [] END OF FILE */
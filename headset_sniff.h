@@ -0,0 +1,176 @@
+/******************************************************************************
+* File Name:   headset_sniff.h
+*
+* Description: Sniff and sniff subrating policy for idle BR/EDR links.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+#if !defined(HEADSET_SNIFF_H)
+#define HEADSET_SNIFF_H
+
+/*******************************************************************************
+*        Header Files
+*******************************************************************************/
+#include "wiced_bt_dev.h"
+
+/*******************************************************************************
+*        Macro Definitions
+*******************************************************************************/
+#ifndef BT_HS_SPK_CONTROL_BR_EDR_MAX_CONNECTIONS
+#define BT_HS_SPK_CONTROL_BR_EDR_MAX_CONNECTIONS    1
+#endif
+
+/* Maximum number of tracked BR/EDR links, one per source the library accepts */
+#define HEADSET_SNIFF_MAX_LINKS                 BT_HS_SPK_CONTROL_BR_EDR_MAX_CONNECTIONS
+
+/* Time a link shall stay idle (no A2DP stream) before entering sniff mode */
+#ifndef HEADSET_SNIFF_IDLE_TIMEOUT
+#define HEADSET_SNIFF_IDLE_TIMEOUT              2000    /* ms */
+#endif
+
+/* Sniff parameters, in slots (0.625 ms) */
+#define HEADSET_SNIFF_MIN_PERIOD                640     /* 400 ms */
+#define HEADSET_SNIFF_MAX_PERIOD                800     /* 500 ms */
+#define HEADSET_SNIFF_ATTEMPT                   4
+#define HEADSET_SNIFF_TIMEOUT                   1
+
+/* Sniff subrating parameters, in slots */
+#define HEADSET_SNIFF_SSR_MAX_LATENCY           2400    /* 1.5 s, every third sniff anchor when idle */
+#define HEADSET_SNIFF_SSR_MIN_REMOTE_TIMEOUT    0
+#define HEADSET_SNIFF_SSR_MIN_LOCAL_TIMEOUT     0
+
+/*******************************************************************************
+*        External Variable Declarations
+*******************************************************************************/
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: headset_sniff_init
+********************************************************************************
+* Summary:
+*   Initialize the sniff policy.
+*
+* Parameters:
+*   void
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_sniff_init(void);
+
+/*******************************************************************************
+* Function Name: headset_sniff_link_set
+********************************************************************************
+* Summary:
+*   Track a BR/EDR link.
+*
+* Parameters:
+*   bd_addr     : peer address
+*   connected   : WICED_TRUE when the link is up
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_sniff_link_set(wiced_bt_device_address_t bd_addr, wiced_bool_t connected);
+
+/*******************************************************************************
+* Function Name: headset_sniff_busy_set
+********************************************************************************
+* Summary:
+*   Report whether a link carries an A2DP stream.
+*
+* Parameters:
+*   bd_addr : peer address
+*   busy    : WICED_TRUE while streaming
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_sniff_busy_set(wiced_bt_device_address_t bd_addr, wiced_bool_t busy);
+
+/*******************************************************************************
+* Function Name: headset_sniff_allowed_set
+********************************************************************************
+* Summary:
+*   Allow or forbid sniff mode on all links (e.g. forbidden during a call).
+*
+* Parameters:
+*   allowed : WICED_TRUE to allow
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_sniff_allowed_set(wiced_bool_t allowed);
+
+/*******************************************************************************
+* Function Name: headset_sniff_wake
+********************************************************************************
+* Summary:
+*   Leave sniff mode on all links now (button press, incoming call) and restart the idle timers.
+*
+* Parameters:
+*   void
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_sniff_wake(void);
+
+/*******************************************************************************
+* Function Name: headset_sniff_mode_change
+********************************************************************************
+* Summary:
+*   Handle BTM_POWER_MANAGEMENT_STATUS_EVT.
+*
+* Parameters:
+*   bd_addr : peer address
+*   status  : BTM_PM_STS_xxx
+*
+* Return:
+*   void
+*
+*******************************************************************************/
+void headset_sniff_mode_change(wiced_bt_device_address_t bd_addr, uint8_t status);
+
+#endif /* HEADSET_SNIFF_H */
+/* [] END OF FILE */
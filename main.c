@@ -185,7 +185,11 @@ int main(void)
     WICED_BT_TRACE( "# headset_speaker APP START #\n" );
     WICED_BT_TRACE( "#############################\n" );
 
-    btheadset_control_init();
+    if (btheadset_control_init() != WICED_BT_SUCCESS)
+    {
+        WICED_BT_TRACE("btheadset_control_init failed\n");
+        CY_ASSERT(0);
+    }
 
     return 0;
 }
@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+#
+# Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+#
+# This software, including source code, documentation and related materials
+# ("Software") is owned by Cypress Semiconductor Corporation or one of its
+# affiliates ("Cypress") and is protected by and subject to worldwide patent
+# protection (United States and foreign), United States copyright laws and
+# international treaty provisions. Therefore, you may use this Software only
+# as provided in the license agreement accompanying the software package from
+# which you obtained this Software ("EULA").
+#
+"""Replay a button trace timeline and rebuild its latency histograms.
+
+The input is a device log with the timeline lines traced by
+headset_button_trace_report() ("headset_button_trace: t ... button ... event
+... <stage>"); other lines are ignored. The histogram math follows
+headset_button_trace.c, so the result can be checked against the histograms
+traced by the device, or computed for logs cut from several sessions.
+
+usage: button_trace.py <log>
+"""
+
+import re
+import sys
+
+HIST_BUCKETS = 16
+HIST_SHIFT = 4
+STAGES = ("gpio", "event", "dispatch", "action")
+
+LINE = re.compile(r"headset_button_trace: t (-?\d+) button (\d+) event (\d+) (\w+)")
+
+
+def bucket(latency_us):
+    value = latency_us >> (HIST_SHIFT + 1)
+    index = 0
+    while value and index < HIST_BUCKETS - 1:
+        value >>= 1
+        index += 1
+    return index
+
+
+class Hist:
+    def __init__(self):
+        self.latencies = []
+        self.buckets = [0] * HIST_BUCKETS
+
+    def add(self, latency_us):
+        self.latencies.append(latency_us)
+        self.buckets[bucket(latency_us)] += 1
+
+
+def replay(lines):
+    """Return {stage: Hist} for the stages after "gpio"."""
+    hists = {stage: Hist() for stage in STAGES[1:]}
+    start_us = {}
+    last_stage = {}
+
+    for line in lines:
+        match = LINE.search(line)
+        if not match or match.group(4) not in STAGES:
+            continue
+        time_us = int(match.group(1)) & 0xffffffff
+        button = int(match.group(2))
+        stage = match.group(4)
+
+        # An event without a GPIO edge just before it starts at its "event" stamp.
+        if stage == "gpio" or (stage == "event" and last_stage.get(button) != "gpio"):
+            start_us[button] = time_us
+        elif button in start_us:
+            # Same unsigned 32-bit difference as the device.
+            hists[stage].add((time_us - start_us[button]) & 0xffffffff)
+        last_stage[button] = stage
+
+    return hists
+
+
+def main(argv):
+    if len(argv) != 2:
+        sys.stderr.write(__doc__)
+        return 1
+
+    with open(argv[1], errors="replace") as log:
+        hists = replay(log)
+
+    for stage in STAGES[1:]:
+        hist = hists[stage]
+        if not hist.latencies:
+            continue
+        count = len(hist.latencies)
+        print("%s n %d min %d avg %d max %d us" % (stage, count, min(hist.latencies),
+                                                  sum(hist.latencies) // count,
+                                                  max(hist.latencies)))
+        for index, hits in enumerate(hist.buckets):
+            if not hits:
+                continue
+            if index < HIST_BUCKETS - 1:
+                print("  < %d us: %d" % (1 << (index + HIST_SHIFT + 1), hits))
+            else:
+                print(" >= %d us: %d" % (1 << (index + HIST_SHIFT), hits))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+#
+# Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+#
+# This software, including source code, documentation and related materials
+# ("Software") is owned by Cypress Semiconductor Corporation or one of its
+# affiliates ("Cypress") and is protected by and subject to worldwide patent
+# protection (United States and foreign), United States copyright laws and
+# international treaty provisions. Therefore, you may use this Software only
+# as provided in the license agreement accompanying the software package from
+# which you obtained this Software ("EULA").
+#
+"""Build an OTA delta between two firmware images.
+
+The output is consumed by headset_ota_delta.c; see headset_ota_delta.h for the
+stream layout.
+
+usage: ota_delta.py <running image> <new image> <delta>
+"""
+
+import hashlib
+import struct
+import sys
+
+VERSION = 1
+OP_COPY = 0
+OP_INSERT = 1
+
+# Shortest match worth a COPY op (op + offset varints cost up to ~8 bytes)
+MIN_MATCH = 12
+# Candidate source positions kept per key
+MAX_CANDIDATES = 8
+
+
+def varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7f
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def zigzag(value):
+    return (value << 1) if value >= 0 else ((-value << 1) - 1)
+
+
+def match_len(source, s, target, t):
+    n = 0
+    limit = min(len(source) - s, len(target) - t)
+    while n < limit and source[s + n] == target[t + n]:
+        n += 1
+    return n
+
+
+def build_index(source):
+    index = {}
+    for pos in range(len(source) - MIN_MATCH + 1):
+        positions = index.setdefault(source[pos:pos + MIN_MATCH], [])
+        if len(positions) < MAX_CANDIDATES:
+            positions.append(pos)
+    return index
+
+
+def diff(source, target):
+    index = build_index(source)
+    ops = bytearray()
+    literal = bytearray()
+    src_pos = 0
+    t = 0
+
+    def flush_literal():
+        if literal:
+            ops.extend(varint((len(literal) << 1) | OP_INSERT))
+            ops.extend(literal)
+            literal.clear()
+
+    while t < len(target):
+        # Prefer continuing where the last copy ended, code moves in blocks.
+        best_pos, best_len = src_pos, match_len(source, src_pos, target, t) if src_pos < len(source) else 0
+        for pos in index.get(bytes(target[t:t + MIN_MATCH]), ()):
+            n = match_len(source, pos, target, t)
+            if n > best_len:
+                best_pos, best_len = pos, n
+
+        if best_len >= MIN_MATCH:
+            flush_literal()
+            ops.extend(varint((best_len << 1) | OP_COPY))
+            ops.extend(varint(zigzag(best_pos - src_pos)))
+            src_pos = best_pos + best_len
+            t += best_len
+        else:
+            literal.append(target[t])
+            t += 1
+
+    flush_literal()
+    return bytes(ops)
+
+
+def build(source, target):
+    header = b"HDLT" + struct.pack("<B3xII", VERSION, len(source), len(target))
+    header += hashlib.sha256(source).digest() + hashlib.sha256(target).digest()
+    return header + diff(source, target)
+
+
+def main(argv):
+    if len(argv) != 4:
+        sys.stderr.write(__doc__)
+        return 1
+
+    with open(argv[1], "rb") as f:
+        source = f.read()
+    with open(argv[2], "rb") as f:
+        target = f.read()
+
+    delta = build(source, target)
+
+    with open(argv[3], "wb") as f:
+        f.write(delta)
+
+    print("image %d bytes, delta %d bytes (%.1f%%)" % (len(target), len(delta),
+                                                     100.0 * len(delta) / max(len(target), 1)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
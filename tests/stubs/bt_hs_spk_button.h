@@ -0,0 +1,46 @@
+/* Host stub: bt_hs_spk button interface */
+#pragma once
+#include "wiced_button_manager.h"
+#include "wiced_platform.h"
+
+typedef enum
+{
+    NO_ACTION,
+    ACTION_PAUSE_PLAY,
+    ACTION_BT_DISCOVERABLE,
+    ACTION_VOLUME_UP,
+    ACTION_VOLUME_DOWN,
+    ACTION_FORWARD,
+    ACTION_BACKWARD,
+    ACTION_VOICE_RECOGNITION,
+    ACTION_TRANSPORT_DETECT_ON,
+    ACTION_MULTI_FUNCTION_LONG_RELEASE,
+} app_service_action_t;
+
+typedef struct
+{
+    app_service_action_t            action;
+    platform_button_t               button;
+    button_manager_event_t          event;
+    button_manager_button_state_t   state;
+    uint32_t                        repeat;
+} bt_hs_spk_button_action_t;
+
+typedef wiced_bool_t (*bt_hs_spk_button_pre_handler_t)(platform_button_t button, button_manager_event_t event,
+                                                       button_manager_button_state_t state, uint32_t repeat);
+
+typedef struct
+{
+    button_manager_t                        *p_manager;
+    wiced_button_manager_configuration_t    *p_configuration;
+    button_manager_button_t                 *p_app_buttons;
+    uint32_t                                number_of_buttons;
+    bt_hs_spk_button_pre_handler_t          p_pre_handler;
+    struct
+    {
+        bt_hs_spk_button_action_t           *p_action;
+        uint32_t                            number_of_actions;
+    } button_action_config;
+} bt_hs_spk_button_config_t;
+
+wiced_result_t bt_hs_spk_init_button_interface(bt_hs_spk_button_config_t *p_config);
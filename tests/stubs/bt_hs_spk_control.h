@@ -0,0 +1,12 @@
+/* Host stub: headset library calls of headset_control_le.c */
+#pragma once
+#include "wiced_bt_a2dp_sink.h"
+#include "wiced_bt_dev.h"
+
+#ifndef MIN
+#define MIN(a, b)                   (((a) < (b)) ? (a) : (b))
+#endif
+
+typedef void (bt_hs_spk_ble_discoverability_change_cb_t)(wiced_bool_t discoverable);
+
+void bt_hs_spk_ble_discoverability_change_callback_register(bt_hs_spk_ble_discoverability_change_cb_t *p_cb);
@@ -0,0 +1,14 @@
+/* Host stub: bt_hs_spk handsfree calls the button code makes, the handsfree SDP record values */
+#pragma once
+#include "bt_hs_spk_control.h"
+#include "wiced_result.h"
+
+#define WICED_HANDSFREE_SCN                         0x01
+#define WICED_HANDSFREE_HDLR_UNIT                   0x10004
+
+#define WICED_BT_HFP_HF_SDP_FEATURE_3WAY_CALLING    0x0002
+#define WICED_BT_HFP_HF_SDP_FEATURE_CLIP            0x0004
+#define WICED_BT_HFP_HF_SDP_FEATURE_REMOTE_VOL_CTRL 0x0010
+#define WICED_BT_HFP_HF_SDP_FEATURE_WIDEBAND_SPEECH 0x0020
+
+wiced_bool_t bt_hs_spk_handsfree_call_session_check(void);
@@ -0,0 +1,4 @@
+/* Host stub: simulated clock of stub.c */
+#pragma once
+#include <stdint.h>
+uint64_t clock_SystemTimeMicroseconds64(void);
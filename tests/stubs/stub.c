@@ -0,0 +1,242 @@
+/*
+ * Host implementation of the stubbed SDK services: simulated clock and timers, traces.
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "clock_timer.h"
+#include "wiced_bt_trace.h"
+#include "wiced_timer.h"
+#include "../test.h"
+
+#define STUB_TIMER_MAX  32
+
+static uint64_t         stub_now_us;
+static wiced_timer_t    *stub_timers[STUB_TIMER_MAX];
+static int              stub_timer_num;
+
+/* Set by a test to capture the traces */
+void (*stub_trace_hook)(const char *p_line);
+
+/*
+ * printf subset of WICED_BT_TRACE, including %B (Bluetooth device address)
+ */
+static void stub_trace_format(char *p_line, size_t size, const char *p_fmt, va_list ap)
+{
+    char spec[16];
+    size_t len = 0;
+    size_t spec_len;
+    const uint8_t *p_addr;
+    int longs;
+
+    p_line[0] = '\0';
+
+    while ((*p_fmt != '\0') && (len + 1 < size))
+    {
+        if (*p_fmt != '%')
+        {
+            p_line[len++] = *p_fmt++;
+            p_line[len]   = '\0';
+            continue;
+        }
+
+        /* Collect the conversion specification */
+        spec_len    = 0;
+        longs       = 0;
+        do
+        {
+            spec[spec_len++] = *p_fmt++;
+            longs += (p_fmt[-1] == 'l');
+        } while ((*p_fmt != '\0') && (strchr("diouxXcspB%", *p_fmt) == NULL) && (spec_len < sizeof(spec) - 2));
+        spec[spec_len++]    = *p_fmt;
+        spec[spec_len]      = '\0';
+
+        switch (*p_fmt)
+        {
+        case 'B':
+            p_addr = va_arg(ap, const uint8_t *);
+            len += snprintf(&p_line[len], size - len, "%02x:%02x:%02x:%02x:%02x:%02x",
+                            p_addr[0], p_addr[1], p_addr[2], p_addr[3], p_addr[4], p_addr[5]);
+            break;
+        case 's':
+        case 'p':
+            len += snprintf(&p_line[len], size - len, spec, va_arg(ap, void *));
+            break;
+        case '%':
+            len += snprintf(&p_line[len], size - len, "%%");
+            break;
+        case '\0':
+            return;
+        default:
+            if (longs >= 2)
+            {
+                len += snprintf(&p_line[len], size - len, spec, va_arg(ap, long long));
+            }
+            else if (longs == 1)
+            {
+                len += snprintf(&p_line[len], size - len, spec, va_arg(ap, long));
+            }
+            else
+            {
+                len += snprintf(&p_line[len], size - len, spec, va_arg(ap, int));
+            }
+            break;
+        }
+
+        p_fmt++;
+        if (len >= size)
+        {
+            return;
+        }
+    }
+}
+
+void stub_trace(const char *p_fmt, ...)
+{
+    static int verbose = -1;
+    char line[512];
+    va_list ap;
+
+    va_start(ap, p_fmt);
+    stub_trace_format(line, sizeof(line), p_fmt, ap);
+    va_end(ap);
+
+    if (verbose < 0)
+    {
+        verbose = (getenv("VERBOSE") != NULL) && (getenv("VERBOSE")[0] == '1');
+    }
+
+    if (stub_trace_hook != NULL)
+    {
+        stub_trace_hook(line);
+    }
+
+    if (verbose)
+    {
+        printf("    | %s", line);
+    }
+}
+
+uint64_t clock_SystemTimeMicroseconds64(void)
+{
+    return stub_now_us;
+}
+
+uint64_t stub_time_us(void)
+{
+    return stub_now_us;
+}
+
+wiced_result_t wiced_init_timer(wiced_timer_t *p_timer, wiced_timer_callback_t *p_cb, WICED_TIMER_PARAM_TYPE arg, int type)
+{
+    int i;
+
+    p_timer->p_cb   = p_cb;
+    p_timer->arg    = arg;
+    p_timer->type   = type;
+    p_timer->armed  = 0;
+
+    for (i = 0; i < stub_timer_num; i++)
+    {
+        if (stub_timers[i] == p_timer)
+        {
+            return WICED_SUCCESS;
+        }
+    }
+
+    if (stub_timer_num == STUB_TIMER_MAX)
+    {
+        return WICED_ERROR;
+    }
+
+    stub_timers[stub_timer_num++] = p_timer;
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_start_timer(wiced_timer_t *p_timer, uint32_t timeout)
+{
+    p_timer->armed  = 1;
+    p_timer->due_us = stub_now_us + (uint64_t) timeout * (p_timer->type == WICED_SECONDS_TIMER ? 1000000 : 1000);
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_stop_timer(wiced_timer_t *p_timer)
+{
+    p_timer->armed = 0;
+
+    return WICED_SUCCESS;
+}
+
+wiced_bool_t wiced_is_timer_in_use(wiced_timer_t *p_timer)
+{
+    return p_timer->armed ? WICED_TRUE : WICED_FALSE;
+}
+
+wiced_result_t wiced_deinit_timer(wiced_timer_t *p_timer)
+{
+    p_timer->armed = 0;
+
+    return WICED_SUCCESS;
+}
+
+void stub_time_advance_us(uint64_t us)
+{
+    uint64_t end = stub_now_us + us;
+    wiced_timer_t *p_next;
+    int i;
+
+    for (;;)
+    {
+        /* Earliest armed timer due by the end of the step */
+        p_next = NULL;
+        for (i = 0; i < stub_timer_num; i++)
+        {
+            if (stub_timers[i]->armed && (stub_timers[i]->due_us <= end) &&
+                ((p_next == NULL) || (stub_timers[i]->due_us < p_next->due_us)))
+            {
+                p_next = stub_timers[i];
+            }
+        }
+
+        if (p_next == NULL)
+        {
+            break;
+        }
+
+        if (p_next->due_us > stub_now_us)
+        {
+            stub_now_us = p_next->due_us;
+        }
+
+        p_next->armed = 0;
+        p_next->p_cb(p_next->arg);
+    }
+
+    stub_now_us = end;
+}
+
+void stub_time_advance_ms(uint32_t ms)
+{
+    stub_time_advance_us((uint64_t) ms * 1000);
+}
+
+void stub_reset(void)
+{
+    stub_now_us         = 0;
+    stub_timer_num      = 0;
+    stub_trace_hook     = NULL;
+}
+
+uint64_t test_clock_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
@@ -0,0 +1,4 @@
+/* Host stub */
+#pragma once
+#include "wiced_result.h"
+#include "wiced_bt_trace.h"
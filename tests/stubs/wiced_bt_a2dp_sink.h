@@ -0,0 +1,131 @@
+/* Host stub: A2DP sink events and configuration */
+#pragma once
+#include "wiced_bt_dev.h"
+
+typedef enum
+{
+    WICED_BT_A2DP_SINK_CONNECT_EVT,
+    WICED_BT_A2DP_SINK_DISCONNECT_EVT,
+    WICED_BT_A2DP_SINK_START_IND_EVT,
+    WICED_BT_A2DP_SINK_START_CFM_EVT,
+    WICED_BT_A2DP_SINK_SUSPEND_EVT,
+    WICED_BT_A2DP_SINK_CODEC_CONFIG_EVT,
+} wiced_bt_a2dp_sink_event_t;
+
+typedef union
+{
+    struct
+    {
+        wiced_result_t              result;
+        uint16_t                    handle;
+        wiced_bt_device_address_t   bd_addr;
+    } connect;
+    struct
+    {
+        uint16_t                    handle;
+    } disconnect, start_ind, start_cfm, suspend, codec_config;
+} wiced_bt_a2dp_sink_event_data_t;
+
+/* Codec capabilities */
+#define A2D_SBC_IE_SAMP_FREQ_16     0x80
+#define A2D_SBC_IE_SAMP_FREQ_32     0x40
+#define A2D_SBC_IE_SAMP_FREQ_44     0x20
+#define A2D_SBC_IE_SAMP_FREQ_48     0x10
+#define A2D_SBC_IE_CH_MD_MONO       0x08
+#define A2D_SBC_IE_CH_MD_DUAL       0x04
+#define A2D_SBC_IE_CH_MD_STEREO     0x02
+#define A2D_SBC_IE_CH_MD_JOINT      0x01
+#define A2D_SBC_IE_BLOCKS_4         0x80
+#define A2D_SBC_IE_BLOCKS_8         0x40
+#define A2D_SBC_IE_BLOCKS_12        0x20
+#define A2D_SBC_IE_BLOCKS_16        0x10
+#define A2D_SBC_IE_SUBBAND_4        0x08
+#define A2D_SBC_IE_SUBBAND_8        0x04
+#define A2D_SBC_IE_ALLOC_MD_S       0x02
+#define A2D_SBC_IE_ALLOC_MD_L       0x01
+#define A2D_SBC_IE_MIN_BITPOOL      2
+#define A2D_SBC_IE_MAX_BITPOOL      250
+
+#define A2D_M24_IE_OBJ_MSK          0xF0
+#define A2D_M24_IE_SAMP_FREQ_44     0x0100
+#define A2D_M24_IE_SAMP_FREQ_48     0x0080
+#define A2D_M24_IE_CHNL_MSK         0x0C
+#define A2D_M24_IE_VBR_MSK          0x80
+#define A2D_M24_IE_BITRATE_MSK      0x7FFFFF
+
+typedef enum
+{
+    WICED_BT_A2DP_CODEC_SBC,
+    WICED_BT_A2DP_CODEC_M24,
+} wiced_bt_a2dp_codec_t;
+
+typedef struct
+{
+    uint8_t     samp_freq;
+    uint8_t     ch_mode;
+    uint8_t     block_len;
+    uint8_t     num_subbands;
+    uint8_t     alloc_mthd;
+    uint8_t     max_bitpool;
+    uint8_t     min_bitpool;
+} wiced_bt_a2d_sbc_cie_t;
+
+typedef struct
+{
+    uint8_t     obj_type;
+    uint16_t    samp_freq;
+    uint8_t     chnl;
+    uint8_t     vbr;
+    uint32_t    bitrate;
+} wiced_bt_a2d_m24_cie_t;
+
+typedef struct
+{
+    wiced_bt_a2dp_codec_t       codec_id;
+    union
+    {
+        wiced_bt_a2d_sbc_cie_t  sbc;
+        wiced_bt_a2d_m24_cie_t  m24;
+    } cie;
+} wiced_bt_a2dp_codec_info_t;
+
+/* Configuration */
+#define WICED_BT_A2DP_SINK_FEAT_DELAY_RPT               0x0001
+#define WICED_BT_A2DP_SINK_OVERRUN_CONTROL_FLUSH_DATA   0
+
+typedef enum
+{
+    WICED_AUDIO_CODEC_NONE,
+    WICED_AUDIO_CODEC_AAC_DEC,
+} wiced_audio_codec_index_t;
+
+typedef struct
+{
+    uint16_t    buf_depth_ms;
+    uint8_t     start_buf_depth;
+    uint8_t     target_buf_depth;
+    uint8_t     overrun_control;
+    int16_t     adj_ppm_max;
+    int16_t     adj_ppm_min;
+    int16_t     adj_ppb_per_msec;
+    int16_t     lvl_correction_threshold_high;
+    int16_t     lvl_correction_threshold_low;
+    int16_t     adj_proportional_gain;
+    int16_t     adj_integral_gain;
+} wiced_bt_a2dp_sink_audio_tuning_params_t;
+
+typedef struct
+{
+    uint32_t                                    feature_mask;
+    struct
+    {
+        uint8_t                                 count;
+        wiced_bt_a2dp_codec_info_t              *info;
+    } codec_capabilities;
+    wiced_bt_a2dp_sink_audio_tuning_params_t    p_param;
+    struct
+    {
+        wiced_audio_codec_index_t               codec_id;
+        void                                    *codec_functions;
+    } ext_codec;
+} wiced_bt_a2dp_config_data_t;
@@ -0,0 +1,5 @@
+/* Host stub: AVDTP version of the A2DP sink record */
+#pragma once
+#include "wiced_bt_l2c.h"
+
+#define AVDT_VERSION_1_3            0x0103
@@ -0,0 +1,9 @@
+/* Host stub: AVRCP versions and features of the AVRC records */
+#pragma once
+#include "wiced_bt_l2c.h"
+
+#define AVRC_REV_1_3                0x0103
+#define AVRC_REV_1_5                0x0105
+
+#define AVRC_SUPF_CT_CAT1           0x0001
+#define AVRC_SUPF_TG_CAT2           0x0002
@@ -0,0 +1,2 @@
+/* Host stub: nothing of it is used on the host */
+#pragma once
@@ -0,0 +1,45 @@
+/* Host stub: LE types and the calls the tested modules make */
+#pragma once
+#include "wiced_bt_dev.h"
+
+typedef enum
+{
+    BTM_BLE_ADVERT_OFF,
+    BTM_BLE_ADVERT_DIRECTED_HIGH,
+    BTM_BLE_ADVERT_DIRECTED_LOW,
+    BTM_BLE_ADVERT_UNDIRECTED_HIGH,
+    BTM_BLE_ADVERT_UNDIRECTED_LOW,
+    BTM_BLE_ADVERT_NONCONN_HIGH,
+    BTM_BLE_ADVERT_NONCONN_LOW,
+    BTM_BLE_ADVERT_DISCOVERABLE_HIGH,
+    BTM_BLE_ADVERT_DISCOVERABLE_LOW,
+} wiced_bt_ble_advert_mode_t;
+
+#define BTM_BLE_PREFER_1M_PHY       0x01
+#define BTM_BLE_PREFER_2M_PHY       0x02
+
+typedef struct
+{
+    wiced_bt_device_address_t   remote_bd_addr;
+    uint8_t                     tx_phys;
+    uint8_t                     rx_phys;
+    uint16_t                    phy_opts;
+} wiced_bt_ble_phy_preferences_t;
+
+wiced_result_t wiced_bt_ble_set_phy(wiced_bt_ble_phy_preferences_t *p_phy_preferences);
+
+#define BLE_ADDR_PUBLIC             0x00
+#define BLE_ADDR_RANDOM             0x01
+
+#define BTM_BLE_ADVERT_TYPE_NAME_COMPLETE   0x09
+
+typedef struct
+{
+    uint8_t                     *p_data;
+    uint16_t                    len;
+    uint8_t                     advert_type;
+} wiced_bt_ble_advert_elem_t;
+
+wiced_result_t wiced_bt_start_advertisements(wiced_bt_ble_advert_mode_t advert_mode,
+                                             uint8_t directed_advertisement_bdaddr_type,
+                                             uint8_t *directed_advertisement_bdaddr_ptr);
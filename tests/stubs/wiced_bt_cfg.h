@@ -0,0 +1,154 @@
+/* Host stub: stack configuration types, the fields wiced_app_cfg.c sets */
+#pragma once
+#include "wiced_bt_ble.h"
+#include "wiced_bt_gatt.h"
+#include "wiced_bt_types.h"
+
+#define BTM_BLE_SCAN_MODE_ACTIVE    1
+#define BTM_BLE_ADVERT_CHNL_37      0x01
+#define BTM_BLE_ADVERT_CHNL_38      0x02
+#define BTM_BLE_ADVERT_CHNL_39      0x04
+#define BTM_SEC_BEST_EFFORT         0x0100
+
+#define WICED_BT_CFG_DEFAULT_CONN_MIN_INTERVAL                      24
+#define WICED_BT_CFG_DEFAULT_CONN_MAX_INTERVAL                      40
+#define WICED_BT_CFG_DEFAULT_CONN_LATENCY                           0
+#define WICED_BT_CFG_DEFAULT_CONN_SUPERVISION_TIMEOUT               700
+#define WICED_BT_CFG_DEFAULT_HIGH_DUTY_DIRECTED_ADV_MIN_INTERVAL    400
+#define WICED_BT_CFG_DEFAULT_HIGH_DUTY_DIRECTED_ADV_MAX_INTERVAL    800
+#define WICED_BT_CFG_DEFAULT_LOW_DUTY_DIRECTED_ADV_MIN_INTERVAL     48
+#define WICED_BT_CFG_DEFAULT_LOW_DUTY_DIRECTED_ADV_MAX_INTERVAL     48
+#define WICED_BT_CFG_DEFAULT_HIGH_DUTY_NONCONN_ADV_MIN_INTERVAL     160
+#define WICED_BT_CFG_DEFAULT_HIGH_DUTY_NONCONN_ADV_MAX_INTERVAL     160
+#define WICED_BT_CFG_DEFAULT_LOW_DUTY_NONCONN_ADV_MIN_INTERVAL      2048
+#define WICED_BT_CFG_DEFAULT_LOW_DUTY_NONCONN_ADV_MAX_INTERVAL      2048
+#define WICED_BT_CFG_DEFAULT_RANDOM_ADDRESS_CHANGE_TIMEOUT          900
+#define WICED_BT_CFG_DEFAULT_RANDOM_ADDRESS_NEVER_CHANGE            0
+
+typedef struct
+{
+    uint16_t                max_links;
+    uint16_t                max_ports;
+} wiced_bt_cfg_rfcomm_t;
+
+typedef struct
+{
+    uint16_t                max_links;
+    uint16_t                max_seps;
+} wiced_bt_cfg_avdt_t;
+
+typedef struct
+{
+    uint16_t                max_links;
+} wiced_bt_cfg_avrc_t;
+
+typedef struct
+{
+    uint8_t                 br_max_simultaneous_links;
+    uint16_t                br_max_rx_pdu_size;
+    uint8_t                 device_class[3];
+    wiced_bt_cfg_rfcomm_t   rfcomm_cfg;
+    wiced_bt_cfg_avdt_t     avdt_cfg;
+    wiced_bt_cfg_avrc_t     avrc_cfg;
+} wiced_bt_cfg_br_t;
+
+typedef struct
+{
+    uint8_t                 scan_mode;
+    uint16_t                high_duty_scan_interval;
+    uint16_t                high_duty_scan_window;
+    uint16_t                high_duty_scan_duration;
+    uint16_t                low_duty_scan_interval;
+    uint16_t                low_duty_scan_window;
+    uint16_t                low_duty_scan_duration;
+    uint16_t                high_duty_conn_scan_interval;
+    uint16_t                high_duty_conn_scan_window;
+    uint16_t                high_duty_conn_duration;
+    uint16_t                low_duty_conn_scan_interval;
+    uint16_t                low_duty_conn_scan_window;
+    uint16_t                low_duty_conn_duration;
+    uint16_t                conn_min_interval;
+    uint16_t                conn_max_interval;
+    uint16_t                conn_latency;
+    uint16_t                conn_supervision_timeout;
+} wiced_bt_cfg_ble_scan_settings_t;
+
+typedef struct
+{
+    uint8_t                 channel_map;
+    uint16_t                high_duty_min_interval;
+    uint16_t                high_duty_max_interval;
+    uint16_t                high_duty_duration;
+    uint16_t                low_duty_min_interval;
+    uint16_t                low_duty_max_interval;
+    uint16_t                low_duty_duration;
+    uint16_t                high_duty_directed_min_interval;
+    uint16_t                high_duty_directed_max_interval;
+    uint16_t                low_duty_directed_min_interval;
+    uint16_t                low_duty_directed_max_interval;
+    uint16_t                low_duty_directed_duration;
+    uint16_t                high_duty_nonconn_min_interval;
+    uint16_t                high_duty_nonconn_max_interval;
+    uint16_t                high_duty_nonconn_duration;
+    uint16_t                low_duty_nonconn_min_interval;
+    uint16_t                low_duty_nonconn_max_interval;
+    uint16_t                low_duty_nonconn_duration;
+} wiced_bt_cfg_ble_advert_settings_t;
+
+typedef struct
+{
+    uint8_t                                     ble_max_simultaneous_links;
+    uint16_t                                    ble_max_rx_pdu_size;
+    uint16_t                                    appearance;
+    uint16_t                                    rpa_refresh_timeout;
+    uint8_t                                     host_addr_resolution_db_size;
+    const wiced_bt_cfg_ble_scan_settings_t      *p_ble_scan_cfg;
+    const wiced_bt_cfg_ble_advert_settings_t    *p_ble_advert_cfg;
+    int8_t                                      default_ble_power_level;
+} wiced_bt_cfg_ble_t;
+
+typedef struct
+{
+    uint8_t                 max_db_service_modules;
+    uint8_t                 max_eatt_bearers;
+} wiced_bt_cfg_gatt_t;
+
+typedef struct
+{
+    uint8_t                 max_cis_conn;
+    uint8_t                 max_cig_count;
+    uint16_t                max_sdu_size;
+    uint8_t                 channel_count;
+    uint8_t                 max_buffers_per_cis;
+} wiced_bt_cfg_isoc_t;
+
+typedef struct
+{
+    uint8_t                 max_app_l2cap_psms;
+    uint8_t                 max_app_l2cap_channels;
+    uint8_t                 max_app_l2cap_br_edr_ertm_chnls;
+    uint8_t                 max_app_l2cap_br_edr_ertm_tx_win;
+    uint8_t                 max_app_l2cap_le_fixed_channels;
+} wiced_bt_cfg_l2cap_application_t;
+
+typedef struct
+{
+    uint8_t                                 *device_name;
+    uint16_t                                security_required;
+    const wiced_bt_cfg_br_t                 *p_br_cfg;
+    const wiced_bt_cfg_ble_t                *p_ble_cfg;
+    const wiced_bt_cfg_gatt_t               *p_gatt_cfg;
+    const wiced_bt_cfg_isoc_t               *p_isoc_cfg;
+    const wiced_bt_cfg_l2cap_application_t  *p_l2cap_app_cfg;
+} wiced_bt_cfg_settings_t;
+
+/* Audio buffer configuration */
+#define WICED_AUDIO_SINK_ROLE       0x02
+#define WICED_HF_ROLE               0x08
+
+typedef struct
+{
+    uint8_t                 role;
+    uint32_t                audio_tx_buffer_size;
+    uint32_t                audio_codec_buffer_size;
+} wiced_bt_audio_config_buffer_t;
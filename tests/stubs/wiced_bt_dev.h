@@ -0,0 +1,56 @@
+/* Host stub: device management types and the calls the tested modules make */
+#pragma once
+#include "wiced_result.h"
+#include "wiced_bt_trace.h"
+
+typedef uint8_t wiced_bt_transport_t;
+#define BT_TRANSPORT_BR_EDR         1
+#define BT_TRANSPORT_LE             2
+
+#define BTM_NON_CONNECTABLE         0
+#define BTM_CONNECTABLE             1
+#define BTM_DEFAULT_CONN_WINDOW     0x12
+#define BTM_DEFAULT_CONN_INTERVAL   0x800
+
+#define BTM_PM_STS_ACTIVE           0
+#define BTM_PM_STS_HOLD             1
+#define BTM_PM_STS_SNIFF            2
+#define BTM_PM_STS_PARK             3
+#define BTM_PM_STS_SSR              4
+#define BTM_PM_STS_PENDING          5
+#define BTM_PM_STS_ERROR            6
+
+typedef wiced_result_t wiced_bt_dev_status_t;
+
+/* EIR data types */
+#define BTM_EIR_COMPLETE_16BITS_UUID_TYPE   0x03
+#define BTM_EIR_SHORTENED_LOCAL_NAME_TYPE   0x08
+#define BTM_EIR_COMPLETE_LOCAL_NAME_TYPE    0x09
+
+wiced_result_t wiced_bt_dev_write_eir(uint8_t *p_buff, uint16_t len);
+
+void wiced_bt_dev_set_no_smp_on_br(wiced_bool_t no_smp_on_br);
+
+/* Result of a management event nobody handles */
+#define WICED_BT_USE_DEFAULT_SECURITY   0x2000
+
+typedef enum
+{
+    BTM_ENABLED_EVT                     = 0,
+    BTM_DISABLED_EVT                    = 1,
+    BTM_POWER_MANAGEMENT_STATUS_EVT     = 2,
+    BTM_PIN_REQUEST_EVT                 = 3,
+    BTM_USER_CONFIRMATION_REQUEST_EVT   = 4,
+    BTM_SCO_CONNECTION_REQUEST_EVT      = 30,
+} wiced_bt_management_evt_t;
+
+typedef union
+{
+    uint8_t                 status;
+} wiced_bt_management_evt_data_t;
+
+wiced_bt_dev_status_t wiced_bt_dev_set_sniff_mode(wiced_bt_device_address_t remote_bda, uint16_t min_period,
+                                                  uint16_t max_period, uint16_t attempt, uint16_t timeout);
+wiced_bt_dev_status_t wiced_bt_dev_cancel_sniff_mode(wiced_bt_device_address_t remote_bda);
+wiced_bt_dev_status_t wiced_bt_dev_set_sniff_subrating(wiced_bt_device_address_t remote_bda, uint16_t max_latency,
+                                                       uint16_t min_remote_timeout, uint16_t min_local_timeout);
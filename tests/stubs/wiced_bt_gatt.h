@@ -0,0 +1,197 @@
+/* Host stub: GATT server types, database macros and calls of headset_control_le.c */
+#pragma once
+#include "wiced_bt_dev.h"
+
+#define BIT16_TO_8(val)             (uint8_t) (val), (uint8_t) ((val) >> 8)
+
+#define APPEARANCE_GENERIC_TAG      512
+#define GATT_DEF_BLE_MTU_SIZE       23
+
+/* Status */
+typedef int wiced_bt_gatt_status_t;
+
+#define WICED_BT_GATT_SUCCESS           0x00
+#define WICED_BT_GATT_INVALID_HANDLE    0x01
+#define WICED_BT_GATT_WRITE_NOT_PERMIT  0x03
+#define WICED_BT_GATT_INVALID_OFFSET    0x07
+#define WICED_BT_GATT_ERR_UNLIKELY      0x0e
+#define WICED_BT_GATT_INSUF_RESOURCE    0x11
+
+/* Request opcodes */
+typedef uint8_t wiced_bt_gatt_opcode_t;
+
+#define GATT_REQ_MTU                    0x02
+#define GATT_REQ_READ_BY_TYPE           0x08
+#define GATT_REQ_READ                   0x0a
+#define GATT_REQ_READ_BLOB              0x0c
+#define GATT_REQ_READ_MULTI             0x0e
+#define GATT_REQ_WRITE                  0x12
+#define GATT_HANDLE_VALUE_CONF          0x1e
+#define GATT_REQ_READ_MULTI_VAR_LENGTH  0x20
+#define GATT_CMD_WRITE                  0x52
+#define GATT_CMD_SIGNED_WRITE           0xd2
+
+/* Database definition: only the handles are kept */
+#define GATTDB_CHAR_PROP_READ               0x02
+#define GATTDB_CHAR_PROP_WRITE_NO_RESPONSE  0x04
+#define GATTDB_CHAR_PROP_WRITE              0x08
+#define GATTDB_CHAR_PROP_NOTIFY             0x10
+#define GATTDB_CHAR_PROP_INDICATE           0x20
+#define LEGATTDB_CHAR_PROP_NOTIFY           GATTDB_CHAR_PROP_NOTIFY
+
+#define GATTDB_PERM_READABLE                0x01
+#define GATTDB_PERM_WRITE_CMD               0x02
+#define GATTDB_PERM_WRITE_REQ               0x04
+#define GATTDB_PERM_AUTH_READABLE           0x08
+#define GATTDB_PERM_RELIABLE_WRITE          0x10
+#define GATTDB_PERM_VARIABLE_LENGTH         0x20
+#define LEGATTDB_PERM_WRITE_REQ             GATTDB_PERM_WRITE_REQ
+#define LEGATTDB_PERM_RELIABLE_WRITE        GATTDB_PERM_RELIABLE_WRITE
+
+#define GATT_UUID_GAP_DEVICE_NAME                           0x2a00
+#define GATT_UUID_GAP_ICON                                  0x2a01
+#define GATT_UUID_SYSTEM_ID                                 0x2a23
+#define GATT_UUID_MODEL_NUMBER_STR                          0x2a24
+#define GATT_UUID_MANU_NAME                                 0x2a29
+#define GATT_UUID_BATTERY_LEVEL                             0x2a19
+#define UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION 0x2902
+
+#define GATTDB_HANDLE(h)                                    (uint8_t) (h), (uint8_t) ((h) >> 8)
+#define PRIMARY_SERVICE_UUID16(h, uuid)                     GATTDB_HANDLE(h)
+#define PRIMARY_SERVICE_UUID128(h, ...)                     GATTDB_HANDLE(h)
+#define CHARACTERISTIC_UUID16(h, hv, uuid, prop, perm)      GATTDB_HANDLE(h), GATTDB_HANDLE(hv)
+#define CHARACTERISTIC_UUID16_WRITABLE(h, hv, uuid, prop, perm) \
+                                                            GATTDB_HANDLE(h), GATTDB_HANDLE(hv)
+#define CHARACTERISTIC_UUID128_WRITABLE(h, hv, ...)         GATTDB_HANDLE(h), GATTDB_HANDLE(hv)
+#define CHAR_DESCRIPTOR_UUID16_WRITABLE(h, uuid, perm)      GATTDB_HANDLE(h)
+
+typedef uint8_t wiced_bt_db_hash_t[16];
+
+/* Events */
+typedef enum
+{
+    GATT_CONNECTION_STATUS_EVT,
+    GATT_OPERATION_CPLT_EVT,
+    GATT_DISCOVERY_RESULT_EVT,
+    GATT_DISCOVERY_CPLT_EVT,
+    GATT_ATTRIBUTE_REQUEST_EVT,
+    GATT_CONGESTION_EVT,
+    GATT_GET_RESPONSE_BUFFER_EVT,
+    GATT_APP_BUFFER_TRANSMITTED_EVT,
+} wiced_bt_gatt_evt_t;
+
+typedef void *wiced_bt_gatt_app_context_t;
+
+typedef struct
+{
+    uint16_t    len;
+    union
+    {
+        uint16_t    uuid16;
+        uint32_t    uuid32;
+        uint8_t     uuid128[16];
+    } uu;
+} wiced_bt_uuid_t;
+
+typedef struct
+{
+    uint8_t         *bd_addr;
+    uint16_t        conn_id;
+    wiced_bool_t    connected;
+    uint16_t        reason;
+} wiced_bt_gatt_connection_status_t;
+
+typedef struct
+{
+    uint16_t    handle;
+    uint16_t    offset;
+} wiced_bt_gatt_read_t;
+
+typedef struct
+{
+    uint16_t        s_handle;
+    uint16_t        e_handle;
+    wiced_bt_uuid_t uuid;
+} wiced_bt_gatt_read_by_type_t;
+
+typedef struct
+{
+    uint16_t    num_handles;
+    uint8_t     *p_handle_stream;
+} wiced_bt_gatt_read_multiple_req_t;
+
+typedef struct
+{
+    uint16_t    handle;
+    uint16_t    offset;
+    uint16_t    val_len;
+    uint8_t     *p_val;
+} wiced_bt_gatt_write_req_t;
+
+typedef struct
+{
+    uint16_t                conn_id;
+    wiced_bt_gatt_opcode_t  opcode;
+    union
+    {
+        wiced_bt_gatt_read_t                read_req;
+        wiced_bt_gatt_read_by_type_t        read_by_type;
+        wiced_bt_gatt_read_multiple_req_t   read_multiple_req;
+        wiced_bt_gatt_write_req_t           write_req;
+        uint16_t                            remote_mtu;
+        struct
+        {
+            uint16_t                        handle;
+        } confirm;
+    } data;
+    uint16_t                len_requested;
+} wiced_bt_gatt_attribute_request_t;
+
+typedef union
+{
+    wiced_bt_gatt_connection_status_t   connection_status;
+    wiced_bt_gatt_attribute_request_t   attribute_request;
+    struct
+    {
+        uint16_t    len_requested;
+        struct
+        {
+            uint8_t *p_app_rsp_buffer;
+            void    *p_app_ctxt;
+        } buffer;
+    } buffer_request;
+    struct
+    {
+        uint8_t     *p_app_data;
+        void        *p_app_ctxt;
+    } buffer_xmitted;
+} wiced_bt_gatt_event_data_t;
+
+typedef wiced_bt_gatt_status_t (wiced_bt_gatt_cback_t)(wiced_bt_gatt_evt_t event, wiced_bt_gatt_event_data_t *p_data);
+
+wiced_bt_gatt_status_t  wiced_bt_gatt_db_init(const uint8_t *p_gatt_db, uint16_t len, wiced_bt_db_hash_t hash);
+wiced_bt_gatt_status_t  wiced_bt_gatt_register(wiced_bt_gatt_cback_t *p_gatt_cback);
+
+wiced_bt_gatt_status_t  wiced_bt_gatt_server_send_mtu_rsp(uint16_t conn_id, uint16_t remote_mtu, uint16_t local_mtu);
+wiced_bt_gatt_status_t  wiced_bt_gatt_server_send_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                            uint16_t handle);
+wiced_bt_gatt_status_t  wiced_bt_gatt_server_send_error_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                            uint16_t handle, wiced_bt_gatt_status_t status);
+wiced_bt_gatt_status_t  wiced_bt_gatt_server_send_read_handle_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                  uint16_t len, uint8_t *p_attr,
+                                                                  wiced_bt_gatt_app_context_t p_app_ctxt);
+wiced_bt_gatt_status_t  wiced_bt_gatt_server_send_read_by_type_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                   uint8_t type_len, uint16_t data_len,
+                                                                   uint8_t *p_data,
+                                                                   wiced_bt_gatt_app_context_t p_app_ctxt);
+wiced_bt_gatt_status_t  wiced_bt_gatt_server_send_read_multiple_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                    uint16_t data_len, uint8_t *p_data,
+                                                                    wiced_bt_gatt_app_context_t p_app_ctxt);
+
+uint16_t    wiced_bt_gatt_find_handle_by_type(uint16_t s_handle, uint16_t e_handle, wiced_bt_uuid_t *p_uuid);
+uint16_t    wiced_bt_gatt_get_handle_from_stream(uint8_t *p_handle_stream, uint16_t num_handle);
+int         wiced_bt_gatt_put_read_by_type_rsp_in_stream(uint8_t *p_stream, int stream_len, uint8_t *p_pair_len,
+                                                         uint16_t n_handle, uint16_t n_len, uint8_t *p_data);
+int         wiced_bt_gatt_put_read_multi_rsp_in_stream(wiced_bt_gatt_opcode_t opcode, uint8_t *p_stream,
+                                                       int stream_len, uint16_t n_handle, uint16_t n_len,
+                                                       uint8_t *p_data);
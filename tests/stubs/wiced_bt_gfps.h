@@ -0,0 +1,43 @@
+/* Host stub: Fast Pair provider configuration */
+#pragma once
+#include "wiced_bt_ble.h"
+#include "wiced_bt_gatt.h"
+
+#define WICED_BT_GFPS_UUID16                            0xfe2c
+#define WICED_BT_GFPS_UUID_CHARACTERISTIC_KEY_PAIRING   0x1234
+#define WICED_BT_GFPS_UUID_CHARACTERISTIC_PASSKEY       0x1235
+#define WICED_BT_GFPS_UUID_CHARACTERISTIC_ACCOUNT_KEY   0x1236
+
+#define WICED_BT_GFPS_ANTI_SPOOFING_KEY_LEN_PUBLIC      64
+#define WICED_BT_GFPS_ANTI_SPOOFING_KEY_LEN_PRIVATE     32
+
+typedef struct
+{
+    int8_t                  ble_tx_pwr_level;
+    wiced_bt_gatt_cback_t   *p_gatt_cb;
+    struct
+    {
+        uint16_t    key_pairing_val;
+        uint16_t    key_pairing_cfg_desc;
+        uint16_t    passkey_val;
+        uint16_t    passkey_cfg_desc;
+        uint16_t    account_key_val;
+    } gatt_db_handle;
+    uint32_t                model_id;
+    struct
+    {
+        uint8_t     public[WICED_BT_GFPS_ANTI_SPOOFING_KEY_LEN_PUBLIC];
+        uint8_t     private[WICED_BT_GFPS_ANTI_SPOOFING_KEY_LEN_PRIVATE];
+    } anti_spoofing_key;
+    wiced_bool_t            account_key_filter_generate_random;
+    uint8_t                 account_key_list_size;
+    uint16_t                account_key_list_nvram_id;
+    struct
+    {
+        wiced_bt_ble_advert_elem_t  *p_elem;
+        uint8_t                     elem_num;
+    } appended_adv_data;
+} wiced_bt_gfps_provider_conf_t;
+
+wiced_bool_t    wiced_bt_gfps_provider_init(wiced_bt_gfps_provider_conf_t *p_conf);
+void            wiced_bt_gfps_provider_discoverablility_set(wiced_bool_t discoverable);
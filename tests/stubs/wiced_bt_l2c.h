@@ -0,0 +1,12 @@
+/* Host stub: L2CAP calls the tested modules make */
+#pragma once
+#include "wiced_bt_dev.h"
+
+#define BT_PSM_AVCTP                0x0017
+#define BT_PSM_AVDTP                0x0019
+
+wiced_bool_t wiced_bt_l2cap_update_ble_conn_params(wiced_bt_device_address_t rem_bdRa,
+                                                   uint16_t min_int,
+                                                   uint16_t max_int,
+                                                   uint16_t latency,
+                                                   uint16_t timeout);
@@ -0,0 +1,30 @@
+/* Host stub: OTA firmware upgrade library handles and GATT entry points */
+#pragma once
+#include "wiced_bt_gatt.h"
+
+#define UUID_OTA_FW_UPGRADE_SERVICE                         0xae, 0x5d, 0x1e, 0x47, 0x5f, 0xe4, 0x9e, 0x86, \
+                                                            0xa8, 0x41, 0x8e, 0x27, 0x5f, 0x5e, 0xb5, 0x2d
+#define UUID_OTA_SEC_FW_UPGRADE_SERVICE                     0xc7, 0x26, 0x1d, 0xe4, 0xc8, 0xbd, 0xcb, 0x92, \
+                                                            0x24, 0x41, 0xb4, 0x10, 0x0f, 0x05, 0xa7, 0xc4
+#define UUID_OTA_FW_UPGRADE_CHARACTERISTIC_CONTROL_POINT    0x4a, 0x65, 0x04, 0x7c, 0x1b, 0x9d, 0x1c, 0xb5, \
+                                                            0x6d, 0x4b, 0x6c, 0xfd, 0xf5, 0xf7, 0x2a, 0xc8
+#define UUID_OTA_FW_UPGRADE_CHARACTERISTIC_DATA             0x5e, 0x1d, 0x6d, 0x0d, 0x5f, 0x83, 0xe4, 0x9a, \
+                                                            0x5f, 0x46, 0x52, 0x34, 0x38, 0xe5, 0xa9, 0x04
+
+enum
+{
+    HANDLE_OTA_FW_UPGRADE_SERVICE = 0xff00,
+    HANDLE_OTA_FW_UPGRADE_CHARACTERISTIC_CONTROL_POINT,
+    HANDLE_OTA_FW_UPGRADE_CONTROL_POINT,
+    HANDLE_OTA_FW_UPGRADE_CLIENT_CONFIGURATION_DESCRIPTOR,
+    HANDLE_OTA_FW_UPGRADE_CHARACTERISTIC_DATA,
+    HANDLE_OTA_FW_UPGRADE_DATA,
+};
+
+wiced_bool_t            wiced_ota_fw_upgrade_is_gatt_handle(uint16_t handle);
+void                    wiced_ota_fw_upgrade_connection_status_event(wiced_bt_gatt_connection_status_t *p_status);
+wiced_bt_gatt_status_t  wiced_ota_fw_upgrade_read_handler(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                          wiced_bt_gatt_read_t *p_read_data, uint16_t len_requested);
+wiced_bt_gatt_status_t  wiced_ota_fw_upgrade_write_handler(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                           wiced_bt_gatt_write_req_t *p_write_data);
+wiced_bt_gatt_status_t  wiced_ota_fw_upgrade_indication_cfm_handler(uint16_t conn_id, uint16_t handle);
@@ -0,0 +1,47 @@
+/* Host stub: SDP database macros, encoding as the SDK does */
+#pragma once
+#include "wiced_bt_sdp_defs.h"
+#include "wiced_result.h"
+
+#define UINT_DESC_TYPE              1
+#define UUID_DESC_TYPE              3
+#define TEXT_STR_DESC_TYPE          4
+#define DATA_ELE_SEQ_DESC_TYPE      6
+
+#define SIZE_ONE_BYTE               0
+#define SIZE_TWO_BYTES              1
+#define SIZE_FOUR_BYTES             2
+#define SIZE_IN_NEXT_BYTE           5
+#define SIZE_IN_NEXT_WORD           6
+
+#define SDP_ATTR_VALUE_UINT1(value) (uint8_t) ((UINT_DESC_TYPE << 3) | SIZE_ONE_BYTE), (uint8_t) (value)
+#define SDP_ATTR_VALUE_UINT2(value) (uint8_t) ((UINT_DESC_TYPE << 3) | SIZE_TWO_BYTES), \
+                                    (uint8_t) ((value) >> 8), (uint8_t) (value)
+#define SDP_ATTR_VALUE_UINT4(value) (uint8_t) ((UINT_DESC_TYPE << 3) | SIZE_FOUR_BYTES), \
+                                    (uint8_t) ((value) >> 24), (uint8_t) ((value) >> 16), \
+                                    (uint8_t) ((value) >> 8), (uint8_t) (value)
+
+#define SDP_ATTR_ID(id)             SDP_ATTR_VALUE_UINT2(id)
+#define SDP_ATTR_UINT2(id, value)   SDP_ATTR_ID(id), SDP_ATTR_VALUE_UINT2(value)
+#define SDP_ATTR_UINT4(id, value)   SDP_ATTR_ID(id), SDP_ATTR_VALUE_UINT4(value)
+#define SDP_ATTR_UUID16(uuid)       (uint8_t) ((UUID_DESC_TYPE << 3) | SIZE_TWO_BYTES), \
+                                    (uint8_t) ((uuid) >> 8), (uint8_t) (uuid)
+#define SDP_ATTR_SEQUENCE_1(len)    (uint8_t) ((DATA_ELE_SEQ_DESC_TYPE << 3) | SIZE_IN_NEXT_BYTE), (uint8_t) (len)
+#define SDP_ATTR_SEQUENCE_2(len)    (uint8_t) ((DATA_ELE_SEQ_DESC_TYPE << 3) | SIZE_IN_NEXT_WORD), \
+                                    (uint8_t) ((len) >> 8), (uint8_t) (len)
+
+#define SDP_ATTR_RECORD_HANDLE(handle)  SDP_ATTR_UINT4(ATTR_ID_SERVICE_RECORD_HDL, handle)
+#define SDP_ATTR_CLASS_ID(uuid)         SDP_ATTR_ID(ATTR_ID_SERVICE_CLASS_ID_LIST), SDP_ATTR_SEQUENCE_1(3), \
+                                        SDP_ATTR_UUID16(uuid)
+#define SDP_ATTR_SERVICE_NAME(len)      SDP_ATTR_ID(ATTR_ID_SERVICE_NAME), \
+                                        (uint8_t) ((TEXT_STR_DESC_TYPE << 3) | SIZE_IN_NEXT_BYTE), (uint8_t) (len)
+#define SDP_ATTR_BROWSE_LIST            SDP_ATTR_ID(ATTR_ID_BROWSE_GROUP_LIST), SDP_ATTR_SEQUENCE_1(3), \
+                                        SDP_ATTR_UUID16(UUID_SERVCLASS_PUBLIC_BROWSE_GROUP)
+#define SDP_ATTR_PROFILE_DESC_LIST(uuid, version) \
+                                        SDP_ATTR_ID(ATTR_ID_BT_PROFILE_DESC_LIST), SDP_ATTR_SEQUENCE_1(8), \
+                                        SDP_ATTR_SEQUENCE_1(6), SDP_ATTR_UUID16(uuid), SDP_ATTR_VALUE_UINT2(version)
+#define SDP_ATTR_RFCOMM_PROTOCOL_DESC_LIST(scn) \
+                                        SDP_ATTR_ID(ATTR_ID_PROTOCOL_DESC_LIST), SDP_ATTR_SEQUENCE_1(12), \
+                                        SDP_ATTR_SEQUENCE_1(3), SDP_ATTR_UUID16(UUID_PROTOCOL_L2CAP), \
+                                        SDP_ATTR_SEQUENCE_1(5), SDP_ATTR_UUID16(UUID_PROTOCOL_RFCOMM), \
+                                        SDP_ATTR_VALUE_UINT1(scn)
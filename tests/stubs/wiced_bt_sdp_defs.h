@@ -0,0 +1,29 @@
+/* Host stub: attribute IDs and UUIDs of the SDP records and the GATT database */
+#pragma once
+
+#define ATTR_ID_SERVICE_RECORD_HDL          0x0000
+#define ATTR_ID_SERVICE_CLASS_ID_LIST       0x0001
+#define ATTR_ID_PROTOCOL_DESC_LIST          0x0004
+#define ATTR_ID_BROWSE_GROUP_LIST           0x0005
+#define ATTR_ID_BT_PROFILE_DESC_LIST        0x0009
+#define ATTR_ID_SERVICE_NAME                0x0100
+#define ATTR_ID_SUPPORTED_FEATURES          0x0311
+
+#define UUID_PROTOCOL_RFCOMM                    0x0003
+#define UUID_PROTOCOL_AVCTP                     0x0017
+#define UUID_PROTOCOL_AVDTP                     0x0019
+#define UUID_PROTOCOL_L2CAP                     0x0100
+#define UUID_SERVCLASS_PUBLIC_BROWSE_GROUP      0x1002
+#define UUID_SERVCLASS_SERIAL_PORT              0x1101
+#define UUID_SERVCLASS_AUDIO_SINK               0x110B
+#define UUID_SERVCLASS_AV_REM_CTRL_TARGET       0x110C
+#define UUID_SERVCLASS_ADV_AUDIO_DISTRIBUTION   0x110D
+#define UUID_SERVCLASS_AV_REMOTE_CONTROL        0x110E
+#define UUID_SERVCLASS_AV_REM_CTRL_CONTROL      0x110F
+#define UUID_SERVCLASS_HF_HANDSFREE             0x111E
+#define UUID_SERVCLASS_GENERIC_AUDIO            0x1203
+
+#define UUID_SERVICE_GAP            0x1800
+#define UUID_SERVICE_GATT           0x1801
+#define UUID_SERVCLASS_DEVICE_INFO  0x180a
+#define UUID_SERVCLASS_BATTERY      0x180f
@@ -0,0 +1,8 @@
+/* Host stub: traces go to stub_trace(), printed with VERBOSE=1 */
+#pragma once
+void stub_trace(const char *p_fmt, ...);
+
+/* Called with every formatted trace line when set, reset by stub_reset() */
+extern void (*stub_trace_hook)(const char *p_line);
+
+#define WICED_BT_TRACE(...)     stub_trace(__VA_ARGS__)
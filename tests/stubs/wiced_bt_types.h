@@ -0,0 +1,5 @@
+/* Host stub */
+#pragma once
+#include "wiced_result.h"
+
+#define sizeof_array(a)             (sizeof(a) / sizeof((a)[0]))
@@ -0,0 +1,51 @@
+/* Host stub: button manager types, the button objects carry the edge times */
+#pragma once
+#include "wiced_result.h"
+
+typedef enum
+{
+    BUTTON_CLICK_EVENT                  = (1 << 0),
+    BUTTON_SHORT_DURATION_EVENT         = (1 << 1),
+    BUTTON_MEDIUM_DURATION_EVENT        = (1 << 2),
+    BUTTON_LONG_DURATION_EVENT          = (1 << 3),
+    BUTTON_VERY_LONG_DURATION_EVENT     = (1 << 4),
+    BUTTON_HOLDING_EVENT                = (1 << 5),
+} button_manager_event_t;
+
+typedef enum
+{
+    BUTTON_STATE_HELD                   = 0,
+    BUTTON_STATE_RELEASED               = 1,
+} button_manager_button_state_t;
+
+typedef struct
+{
+    int                     button;
+    uint32_t                button_event_mask;
+    uint32_t                application_event;
+} wiced_button_configuration_t;
+
+typedef struct
+{
+    wiced_button_configuration_t    *configuration;
+    button_manager_button_state_t   current_state;
+    uint32_t                        repeat;
+    uint64_t                        pressed_timestamp;      /* ms */
+    uint64_t                        released_timestamp;     /* ms */
+} button_manager_button_t;
+
+typedef struct
+{
+    int                     unused;
+} button_manager_t;
+
+typedef struct
+{
+    uint32_t                short_hold_duration;
+    uint32_t                medium_hold_duration;
+    uint32_t                long_hold_duration;
+    uint32_t                very_long_hold_duration;
+    uint32_t                debounce_duration;
+    wiced_bool_t            continuous_hold_detect;
+    void                    *event_handler;
+} wiced_button_manager_configuration_t;
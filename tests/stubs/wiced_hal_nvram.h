@@ -0,0 +1,4 @@
+/* Host stub: NVRAM identifiers */
+#pragma once
+
+#define WICED_NVRAM_VSID_START      0x200
@@ -0,0 +1,6 @@
+/* Host stub: stack buffer pools */
+#pragma once
+#include "wiced_result.h"
+
+void *wiced_bt_get_buffer(uint32_t size);
+void wiced_bt_free_buffer(void *p_buf);
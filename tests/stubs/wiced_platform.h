@@ -0,0 +1,22 @@
+/* Host stub: buttons of the 3 button board */
+#pragma once
+#include "wiced_result.h"
+
+typedef int platform_button_t;
+
+#define PLATFORM_BUTTON_1                   0
+#define PLATFORM_BUTTON_2                   1
+#define PLATFORM_BUTTON_3                   2
+#define PLATFORM_BUTTON_4                   3
+
+enum
+{
+    PLAY_PAUSE_BUTTON,
+    VOLUME_UP_NEXT_TRACK_BUTTON,
+    VOLUME_DOWN_PREVIOUS_TRACK_BUTTON,
+    VOICE_REC_BUTTON,
+};
+
+#ifndef APP_BUTTON_MAX
+#define APP_BUTTON_MAX                      3
+#endif
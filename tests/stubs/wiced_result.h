@@ -0,0 +1,31 @@
+/* Host stub: result codes and base types of the WICED SDK */
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef int         wiced_result_t;
+typedef uint8_t     wiced_bool_t;
+
+#define WICED_TRUE                  1
+#define WICED_FALSE                 0
+#ifndef TRUE
+#define TRUE                        1
+#define FALSE                       0
+#endif
+
+#define WICED_SUCCESS               0
+#define WICED_ERROR                 1
+#define WICED_BADARG                5
+#define WICED_NO_MEMORY             6
+#define WICED_ALREADY_CONNECTED     9
+
+#define WICED_BT_SUCCESS            0
+#define WICED_BT_ERROR              1
+#define WICED_BT_BADARG             5
+#define WICED_BT_PENDING            7
+#define WICED_BT_NO_RESOURCES       8
+#define WICED_BT_UNSUPPORTED        10
+
+#define BD_ADDR_LEN                 6
+typedef uint8_t wiced_bt_device_address_t[BD_ADDR_LEN];
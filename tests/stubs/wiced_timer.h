@@ -0,0 +1,29 @@
+/* Host stub: timers run on the simulated clock of stub.c */
+#pragma once
+#include "wiced_result.h"
+
+typedef uintptr_t WICED_TIMER_PARAM_TYPE;
+typedef void (wiced_timer_callback_t)(WICED_TIMER_PARAM_TYPE arg);
+
+typedef struct
+{
+    wiced_timer_callback_t  *p_cb;
+    WICED_TIMER_PARAM_TYPE  arg;
+    int                     type;
+    int                     armed;
+    uint64_t                due_us;
+} wiced_timer_t;
+
+#define WICED_MILLI_SECONDS_TIMER   0
+#define WICED_SECONDS_TIMER         1
+
+wiced_result_t wiced_init_timer(wiced_timer_t *p_timer, wiced_timer_callback_t *p_cb, WICED_TIMER_PARAM_TYPE arg, int type);
+wiced_result_t wiced_start_timer(wiced_timer_t *p_timer, uint32_t timeout);
+wiced_result_t wiced_stop_timer(wiced_timer_t *p_timer);
+wiced_bool_t   wiced_is_timer_in_use(wiced_timer_t *p_timer);
+wiced_result_t wiced_deinit_timer(wiced_timer_t *p_timer);
+
+/* Move the simulated clock forward, running the timers falling due on the way */
+void           stub_time_advance_us(uint64_t us);
+void           stub_time_advance_ms(uint32_t ms);
+uint64_t       stub_time_us(void);
@@ -0,0 +1,34 @@
+#if !defined(TEST_H)
+#define TEST_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Fail the test with the location of the check */
+#define CHECK(cond)                                                             \
+    do                                                                          \
+    {                                                                           \
+        if (!(cond))                                                            \
+        {                                                                       \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                            \
+        }                                                                       \
+    } while (0)
+
+/* Run one test case */
+#define RUN(test)                                                               \
+    do                                                                          \
+    {                                                                           \
+        stub_reset();                                                           \
+        test();                                                                 \
+        printf("  %s ok\n", #test);                                             \
+    } while (0)
+
+/* Host time in ns, for the benchmarks */
+uint64_t    test_clock_ns(void);
+
+/* Restore the stubs (time, timers, trace capture) between test cases */
+void        stub_reset(void);
+
+#endif /* TEST_H */
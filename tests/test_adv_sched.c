@@ -0,0 +1,194 @@
+/******************************************************************************
+* File Name:   test_adv_sched.c
+*
+* Description: Host test of the advertising scheduler with a radio-on time and discovery latency model.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "headset_adv_sched.h"
+#include "test.h"
+
+/* wiced_bt_cfg_adv_settings: high and low duty intervals in 0.625 ms slots */
+#define FAST_SLOTS      160
+#define SLOW_SLOTS      400
+
+/* One connectable advertising event on 3 channels: 3 x (ADV_IND 376 us + ramp and listen 150 us) */
+#define EVENT_US        (3 * (376 + 150))
+
+/* Mean of the 0 - 10 ms random advDelay added to every interval */
+#define ADV_DELAY_US    5000
+
+/* Fake stack, reports every mode change back like BTM_BLE_ADVERT_STATE_CHANGED_EVT */
+static uint32_t start_count;
+static wiced_bt_ble_advert_mode_t adv_mode = BTM_BLE_ADVERT_OFF;
+
+wiced_result_t wiced_bt_start_advertisements(wiced_bt_ble_advert_mode_t advert_mode,
+                                             uint8_t directed_advertisement_bdaddr_type,
+                                             uint8_t *directed_advertisement_bdaddr_ptr)
+{
+    start_count++;
+    adv_mode = advert_mode;
+    headset_adv_sched_advert_state_changed(advert_mode);
+
+    return WICED_BT_SUCCESS;
+}
+
+/* Advertising started by the Fast Pair provider */
+static void provider_start(wiced_bt_ble_advert_mode_t mode)
+{
+    adv_mode = mode;
+    headset_adv_sched_advert_state_changed(mode);
+}
+
+static void test_select(void)
+{
+    CHECK(headset_adv_sched_select(0) == HEADSET_ADV_SCHED_PROFILE_SLOW);
+    CHECK(headset_adv_sched_select(HEADSET_ADV_SCHED_STATE_BREDR_CONNECTED) == HEADSET_ADV_SCHED_PROFILE_SLOW);
+    CHECK(headset_adv_sched_select(HEADSET_ADV_SCHED_STATE_DISCOVERABLE) == HEADSET_ADV_SCHED_PROFILE_FAST);
+    CHECK(headset_adv_sched_select(HEADSET_ADV_SCHED_STATE_STREAMING) == HEADSET_ADV_SCHED_PROFILE_OFF);
+    CHECK(headset_adv_sched_select(HEADSET_ADV_SCHED_STATE_CALL) == HEADSET_ADV_SCHED_PROFILE_OFF);
+
+    /* Pairing is not slowed down by audio */
+    CHECK(headset_adv_sched_select(HEADSET_ADV_SCHED_STATE_DISCOVERABLE | HEADSET_ADV_SCHED_STATE_STREAMING) ==
+          HEADSET_ADV_SCHED_PROFILE_FAST);
+
+    CHECK(headset_adv_sched_select(HEADSET_ADV_SCHED_STATE_DISCOVERABLE | HEADSET_ADV_SCHED_STATE_LE_CONNECTED) ==
+          HEADSET_ADV_SCHED_PROFILE_OFF);
+    CHECK(headset_adv_sched_select(HEADSET_ADV_SCHED_STATE_DISCOVERABLE | HEADSET_ADV_SCHED_STATE_AUTO_OFF) ==
+          HEADSET_ADV_SCHED_PROFILE_OFF);
+}
+
+static void test_schedule(void)
+{
+    /* Nothing happens until the provider has set the advertising data */
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_BREDR_CONNECTED, WICED_TRUE);
+    CHECK(start_count == 0);
+
+    headset_adv_sched_enable();
+    CHECK(adv_mode == BTM_BLE_ADVERT_UNDIRECTED_LOW);
+
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_STREAMING, WICED_TRUE);
+    CHECK(adv_mode == BTM_BLE_ADVERT_OFF);
+
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_DISCOVERABLE, WICED_TRUE);
+    CHECK(adv_mode == BTM_BLE_ADVERT_UNDIRECTED_HIGH);
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_DISCOVERABLE, WICED_FALSE);
+    CHECK(adv_mode == BTM_BLE_ADVERT_OFF);
+
+    /* The stack stops advertising on an LE connection, the scheduler does not touch it */
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_STREAMING, WICED_FALSE);
+    CHECK(adv_mode == BTM_BLE_ADVERT_UNDIRECTED_LOW);
+    start_count = 0;
+    provider_start(BTM_BLE_ADVERT_OFF);
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_LE_CONNECTED, WICED_TRUE);
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_STREAMING, WICED_TRUE);
+    CHECK(start_count == 0);
+
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_STREAMING | HEADSET_ADV_SCHED_STATE_LE_CONNECTED, WICED_FALSE);
+    CHECK(adv_mode == BTM_BLE_ADVERT_UNDIRECTED_LOW);
+}
+
+/* Advertising the Fast Pair provider restarts while the schedule is off is stopped again */
+static void test_provider_restart(void)
+{
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_STREAMING, WICED_TRUE);
+    CHECK(adv_mode == BTM_BLE_ADVERT_OFF);
+
+    start_count = 0;
+    provider_start(BTM_BLE_ADVERT_UNDIRECTED_LOW);
+    CHECK(start_count == 1);
+    CHECK(adv_mode == BTM_BLE_ADVERT_OFF);
+
+    /* In the other profiles the restart is left running until the next profile change */
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_DISCOVERABLE, WICED_TRUE);
+    CHECK(adv_mode == BTM_BLE_ADVERT_UNDIRECTED_HIGH);
+    start_count = 0;
+    provider_start(BTM_BLE_ADVERT_UNDIRECTED_LOW);
+    CHECK(start_count == 0);
+    CHECK(adv_mode == BTM_BLE_ADVERT_UNDIRECTED_LOW);
+
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_DISCOVERABLE, WICED_FALSE);
+    CHECK(adv_mode == BTM_BLE_ADVERT_OFF);
+    CHECK(start_count == 1);
+
+    /* The stack owns advertising while the LE link is up */
+    headset_adv_sched_state_set(HEADSET_ADV_SCHED_STATE_LE_CONNECTED, WICED_TRUE);
+    start_count = 0;
+    provider_start(BTM_BLE_ADVERT_UNDIRECTED_LOW);
+    CHECK(start_count == 0);
+}
+
+/* Radio-on time and discovery latency of each profile, for a phone scanning continuously */
+static void test_model(void)
+{
+    static const struct
+    {
+        const char  *name;
+        uint32_t    slots;
+    } profiles[] =
+    {
+        { "fast", FAST_SLOTS },
+        { "slow", SLOW_SLOTS },
+    };
+    uint32_t period_us;
+    uint32_t duty_ppm[2];
+    uint32_t i;
+
+    for (i = 0; i < 2; i++)
+    {
+        period_us   = profiles[i].slots * 625 + ADV_DELAY_US;
+        duty_ppm[i] = (uint32_t) (((uint64_t) EVENT_US * 1000000) / period_us);
+
+        printf("    %s: %u ms interval, radio on %u.%02u %%, discovery %u ms mean / %u ms worst\n",
+               profiles[i].name,
+               profiles[i].slots * 625 / 1000,
+               duty_ppm[i] / 10000, (duty_ppm[i] / 100) % 100,
+               period_us / 2000, (period_us + ADV_DELAY_US) / 1000);
+    }
+
+    CHECK(duty_ppm[1] < duty_ppm[0]);
+    CHECK(duty_ppm[0] < 20000);     /* Fast stays below 2 % */
+}
+
+int main(void)
+{
+    RUN(test_select);
+    RUN(test_schedule);
+    RUN(test_provider_restart);
+    RUN(test_model);
+
+    return 0;
+}
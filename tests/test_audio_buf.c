@@ -0,0 +1,142 @@
+/******************************************************************************
+* File Name:   test_audio_buf.c
+*
+* Description: Host test of the audio buffer sizing model.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "headset_audio_buf.h"
+#include "test.h"
+
+/* Baseline layout of wiced_app_cfg.c: main region shared by HFP and A2DP, codec region after it */
+#define MAIN_SIZE       (15 * 1024)
+#define SBC_JITTER      HEADSET_AUDIO_BUF_SBC_JITTER_SIZE(300, 48000, 53)
+#define AAC_JITTER      HEADSET_AUDIO_BUF_AAC_JITTER_SIZE(300, 48000, 320000)
+
+static void test_baseline_sizes(void)
+{
+    CHECK(MAIN_SIZE + HEADSET_AUDIO_BUF_SBC_CODEC_SIZE == 22268);
+    CHECK(SBC_JITTER <= MAIN_SIZE);
+    CHECK(AAC_JITTER <= MAIN_SIZE);
+}
+
+static void test_model(void)
+{
+    uint32_t depth_ms;
+
+    /* SBC joint stereo, 16 blocks, 8 subbands, bitpool 53: A2DP spec frame length */
+    CHECK(HEADSET_AUDIO_BUF_SBC_FRAME_LEN(53) == 119);
+
+    /* Main region covers the library minimums */
+    CHECK(MAIN_SIZE >= HEADSET_AUDIO_BUF_LIB_HFP_MIN);
+    CHECK(MAIN_SIZE >= HEADSET_AUDIO_BUF_LIB_A2DP_MIN);
+
+    /* Deepest SBC jitter buffer that still fits the main region */
+    for (depth_ms = 300; HEADSET_AUDIO_BUF_SBC_JITTER_SIZE(depth_ms + 1, 48000, 53) <= MAIN_SIZE; depth_ms++)
+    {
+    }
+    printf("    sbc jitter: %u bytes at 300 ms, max depth %u ms in %u bytes\n",
+           (unsigned) SBC_JITTER, (unsigned) depth_ms, (unsigned) MAIN_SIZE);
+    CHECK(depth_ms >= 300);
+    CHECK(HEADSET_AUDIO_BUF_SBC_JITTER_SIZE(depth_ms + 1, 48000, 53) > MAIN_SIZE);
+}
+
+/* Sweep of the codec parameters: sizes grow with each of them, the largest fitting settings */
+static void test_sweep(void)
+{
+    static const uint32_t rates[] = { 16000, 32000, 44100, 48000 };
+    uint32_t depth_ms;
+    uint32_t bitpool;
+    uint32_t i;
+    uint32_t max_bitpool = 0;
+    uint32_t max_bit_rate = 0;
+    uint32_t bit_rate;
+
+    for (i = 0; i < sizeof(rates) / sizeof(rates[0]); i++)
+    {
+        for (depth_ms = 20; depth_ms <= 500; depth_ms += 20)
+        {
+            for (bitpool = 2; bitpool <= 53; bitpool++)
+            {
+                CHECK(HEADSET_AUDIO_BUF_SBC_JITTER_SIZE(depth_ms, rates[i], bitpool) >=
+                      HEADSET_AUDIO_BUF_SBC_JITTER_SIZE(depth_ms, rates[i], bitpool - 1));
+                CHECK(HEADSET_AUDIO_BUF_SBC_JITTER_SIZE(depth_ms, rates[i], bitpool) >=
+                      HEADSET_AUDIO_BUF_SBC_JITTER_SIZE(depth_ms - 20, rates[i], bitpool));
+                CHECK((i == 0) || (HEADSET_AUDIO_BUF_SBC_JITTER_SIZE(depth_ms, rates[i], bitpool) >=
+                                   HEADSET_AUDIO_BUF_SBC_JITTER_SIZE(depth_ms, rates[i - 1], bitpool)));
+            }
+
+            for (bit_rate = 64000; bit_rate <= 320000; bit_rate += 32000)
+            {
+                CHECK(HEADSET_AUDIO_BUF_AAC_JITTER_SIZE(depth_ms, rates[i], bit_rate) >=
+                      HEADSET_AUDIO_BUF_AAC_JITTER_SIZE(depth_ms, rates[i], bit_rate - 32000));
+                CHECK(HEADSET_AUDIO_BUF_AAC_JITTER_SIZE(depth_ms, rates[i], bit_rate) >=
+                      HEADSET_AUDIO_BUF_AAC_JITTER_SIZE(depth_ms - 20, rates[i], bit_rate));
+            }
+        }
+    }
+
+    /* Highest SBC bitpool and AAC bit rate whose 300 ms jitter buffer fits the main region at 48 kHz */
+    for (bitpool = 2; bitpool <= 250; bitpool++)
+    {
+        if (HEADSET_AUDIO_BUF_SBC_JITTER_SIZE(300, 48000, bitpool) <= MAIN_SIZE)
+        {
+            max_bitpool = bitpool;
+        }
+    }
+
+    for (bit_rate = 32000; bit_rate <= 1024000; bit_rate += 8000)
+    {
+        if (HEADSET_AUDIO_BUF_AAC_JITTER_SIZE(300, 48000, bit_rate) <= MAIN_SIZE)
+        {
+            max_bit_rate = bit_rate;
+        }
+    }
+
+    printf("    300 ms at 48 kHz: sbc bitpool up to %u, aac up to %u bit/s\n",
+           (unsigned) max_bitpool, (unsigned) max_bit_rate);
+    CHECK(max_bitpool >= 53);
+    CHECK(max_bit_rate >= 320000);
+}
+
+int main(void)
+{
+    RUN(test_baseline_sizes);
+    RUN(test_model);
+    RUN(test_sweep);
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/******************************************************************************
+* File Name:   test_btm_evt.c
+*
+* Description: Host test of the management event dispatch: one handler per event, results and refused registrations.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "headset_btm_evt.h"
+#include "test.h"
+#include "wiced_bt_dev.h"
+
+static char     calls[64];
+static uint32_t num_calls;
+
+static wiced_result_t handler_a(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data)
+{
+    calls[num_calls++] = 'a';
+
+    return WICED_BT_SUCCESS;
+}
+
+static wiced_result_t handler_b(wiced_bt_management_evt_t event, wiced_bt_management_evt_data_t *p_event_data)
+{
+    calls[num_calls++] = 'b';
+
+    return WICED_BT_PENDING;
+}
+
+static void calls_reset(void)
+{
+    memset(calls, 0, sizeof(calls));
+    num_calls = 0;
+}
+
+/*
+ * The dispatch table is static: the cases run in this order and share it.
+ */
+
+/* Each event runs its own handler and returns its result */
+static void test_dispatch(void)
+{
+    wiced_bt_management_evt_data_t data = {0};
+
+    CHECK(headset_btm_evt_register(BTM_SCO_CONNECTION_REQUEST_EVT, handler_b) == WICED_BT_SUCCESS);
+    CHECK(headset_btm_evt_register(BTM_ENABLED_EVT, handler_a) == WICED_BT_SUCCESS);
+
+    calls_reset();
+    CHECK(headset_btm_evt_dispatch(BTM_SCO_CONNECTION_REQUEST_EVT, &data) == WICED_BT_PENDING);
+    CHECK(strcmp(calls, "b") == 0);
+
+    calls_reset();
+    CHECK(headset_btm_evt_dispatch(BTM_ENABLED_EVT, &data) == WICED_BT_SUCCESS);
+    CHECK(strcmp(calls, "a") == 0);
+
+    /* No handler, or out of the table: default answer */
+    calls_reset();
+    CHECK(headset_btm_evt_dispatch(BTM_PIN_REQUEST_EVT, &data) == WICED_BT_USE_DEFAULT_SECURITY);
+    CHECK(headset_btm_evt_dispatch((wiced_bt_management_evt_t) HEADSET_BTM_EVT_MAX, &data) == WICED_BT_USE_DEFAULT_SECURITY);
+    CHECK(num_calls == 0);
+}
+
+/* A second handler for an event and bad arguments are refused, the registered handler is kept */
+static void test_refused(void)
+{
+    wiced_bt_management_evt_data_t data = {0};
+
+    CHECK(headset_btm_evt_register((wiced_bt_management_evt_t) HEADSET_BTM_EVT_MAX, handler_a) == WICED_BT_BADARG);
+    CHECK(headset_btm_evt_register(BTM_DISABLED_EVT, NULL) == WICED_BT_BADARG);
+
+    CHECK(headset_btm_evt_register(BTM_SCO_CONNECTION_REQUEST_EVT, handler_a) == WICED_BT_ERROR);
+    CHECK(headset_btm_evt_register(BTM_SCO_CONNECTION_REQUEST_EVT, handler_b) == WICED_BT_ERROR);
+
+    calls_reset();
+    CHECK(headset_btm_evt_dispatch(BTM_SCO_CONNECTION_REQUEST_EVT, &data) == WICED_BT_PENDING);
+    CHECK(strcmp(calls, "b") == 0);
+}
+
+int main(void)
+{
+    RUN(test_dispatch);
+    RUN(test_refused);
+
+    return 0;
+}
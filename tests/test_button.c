@@ -0,0 +1,214 @@
+/******************************************************************************
+* File Name:   test_button.c
+*
+* Description: Host test of the button action map and the button pre-handler.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "bt_hs_spk_button.h"
+#include "bt_hs_spk_handsfree.h"
+#include "headset_button.h"
+#include "test.h"
+#include "wiced_timer.h"
+
+#define BENCH_LOOKUPS   1000000
+
+wiced_result_t btheadset_init_button_interface(void);
+
+/* Baseline action list of the 3 button board */
+static const bt_hs_spk_button_action_t expected_action[] =
+{
+    { ACTION_PAUSE_PLAY,            PLAY_PAUSE_BUTTON,                  BUTTON_CLICK_EVENT,             BUTTON_STATE_RELEASED,  0 },
+    { ACTION_BT_DISCOVERABLE,       PLAY_PAUSE_BUTTON,                  BUTTON_LONG_DURATION_EVENT,     BUTTON_STATE_HELD,      0 },
+    { ACTION_VOLUME_UP,             VOLUME_UP_NEXT_TRACK_BUTTON,        BUTTON_CLICK_EVENT,             BUTTON_STATE_RELEASED,  0 },
+    { ACTION_FORWARD,               VOLUME_UP_NEXT_TRACK_BUTTON,        BUTTON_LONG_DURATION_EVENT,     BUTTON_STATE_RELEASED,  0 },
+    { ACTION_VOICE_RECOGNITION,     VOLUME_UP_NEXT_TRACK_BUTTON,        BUTTON_HOLDING_EVENT,           BUTTON_STATE_HELD,      2 },
+    { ACTION_VOLUME_DOWN,           VOLUME_DOWN_PREVIOUS_TRACK_BUTTON,  BUTTON_CLICK_EVENT,             BUTTON_STATE_RELEASED,  0 },
+    { ACTION_BACKWARD,              VOLUME_DOWN_PREVIOUS_TRACK_BUTTON,  BUTTON_LONG_DURATION_EVENT,     BUTTON_STATE_RELEASED,  0 },
+    { ACTION_TRANSPORT_DETECT_ON,   VOLUME_DOWN_PREVIOUS_TRACK_BUTTON,  BUTTON_HOLDING_EVENT,           BUTTON_STATE_HELD,      2 },
+};
+
+static bt_hs_spk_button_config_t config;
+static uint32_t user_activity_count;
+static uint32_t wake_count;
+
+wiced_result_t bt_hs_spk_init_button_interface(bt_hs_spk_button_config_t *p_config)
+{
+    config = *p_config;
+
+    return WICED_SUCCESS;
+}
+
+wiced_bool_t bt_hs_spk_handsfree_call_session_check(void)
+{
+    return WICED_FALSE;
+}
+
+void headset_power_user_activity(void)
+{
+    user_activity_count++;
+}
+
+void headset_sniff_wake(void)
+{
+    wake_count++;
+}
+
+/* Search of the bt_hs_spk library, for the benchmark */
+static app_service_action_t linear_resolve(platform_button_t button, button_manager_event_t event,
+                                           button_manager_button_state_t state, uint32_t repeat)
+{
+    uint32_t i;
+
+    for (i = 0; i < config.button_action_config.number_of_actions; i++)
+    {
+        bt_hs_spk_button_action_t *p_action = &config.button_action_config.p_action[i];
+
+        if ((p_action->button == button) && (p_action->event == event) && (p_action->state == state) &&
+            ((event != BUTTON_HOLDING_EVENT) || (p_action->repeat == repeat)))
+        {
+            return p_action->action;
+        }
+    }
+
+    return NO_ACTION;
+}
+
+static void test_action_list(void)
+{
+    app_service_action_t action;
+    uint32_t i;
+
+    CHECK(btheadset_init_button_interface() == WICED_SUCCESS);
+    CHECK(config.number_of_buttons == APP_BUTTON_MAX);
+    CHECK(config.p_pre_handler != NULL);
+
+    CHECK(config.button_action_config.number_of_actions == sizeof(expected_action) / sizeof(expected_action[0]));
+    CHECK(memcmp(config.button_action_config.p_action, expected_action, sizeof(expected_action)) == 0);
+
+    for (i = 0; i < config.button_action_config.number_of_actions; i++)
+    {
+        CHECK(headset_button_action_resolve(expected_action[i].button, expected_action[i].event,
+                                            expected_action[i].state, expected_action[i].repeat, &action));
+        CHECK(action == expected_action[i].action);
+    }
+}
+
+/* Every event goes to the library, mapped or not */
+static void test_pre_handler(void)
+{
+    uint32_t i;
+
+    CHECK(btheadset_init_button_interface() == WICED_SUCCESS);
+
+    for (i = 0; i < sizeof(expected_action) / sizeof(expected_action[0]); i++)
+    {
+        CHECK(config.p_pre_handler(expected_action[i].button, expected_action[i].event,
+                                   expected_action[i].state, expected_action[i].repeat));
+    }
+
+    CHECK(config.p_pre_handler(PLAY_PAUSE_BUTTON, BUTTON_LONG_DURATION_EVENT, BUTTON_STATE_RELEASED, 0));
+    CHECK(config.p_pre_handler(PLAY_PAUSE_BUTTON, BUTTON_VERY_LONG_DURATION_EVENT, BUTTON_STATE_HELD, 0));
+    CHECK(config.p_pre_handler(VOLUME_UP_NEXT_TRACK_BUTTON, BUTTON_HOLDING_EVENT, BUTTON_STATE_HELD, 1));
+    CHECK(config.p_pre_handler(VOLUME_UP_NEXT_TRACK_BUTTON, BUTTON_HOLDING_EVENT, BUTTON_STATE_HELD, 3));
+    CHECK(config.p_pre_handler(VOLUME_DOWN_PREVIOUS_TRACK_BUTTON, BUTTON_CLICK_EVENT, BUTTON_STATE_HELD, 0));
+    CHECK(config.p_pre_handler(APP_BUTTON_MAX, BUTTON_CLICK_EVENT, BUTTON_STATE_RELEASED, 0));
+
+    /* Every event is user activity and wakes the links */
+    CHECK(user_activity_count == i + 6);
+    CHECK(wake_count == i + 6);
+}
+
+/* A long hold of volume down: one event per hold period, all but one unmapped */
+
+static void test_bench(void)
+{
+    static const struct
+    {
+        button_manager_event_t          event;
+        button_manager_button_state_t   state;
+        uint32_t                        repeat;
+    } hold[] =
+    {
+        { BUTTON_LONG_DURATION_EVENT,   BUTTON_STATE_HELD,  0 },
+        { BUTTON_HOLDING_EVENT,         BUTTON_STATE_HELD,  1 },
+        { BUTTON_HOLDING_EVENT,         BUTTON_STATE_HELD,  2 },
+        { BUTTON_HOLDING_EVENT,         BUTTON_STATE_HELD,  3 },
+        { BUTTON_HOLDING_EVENT,         BUTTON_STATE_HELD,  4 },
+        { BUTTON_HOLDING_EVENT,         BUTTON_STATE_HELD,  5 },
+    };
+    volatile uint32_t found = 0;
+    app_service_action_t action;
+    uint64_t start, map_ns, list_ns;
+    uint32_t i, j;
+
+    CHECK(btheadset_init_button_interface() == WICED_SUCCESS);
+
+    start = test_clock_ns();
+    for (i = 0; i < BENCH_LOOKUPS; i++)
+    {
+        j = i % (sizeof(hold) / sizeof(hold[0]));
+        found += headset_button_action_resolve(VOLUME_DOWN_PREVIOUS_TRACK_BUTTON, hold[j].event, hold[j].state,
+                                               hold[j].repeat, &action);
+    }
+    map_ns = test_clock_ns() - start;
+
+    start = test_clock_ns();
+    for (i = 0; i < BENCH_LOOKUPS; i++)
+    {
+        j = i % (sizeof(hold) / sizeof(hold[0]));
+        found += (linear_resolve(VOLUME_DOWN_PREVIOUS_TRACK_BUTTON, hold[j].event, hold[j].state,
+                                 hold[j].repeat) != NO_ACTION);
+    }
+    list_ns = test_clock_ns() - start;
+
+    /* Only the second hold repeat is mapped, both searches find it */
+    CHECK(found == 2 * ((BENCH_LOOKUPS + 3) / 6));
+    printf("    lookup %u.%u ns, library list search %u.%u ns (host)\n",
+           (uint32_t) (map_ns * 10 / BENCH_LOOKUPS) / 10, (uint32_t) (map_ns * 10 / BENCH_LOOKUPS) % 10,
+           (uint32_t) (list_ns * 10 / BENCH_LOOKUPS) / 10, (uint32_t) (list_ns * 10 / BENCH_LOOKUPS) % 10);
+}
+
+int main(void)
+{
+    RUN(test_action_list);
+    RUN(test_pre_handler);
+    RUN(test_bench);
+
+    return 0;
+}
@@ -0,0 +1,219 @@
+/******************************************************************************
+* File Name:   test_button_trace.c
+*
+* Description: Host test of the button trace stages, from the GPIO edge to the library action.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "bt_hs_spk_button.h"
+#include "bt_hs_spk_handsfree.h"
+#include "headset_button_trace.h"
+#include "headset_defer.h"
+#include "test.h"
+#include "wiced_bt_trace.h"
+#include "wiced_timer.h"
+
+#define DEFER_MAX       8
+
+wiced_result_t btheadset_init_button_interface(void);
+
+extern button_manager_button_t app_buttons[];
+
+static bt_hs_spk_button_config_t config;
+
+static struct
+{
+    headset_defer_func_t    p_func;
+    void                    *p_arg;
+} deferred[DEFER_MAX];
+static uint32_t num_deferred;
+
+static uint32_t gpio_lines;
+
+wiced_result_t bt_hs_spk_init_button_interface(bt_hs_spk_button_config_t *p_config)
+{
+    config = *p_config;
+
+    return WICED_SUCCESS;
+}
+
+wiced_bool_t bt_hs_spk_handsfree_call_session_check(void)
+{
+    return WICED_FALSE;
+}
+
+void headset_power_user_activity(void)
+{
+}
+
+void headset_sniff_wake(void)
+{
+}
+
+wiced_result_t headset_defer(headset_defer_priority_t priority, headset_defer_func_t p_func, void *p_arg)
+{
+    CHECK(num_deferred < DEFER_MAX);
+
+    deferred[num_deferred].p_func  = p_func;
+    deferred[num_deferred].p_arg   = p_arg;
+    num_deferred++;
+
+    return WICED_SUCCESS;
+}
+
+/* Return to the application thread: the deferred work runs */
+static void defer_run(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < num_deferred; i++)
+    {
+        deferred[i].p_func(deferred[i].p_arg);
+    }
+
+    num_deferred = 0;
+}
+
+static void trace_hook(const char *p_line)
+{
+    if (strstr(p_line, "headset_button_trace: t ") && strstr(p_line, " gpio"))
+    {
+        gpio_lines++;
+    }
+}
+
+static void setup(void)
+{
+    num_deferred = 0;
+
+    CHECK(btheadset_init_button_interface() == WICED_SUCCESS);
+    CHECK(config.p_pre_handler != NULL);
+
+    /* Away from 0, the GPIO edges are in the past */
+    stub_time_advance_ms(1000);
+}
+
+/* A click: release edge, button manager event, pre-handler, library action */
+static void test_release(void)
+{
+    const headset_button_trace_hist_t *p_event;
+    const headset_button_trace_hist_t *p_dispatch;
+    const headset_button_trace_hist_t *p_action;
+
+    setup();
+
+    app_buttons[VOLUME_UP_NEXT_TRACK_BUTTON].released_timestamp = stub_time_us() / 1000;
+    stub_time_advance_us(3000);
+
+    CHECK(config.p_pre_handler(VOLUME_UP_NEXT_TRACK_BUTTON, BUTTON_CLICK_EVENT, BUTTON_STATE_RELEASED, 0));
+    CHECK(num_deferred == 1);
+
+    /* The library runs the action before the deferred stamp */
+    stub_time_advance_us(500);
+    defer_run();
+
+    p_event     = headset_button_trace_hist_get(HEADSET_BUTTON_TRACE_STAGE_EVENT);
+    p_dispatch  = headset_button_trace_hist_get(HEADSET_BUTTON_TRACE_STAGE_DISPATCH);
+    p_action    = headset_button_trace_hist_get(HEADSET_BUTTON_TRACE_STAGE_ACTION);
+
+    CHECK(headset_button_trace_hist_get(HEADSET_BUTTON_TRACE_STAGE_GPIO) == NULL);
+    CHECK((p_event->count == 1) && (p_event->min_us == 3000));
+    CHECK((p_dispatch->count == 1) && (p_dispatch->min_us == 3000));
+    CHECK((p_action->count == 1) && (p_action->min_us == 3500));
+}
+
+/* Hold events have no edge: they start at the EVENT stamp */
+static void test_hold(void)
+{
+    const headset_button_trace_hist_t *p_event;
+    const headset_button_trace_hist_t *p_action;
+
+    setup();
+
+    app_buttons[VOLUME_UP_NEXT_TRACK_BUTTON].pressed_timestamp = stub_time_us() / 1000;
+    stub_time_advance_ms(2000);
+
+    CHECK(config.p_pre_handler(VOLUME_UP_NEXT_TRACK_BUTTON, BUTTON_HOLDING_EVENT, BUTTON_STATE_HELD, 2));
+    stub_time_advance_us(200);
+    defer_run();
+
+    p_event     = headset_button_trace_hist_get(HEADSET_BUTTON_TRACE_STAGE_EVENT);
+    p_action    = headset_button_trace_hist_get(HEADSET_BUTTON_TRACE_STAGE_ACTION);
+
+    CHECK(p_event->count == 0);
+    CHECK((p_action->count == 1) && (p_action->min_us == 200));
+}
+
+/* Unmapped events are passed on, without an action stamp */
+static void test_unmapped(void)
+{
+    setup();
+
+    CHECK(config.p_pre_handler(VOLUME_UP_NEXT_TRACK_BUTTON, BUTTON_HOLDING_EVENT, BUTTON_STATE_HELD, 3));
+    CHECK(num_deferred == 0);
+
+    CHECK(headset_button_trace_hist_get(HEADSET_BUTTON_TRACE_STAGE_DISPATCH)->count == 1);
+    CHECK(headset_button_trace_hist_get(HEADSET_BUTTON_TRACE_STAGE_ACTION)->count == 0);
+}
+
+/* The timeline is reported once the buttons are idle */
+static void test_report(void)
+{
+    setup();
+
+    stub_trace_hook = trace_hook;
+    gpio_lines = 0;
+
+    app_buttons[PLAY_PAUSE_BUTTON].released_timestamp = stub_time_us() / 1000;
+    CHECK(config.p_pre_handler(PLAY_PAUSE_BUTTON, BUTTON_CLICK_EVENT, BUTTON_STATE_RELEASED, 0));
+    defer_run();
+    CHECK(gpio_lines == 0);
+
+    stub_time_advance_ms(HEADSET_BUTTON_TRACE_REPORT_IDLE);
+    CHECK(gpio_lines == 1);
+}
+
+int main(void)
+{
+    RUN(test_release);
+    RUN(test_hold);
+    RUN(test_unmapped);
+    RUN(test_report);
+
+    return 0;
+}
@@ -0,0 +1,529 @@
+/******************************************************************************
+* File Name:   test_control_le.c
+*
+* Description: Host test of the LE control: Fast Pair appended advertising element,
+*              OTA write commands and transfer statistics.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "bt_hs_spk_control.h"
+#include "headset_adv_sched.h"
+#include "headset_control_le.h"
+#include "headset_le_conn_param.h"
+#include "headset_nvram.h"
+#include "headset_power.h"
+#include "test.h"
+#include "wiced_app_cfg.h"
+#include "wiced_bt_gatt.h"
+#include "wiced_bt_gfps.h"
+#include "wiced_bt_ota_firmware_upgrade.h"
+#include "wiced_bt_trace.h"
+#include "wiced_memory.h"
+#include "wiced_timer.h"
+
+#define LE_NAME                     WICED_DEVICE_NAME " LE"
+
+#define CONN_ID                     3
+
+/* Image data per write command with a 512 byte MTU */
+#define OTA_PACKET_LEN              509
+
+/* Model keys of the product build */
+const uint8_t anti_spoofing_public_key[WICED_BT_GFPS_ANTI_SPOOFING_KEY_LEN_PUBLIC]     = { 0x5a };
+const uint8_t anti_spoofing_private_key[WICED_BT_GFPS_ANTI_SPOOFING_KEY_LEN_PRIVATE]   = { 0xa5 };
+
+static const wiced_bt_cfg_ble_t ble_cfg = { .ble_max_rx_pdu_size = 512 };
+const wiced_bt_cfg_settings_t wiced_bt_cfg_settings = { .p_ble_cfg = &ble_cfg };
+
+/* What the module handed to the stack and the other modules */
+static struct
+{
+    wiced_bool_t                                provider_ok;
+    uint32_t                                    provider_inits;
+    wiced_bt_gfps_provider_conf_t               conf;
+    bt_hs_spk_ble_discoverability_change_cb_t   *p_discoverability_cb;
+    uint32_t                                    adv_sched_enables;
+    uint32_t                                    buffers;
+    uint8_t                                     le_load;
+    uint8_t                                     adv_state;
+    uint8_t                                     power_input;
+    wiced_bool_t                                gfps_discoverable;
+    uint8_t                                     *p_read;
+    uint16_t                                    read_len;
+    uint32_t                                    error_rsps;
+    wiced_bt_gatt_status_t                      error_status;
+    uint32_t                                    write_rsps;
+    uint16_t                                    local_mtu;
+    wiced_bt_gatt_status_t                      ota_status;
+    uint32_t                                    ota_writes;
+    uint32_t                                    ota_bytes;
+    uint32_t                                    ota_link_events;
+    uint8_t                                     tx_phy;
+    char                                        ota_trace[128];
+} fake;
+
+wiced_bool_t wiced_ota_fw_upgrade_is_gatt_handle(uint16_t handle)
+{
+    return (handle >= HANDLE_OTA_FW_UPGRADE_SERVICE) && (handle <= HANDLE_OTA_FW_UPGRADE_DATA);
+}
+
+void wiced_ota_fw_upgrade_connection_status_event(wiced_bt_gatt_connection_status_t *p_status)
+{
+    fake.ota_link_events++;
+}
+
+wiced_bt_gatt_status_t wiced_ota_fw_upgrade_read_handler(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                         wiced_bt_gatt_read_t *p_read_data, uint16_t len_requested)
+{
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_ota_fw_upgrade_write_handler(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                          wiced_bt_gatt_write_req_t *p_write_data)
+{
+    fake.ota_writes++;
+    fake.ota_bytes += p_write_data->val_len;
+
+    return fake.ota_status;
+}
+
+wiced_bt_gatt_status_t wiced_ota_fw_upgrade_indication_cfm_handler(uint16_t conn_id, uint16_t handle)
+{
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bool_t wiced_bt_gfps_provider_init(wiced_bt_gfps_provider_conf_t *p_conf)
+{
+    fake.provider_inits++;
+    fake.conf = *p_conf;
+
+    return fake.provider_ok;
+}
+
+void wiced_bt_gfps_provider_discoverablility_set(wiced_bool_t discoverable)
+{
+    fake.gfps_discoverable = discoverable;
+}
+
+void bt_hs_spk_ble_discoverability_change_callback_register(bt_hs_spk_ble_discoverability_change_cb_t *p_cb)
+{
+    fake.p_discoverability_cb = p_cb;
+}
+
+void headset_adv_sched_enable(void)
+{
+    fake.adv_sched_enables++;
+}
+
+void headset_adv_sched_state_set(uint8_t state, wiced_bool_t set)
+{
+    fake.adv_state = set ? (fake.adv_state | state) : (fake.adv_state & ~state);
+}
+
+void headset_le_conn_param_load_set(uint8_t load, wiced_bool_t active)
+{
+    fake.le_load = active ? (fake.le_load | load) : (fake.le_load & ~load);
+}
+
+void headset_le_conn_param_link_up(wiced_bt_device_address_t bd_addr)
+{
+}
+
+void headset_le_conn_param_link_down(void)
+{
+}
+
+uint8_t headset_le_conn_param_tx_phy_get(void)
+{
+    return fake.tx_phy;
+}
+
+void headset_power_input_set(uint8_t input, wiced_bool_t set)
+{
+    fake.power_input = set ? (fake.power_input | input) : (fake.power_input & ~input);
+}
+
+void wiced_bt_dev_set_no_smp_on_br(wiced_bool_t no_smp_on_br)
+{
+}
+
+void *wiced_bt_get_buffer(uint32_t size)
+{
+    fake.buffers++;
+
+    return malloc(size);
+}
+
+void wiced_bt_free_buffer(void *p_buf)
+{
+    free(p_buf);
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_db_init(const uint8_t *p_gatt_db, uint16_t len, wiced_bt_db_hash_t hash)
+{
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_register(wiced_bt_gatt_cback_t *p_gatt_cback)
+{
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_mtu_rsp(uint16_t conn_id, uint16_t remote_mtu, uint16_t local_mtu)
+{
+    fake.local_mtu = local_mtu;
+
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_write_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                           uint16_t handle)
+{
+    fake.write_rsps++;
+
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_error_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                           uint16_t handle, wiced_bt_gatt_status_t status)
+{
+    fake.error_rsps++;
+    fake.error_status = status;
+
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_handle_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                 uint16_t len, uint8_t *p_attr,
+                                                                 wiced_bt_gatt_app_context_t p_app_ctxt)
+{
+    fake.p_read     = p_attr;
+    fake.read_len   = len;
+
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_by_type_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                  uint8_t type_len, uint16_t data_len,
+                                                                  uint8_t *p_data,
+                                                                  wiced_bt_gatt_app_context_t p_app_ctxt)
+{
+    return WICED_BT_GATT_SUCCESS;
+}
+
+wiced_bt_gatt_status_t wiced_bt_gatt_server_send_read_multiple_rsp(uint16_t conn_id, wiced_bt_gatt_opcode_t opcode,
+                                                                   uint16_t data_len, uint8_t *p_data,
+                                                                   wiced_bt_gatt_app_context_t p_app_ctxt)
+{
+    return WICED_BT_GATT_SUCCESS;
+}
+
+uint16_t wiced_bt_gatt_find_handle_by_type(uint16_t s_handle, uint16_t e_handle, wiced_bt_uuid_t *p_uuid)
+{
+    return 0;
+}
+
+uint16_t wiced_bt_gatt_get_handle_from_stream(uint8_t *p_handle_stream, uint16_t num_handle)
+{
+    return 0;
+}
+
+int wiced_bt_gatt_put_read_by_type_rsp_in_stream(uint8_t *p_stream, int stream_len, uint8_t *p_pair_len,
+                                                 uint16_t n_handle, uint16_t n_len, uint8_t *p_data)
+{
+    return 0;
+}
+
+int wiced_bt_gatt_put_read_multi_rsp_in_stream(wiced_bt_gatt_opcode_t opcode, uint8_t *p_stream,
+                                               int stream_len, uint16_t n_handle, uint16_t n_len,
+                                               uint8_t *p_data)
+{
+    return 0;
+}
+
+static void enable(wiced_bool_t provider_ok)
+{
+    memset(&fake, 0, sizeof(fake));
+    fake.provider_ok = provider_ok;
+
+    hci_control_le_enable();
+}
+
+/* Read an attribute through the GATT callback given to the Fast Pair provider */
+static wiced_bt_gatt_status_t read(uint16_t handle, uint16_t offset)
+{
+    wiced_bt_gatt_event_data_t data;
+
+    memset(&data, 0, sizeof(data));
+    data.attribute_request.conn_id                  = CONN_ID;
+    data.attribute_request.opcode                   = GATT_REQ_READ;
+    data.attribute_request.data.read_req.handle     = handle;
+    data.attribute_request.data.read_req.offset     = offset;
+    data.attribute_request.len_requested            = 100;
+
+    fake.p_read = NULL;
+
+    return fake.conf.p_gatt_cb(GATT_ATTRIBUTE_REQUEST_EVT, &data);
+}
+
+/* Write to an attribute through the GATT callback */
+static wiced_bt_gatt_status_t write(wiced_bt_gatt_opcode_t opcode, uint16_t handle, uint16_t len)
+{
+    static uint8_t value[OTA_PACKET_LEN];
+    wiced_bt_gatt_event_data_t data;
+
+    memset(&data, 0, sizeof(data));
+    data.attribute_request.conn_id                  = CONN_ID;
+    data.attribute_request.opcode                   = opcode;
+    data.attribute_request.data.write_req.handle    = handle;
+    data.attribute_request.data.write_req.val_len   = len;
+    data.attribute_request.data.write_req.p_val     = value;
+
+    return fake.conf.p_gatt_cb(GATT_ATTRIBUTE_REQUEST_EVT, &data);
+}
+
+static void link_set(wiced_bool_t connected)
+{
+    static uint8_t bd_addr[BD_ADDR_LEN] = { 0x20, 0x70, 0x6a, 0x01, 0x02, 0x03 };
+    wiced_bt_gatt_event_data_t data;
+
+    memset(&data, 0, sizeof(data));
+    data.connection_status.bd_addr      = bd_addr;
+    data.connection_status.conn_id      = CONN_ID;
+    data.connection_status.connected    = connected;
+
+    fake.conf.p_gatt_cb(GATT_CONNECTION_STATUS_EVT, &data);
+}
+
+static void ota_trace_hook(const char *p_line)
+{
+    if (strncmp(p_line, "ota: ", 5) == 0)
+    {
+        snprintf(fake.ota_trace, sizeof(fake.ota_trace), "%s", p_line);
+    }
+}
+
+/* The appended element is the static complete LE name, the provider gets the build time settings */
+static void test_adv_elem(void)
+{
+    const wiced_bt_ble_advert_elem_t *p_elem;
+
+    enable(WICED_TRUE);
+
+    CHECK(fake.provider_inits == 1);
+    CHECK(fake.conf.appended_adv_data.elem_num == 1);
+
+    p_elem = fake.conf.appended_adv_data.p_elem;
+    CHECK(p_elem != NULL);
+    CHECK(p_elem->advert_type == BTM_BLE_ADVERT_TYPE_NAME_COMPLETE);
+    CHECK(p_elem->len == strlen(LE_NAME));
+    CHECK(memcmp(p_elem->p_data, LE_NAME, p_elem->len) == 0);
+
+    CHECK(fake.conf.model_id == FASTPAIR_MODEL_ID);
+    CHECK(fake.conf.account_key_list_size == FASTPAIR_ACCOUNT_KEY_NUM);
+    CHECK(fake.conf.account_key_list_nvram_id == HEADSET_NVRAM_ID_GFPS_ACCOUNT_KEY);
+    CHECK(memcmp(fake.conf.anti_spoofing_key.public, anti_spoofing_public_key, sizeof(anti_spoofing_public_key)) == 0);
+    CHECK(memcmp(fake.conf.anti_spoofing_key.private, anti_spoofing_private_key, sizeof(anti_spoofing_private_key)) == 0);
+
+    CHECK(fake.adv_sched_enables == 1);
+    CHECK(fake.p_discoverability_cb != NULL);
+
+    /* Enabling again hands over the same element, nothing comes from the heap */
+    enable(WICED_TRUE);
+
+    CHECK(fake.conf.appended_adv_data.p_elem == p_elem);
+    CHECK(fake.buffers == 0);
+}
+
+/* The advertised name is the GATT device name attribute, without its NUL */
+static void test_adv_elem_gatt_name(void)
+{
+    const wiced_bt_ble_advert_elem_t *p_elem;
+
+    enable(WICED_TRUE);
+    p_elem = fake.conf.appended_adv_data.p_elem;
+
+    CHECK(read(HANDLE_HSENS_GAP_SERVICE_CHAR_DEV_NAME_VAL, 0) == WICED_BT_GATT_SUCCESS);
+    CHECK(fake.p_read == p_elem->p_data);
+    CHECK(fake.read_len == sizeof(LE_NAME));
+    CHECK(memcmp(fake.p_read, LE_NAME, sizeof(LE_NAME)) == 0);
+
+    CHECK(read(HANDLE_HSENS_GAP_SERVICE_CHAR_DEV_NAME_VAL, sizeof(LE_NAME)) == WICED_BT_GATT_INVALID_OFFSET);
+    CHECK(fake.error_rsps == 1);
+}
+
+/* Without the provider the advertising scheduler stays off */
+static void test_provider_fail(void)
+{
+    enable(WICED_FALSE);
+
+    CHECK(fake.provider_inits == 1);
+    CHECK(fake.adv_sched_enables == 0);
+    CHECK(fake.buffers == 0);
+}
+
+/* Pairing mode reaches the provider, the LE link policy, the advertising scheduler and the power states */
+static void test_discoverability(void)
+{
+    enable(WICED_TRUE);
+
+    fake.p_discoverability_cb(WICED_TRUE);
+
+    CHECK(fake.gfps_discoverable == WICED_TRUE);
+    CHECK(fake.le_load == HEADSET_LE_CONN_PARAM_LOAD_FASTPAIR);
+    CHECK(fake.adv_state == HEADSET_ADV_SCHED_STATE_DISCOVERABLE);
+    CHECK(fake.power_input == HEADSET_POWER_INPUT_DISCOVERABLE);
+
+    fake.p_discoverability_cb(WICED_FALSE);
+
+    CHECK(fake.gfps_discoverable == WICED_FALSE);
+    CHECK((fake.le_load == 0) && (fake.adv_state == 0) && (fake.power_input == 0));
+}
+
+/* Write commands reach the OTA library and are never answered, write requests are */
+static void test_ota_write_cmd(void)
+{
+    enable(WICED_TRUE);
+
+    CHECK(write(GATT_CMD_WRITE, HANDLE_OTA_FW_UPGRADE_DATA, OTA_PACKET_LEN) == WICED_BT_GATT_SUCCESS);
+    CHECK((fake.ota_writes == 1) && (fake.ota_bytes == OTA_PACKET_LEN));
+    CHECK((fake.write_rsps == 0) && (fake.error_rsps == 0));
+    CHECK(fake.le_load == HEADSET_LE_CONN_PARAM_LOAD_OTA);
+
+    /* Not even on error */
+    fake.ota_status = WICED_BT_GATT_WRITE_NOT_PERMIT;
+    CHECK(write(GATT_CMD_WRITE, HANDLE_OTA_FW_UPGRADE_DATA, OTA_PACKET_LEN) == WICED_BT_GATT_WRITE_NOT_PERMIT);
+    CHECK(write(GATT_CMD_SIGNED_WRITE, HANDLE_OTA_FW_UPGRADE_DATA, OTA_PACKET_LEN) == WICED_BT_GATT_WRITE_NOT_PERMIT);
+    CHECK((fake.write_rsps == 0) && (fake.error_rsps == 0));
+
+    /* The control point uses write requests */
+    CHECK(write(GATT_REQ_WRITE, HANDLE_OTA_FW_UPGRADE_CONTROL_POINT, 1) == WICED_BT_GATT_WRITE_NOT_PERMIT);
+    CHECK((fake.error_rsps == 1) && (fake.error_status == WICED_BT_GATT_WRITE_NOT_PERMIT));
+
+    fake.ota_status = WICED_BT_GATT_SUCCESS;
+    CHECK(write(GATT_REQ_WRITE, HANDLE_OTA_FW_UPGRADE_CONTROL_POINT, 1) == WICED_BT_GATT_SUCCESS);
+    CHECK((fake.write_rsps == 1) && (fake.error_rsps == 1));
+
+    /* Other attributes are answered as before */
+    CHECK(write(GATT_REQ_WRITE, HANDLE_HSENS_BATTERY_SERVICE_CHAR_LEVEL_VAL, 1) == WICED_BT_GATT_SUCCESS);
+    CHECK(fake.write_rsps == 2);
+    CHECK(fake.ota_writes == 5);
+
+    /* End the link, its statistics go with it */
+    link_set(WICED_FALSE);
+}
+
+/* The MTU response offers the configured LE receive PDU size */
+static void test_mtu(void)
+{
+    wiced_bt_gatt_event_data_t data;
+
+    enable(WICED_TRUE);
+
+    memset(&data, 0, sizeof(data));
+    data.attribute_request.conn_id          = CONN_ID;
+    data.attribute_request.opcode           = GATT_REQ_MTU;
+    data.attribute_request.data.remote_mtu  = 517;
+
+    CHECK(fake.conf.p_gatt_cb(GATT_ATTRIBUTE_REQUEST_EVT, &data) == WICED_BT_GATT_SUCCESS);
+    CHECK(fake.local_mtu == ble_cfg.ble_max_rx_pdu_size);
+}
+
+/*
+ * Data packets of the link are counted from the first to the last one and traced at link down,
+ * with the MTU and PHY of the link
+ */
+static void test_ota_stats(void)
+{
+    wiced_bt_gatt_event_data_t data;
+    uint32_t i;
+
+    enable(WICED_TRUE);
+    stub_trace_hook = ota_trace_hook;
+
+    link_set(WICED_TRUE);
+
+    /* The peer asks for more than offered, and moves to 2M */
+    memset(&data, 0, sizeof(data));
+    data.attribute_request.conn_id          = CONN_ID;
+    data.attribute_request.opcode           = GATT_REQ_MTU;
+    data.attribute_request.data.remote_mtu  = 517;
+    CHECK(fake.conf.p_gatt_cb(GATT_ATTRIBUTE_REQUEST_EVT, &data) == WICED_BT_GATT_SUCCESS);
+    fake.tx_phy = 2;
+
+    /* Control point traffic does not count */
+    write(GATT_REQ_WRITE, HANDLE_OTA_FW_UPGRADE_CONTROL_POINT, 1);
+    stub_time_advance_ms(50);
+
+    for (i = 0; i < 100; i++)
+    {
+        write(GATT_CMD_WRITE, HANDLE_OTA_FW_UPGRADE_DATA, OTA_PACKET_LEN);
+        stub_time_advance_ms(2);
+    }
+
+    link_set(WICED_FALSE);
+
+    CHECK(fake.ota_link_events == 2);
+    CHECK(strcmp(fake.ota_trace, "ota: 50900 bytes in 100 packets, 198 ms, 257 kB/s, MTU 512, 2M PHY\n") == 0);
+
+    /* Reset with the link: the next link reports only its own transfer, a link without data reports nothing */
+    fake.ota_trace[0] = '\0';
+    link_set(WICED_TRUE);
+    link_set(WICED_FALSE);
+    CHECK(fake.ota_trace[0] == '\0');
+
+    /* No MTU exchange on 1M */
+    fake.tx_phy = 1;
+    link_set(WICED_TRUE);
+    write(GATT_CMD_WRITE, HANDLE_OTA_FW_UPGRADE_DATA, 100);
+    link_set(WICED_FALSE);
+    CHECK(strcmp(fake.ota_trace, "ota: 100 bytes in 1 packets, 0 ms, 0 kB/s, MTU 23, 1M PHY\n") == 0);
+}
+
+int main(void)
+{
+    RUN(test_adv_elem);
+    RUN(test_adv_elem_gatt_name);
+    RUN(test_provider_fail);
+    RUN(test_discoverability);
+    RUN(test_ota_write_cmd);
+    RUN(test_mtu);
+    RUN(test_ota_stats);
+
+    return 0;
+}
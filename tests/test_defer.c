@@ -0,0 +1,253 @@
+/******************************************************************************
+* File Name:   test_defer.c
+*
+* Description: Host test of the deferred work queue: priority and queue order, concurrent producers and the enqueue cost.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#include "headset_defer.h"
+#include "test.h"
+#include "wiced_bt_trace.h"
+#include "wiced_timer.h"
+
+#define PRODUCERS           4
+#define PRODUCER_ITEMS      20000
+#define BENCH_ROUNDS        100000
+
+/* The argument of an item: producer in the high bits, sequence number in the low ones */
+#define ITEM(producer, seq) ((void *) (uintptr_t) (((producer) << 24) | (seq)))
+
+static char         order[16];
+static uint32_t     num_order;
+
+static uint32_t     next_seq[PRODUCERS];
+static uint32_t     num_run;
+static uint32_t     out_of_order;
+static uint32_t     max_depth[HEADSET_DEFER_PRIORITY_NUM];
+
+static void record(void *p_arg)
+{
+    order[num_order++] = (char) (uintptr_t) p_arg;
+}
+
+static void producer_item(void *p_arg)
+{
+    uint32_t producer = (uint32_t) (uintptr_t) p_arg >> 24;
+    uint32_t seq = (uint32_t) (uintptr_t) p_arg & 0xffffff;
+
+    if (seq != next_seq[producer])
+    {
+        out_of_order++;
+    }
+
+    next_seq[producer] = seq + 1;
+    num_run++;
+}
+
+static void nothing(void *p_arg)
+{
+}
+
+static void stats_hook(const char *p_line)
+{
+    uint32_t priority, run, depth, dropped;
+
+    if ((sscanf(p_line, "headset_defer: priority %u run %u max depth %u dropped %u",
+                &priority, &run, &depth, &dropped) == 4) &&
+        (priority < HEADSET_DEFER_PRIORITY_NUM))
+    {
+        max_depth[priority] = depth;
+    }
+}
+
+static void *producer_thread(void *p_arg)
+{
+    uint32_t producer = (uint32_t) (uintptr_t) p_arg;
+    headset_defer_priority_t priority = (headset_defer_priority_t) (producer % HEADSET_DEFER_PRIORITY_NUM);
+    uint32_t seq;
+
+    for (seq = 0; seq < PRODUCER_ITEMS; seq++)
+    {
+        while (headset_defer(priority, producer_item, ITEM(producer, seq)) != WICED_BT_SUCCESS)
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/* Run the queued work, one drain pass per simulated ms */
+static void drain(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < 1000; i++)
+    {
+        stub_time_advance_ms(1);
+    }
+}
+
+/* Work queued before init is kept and runs by priority, then in queue order. Runs first. */
+static void test_order(void)
+{
+    num_order = 0;
+    memset(order, 0, sizeof(order));
+
+    CHECK(headset_defer(HEADSET_DEFER_PRIORITY_LOW, record, (void *) 'l') == WICED_BT_SUCCESS);
+    CHECK(headset_defer(HEADSET_DEFER_PRIORITY_NORMAL, record, (void *) 'n') == WICED_BT_SUCCESS);
+    CHECK(headset_defer(HEADSET_DEFER_PRIORITY_HIGH, record, (void *) 'a') == WICED_BT_SUCCESS);
+    CHECK(headset_defer(HEADSET_DEFER_PRIORITY_LOW, record, (void *) 'm') == WICED_BT_SUCCESS);
+    CHECK(headset_defer(HEADSET_DEFER_PRIORITY_HIGH, record, (void *) 'b') == WICED_BT_SUCCESS);
+
+    /* Nothing runs before init */
+    drain();
+    CHECK(num_order == 0);
+
+    headset_defer_init();
+
+    /* One batch per pass */
+    stub_time_advance_ms(1);
+    CHECK(num_order == HEADSET_DEFER_BATCH);
+
+    drain();
+    CHECK(strcmp(order, "abnlm") == 0);
+}
+
+/* A full queue refuses the item and keeps the queued ones */
+static void test_full(void)
+{
+    uint32_t i;
+
+    headset_defer_init();
+
+    num_order = 0;
+    memset(order, 0, sizeof(order));
+
+    for (i = 0; i < HEADSET_DEFER_QUEUE_SIZE; i++)
+    {
+        CHECK(headset_defer(HEADSET_DEFER_PRIORITY_NORMAL, record, (void *) (uintptr_t) ('a' + i)) == WICED_BT_SUCCESS);
+    }
+
+    CHECK(headset_defer(HEADSET_DEFER_PRIORITY_NORMAL, record, (void *) 'z') == WICED_BT_NO_RESOURCES);
+    CHECK(headset_defer(HEADSET_DEFER_PRIORITY_NUM, record, NULL) == WICED_BT_BADARG);
+    CHECK(headset_defer(HEADSET_DEFER_PRIORITY_NORMAL, NULL, NULL) == WICED_BT_BADARG);
+
+    drain();
+    CHECK(strcmp(order, "abcdefgh") == 0);
+}
+
+/* Producer threads against the drain: every item runs, each producer's items in order */
+static void test_producers(void)
+{
+    pthread_t thread[PRODUCERS];
+    uint32_t i;
+
+    headset_defer_init();
+
+    for (i = 0; i < PRODUCERS; i++)
+    {
+        CHECK(pthread_create(&thread[i], NULL, producer_thread, (void *) (uintptr_t) i) == 0);
+    }
+
+    /* Let the producers in, the host may have a single core. */
+    while (__atomic_load_n(&num_run, __ATOMIC_RELAXED) < PRODUCERS * PRODUCER_ITEMS)
+    {
+        stub_time_advance_ms(1);
+        sched_yield();
+    }
+
+    for (i = 0; i < PRODUCERS; i++)
+    {
+        pthread_join(thread[i], NULL);
+    }
+
+    drain();
+
+    CHECK(num_run == PRODUCERS * PRODUCER_ITEMS);
+    CHECK(out_of_order == 0);
+
+    for (i = 0; i < PRODUCERS; i++)
+    {
+        CHECK(next_seq[i] == PRODUCER_ITEMS);
+    }
+
+    /* The high-water mark raced between the producers of a priority stays within the queue */
+    stub_trace_hook = stats_hook;
+    headset_defer_stats_report();
+    for (i = 0; i < HEADSET_DEFER_PRIORITY_NUM; i++)
+    {
+        CHECK((max_depth[i] >= 1) && (max_depth[i] <= HEADSET_DEFER_QUEUE_SIZE));
+    }
+}
+
+static void bench(void)
+{
+    uint64_t start, enqueue_ns = 0;
+    uint32_t i, j;
+
+    headset_defer_init();
+
+    for (i = 0; i < BENCH_ROUNDS; i++)
+    {
+        start = test_clock_ns();
+        for (j = 0; j < HEADSET_DEFER_QUEUE_SIZE; j++)
+        {
+            headset_defer(HEADSET_DEFER_PRIORITY_NORMAL, nothing, NULL);
+        }
+        enqueue_ns += test_clock_ns() - start;
+
+        stub_time_advance_ms(HEADSET_DEFER_QUEUE_SIZE / HEADSET_DEFER_BATCH);
+    }
+
+    printf("    enqueue %u.%u ns (host, one producer)\n",
+           (uint32_t) (enqueue_ns * 10 / (BENCH_ROUNDS * HEADSET_DEFER_QUEUE_SIZE)) / 10,
+           (uint32_t) (enqueue_ns * 10 / (BENCH_ROUNDS * HEADSET_DEFER_QUEUE_SIZE)) % 10);
+}
+
+int main(void)
+{
+    RUN(test_order);
+    RUN(test_full);
+    RUN(test_producers);
+    RUN(bench);
+
+    return 0;
+}
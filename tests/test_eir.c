@@ -0,0 +1,268 @@
+/******************************************************************************
+* File Name:   test_eir.c
+*
+* Description: Host test of the EIR: UUID list of wiced_app_cfg.c against its SDP records and the EIR written for each name.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "headset_eir.h"
+#include "test.h"
+#include "wiced_app_cfg.h"
+#include "wiced_bt_dev.h"
+#include "wiced_bt_sdp.h"
+#include "wiced_bt_trace.h"
+#include "wiced_memory.h"
+
+/* SDP data element headers */
+#define SDP_UINT16  ((UINT_DESC_TYPE << 3) | SIZE_TWO_BYTES)
+#define SDP_UUID16  ((UUID_DESC_TYPE << 3) | SIZE_TWO_BYTES)
+
+/* The records of wiced_app_cfg.c */
+extern const uint8_t btheadset_sdp_db[];
+
+static uint8_t  write_eir[WICED_APP_CFG_EIR_MAX];
+static uint8_t *p_write;
+static uint16_t write_len;
+static uint32_t buffers;
+static uint32_t builds;
+
+wiced_result_t wiced_bt_dev_write_eir(uint8_t *p_buff, uint16_t len)
+{
+    CHECK(len <= sizeof(write_eir));
+
+    memcpy(write_eir, p_buff, len);
+    p_write     = p_buff;
+    write_len   = len;
+
+    return WICED_BT_SUCCESS;
+}
+
+void *wiced_bt_get_buffer(uint32_t size)
+{
+    static uint8_t buffer[WICED_APP_CFG_EIR_MAX];
+
+    CHECK(size <= sizeof(buffer));
+    buffers++;
+
+    return buffer;
+}
+
+static void trace_hook(const char *p_line)
+{
+    if (strstr(p_line, "headset_eir: built for"))
+    {
+        builds++;
+    }
+}
+
+/*
+ * SDP data element at p: the element must fit before p_end. Return its data, its length in *p_len.
+ */
+static const uint8_t *sdp_element(const uint8_t *p, const uint8_t *p_end, uint32_t *p_len)
+{
+    static const uint8_t fixed_len[5] = { 1, 2, 4, 8, 16 };
+    uint8_t size_index;
+    uint8_t len_bytes = 0;
+    uint32_t len = 0;
+
+    CHECK(p < p_end);
+    size_index = *p & 0x07;
+
+    if (size_index < 5)
+    {
+        len = fixed_len[size_index];
+    }
+    else
+    {
+        len_bytes = 1 << (size_index - 5);
+    }
+
+    for (p++; len_bytes > 0; len_bytes--)
+    {
+        CHECK(p < p_end);
+        len = (len << 8) | *p++;
+    }
+
+    CHECK(len <= (uint32_t) (p_end - p));
+    *p_len = len;
+
+    return p;
+}
+
+/*
+ * EIR decoder: the elements must exactly fill the EIR. Return the value of the element of
+ * the given type and its length, NULL if there is none.
+ */
+static const uint8_t *eir_find(const uint8_t *p_eir, uint16_t len, uint8_t type, uint8_t *p_len)
+{
+    const uint8_t *p_found = NULL;
+    uint16_t i = 0;
+
+    while (i < len)
+    {
+        CHECK(p_eir[i] != 0);
+        CHECK(i + 1 + p_eir[i] <= len);
+
+        if (p_eir[i + 1] == type)
+        {
+            p_found = &p_eir[i + 2];
+            *p_len  = p_eir[i] - 1;
+        }
+
+        i += 1 + p_eir[i];
+    }
+
+    CHECK(i == len);
+
+    return p_found;
+}
+
+/* The EIR list holds the 16-bit service classes of every record of btheadset_sdp_db, in record order */
+static void test_uuid_list(void)
+{
+    const uint8_t *p_records, *p_records_end;
+    const uint8_t *p_attr, *p_attr_end;
+    const uint8_t *p_id, *p_value, *p_class, *p_class_end;
+    uint32_t len;
+    uint16_t num = 0;
+    uint8_t records = 0;
+
+    p_records = sdp_element(btheadset_sdp_db, &btheadset_sdp_db[wiced_app_cfg_sdp_record_get_size()], &len);
+    CHECK(p_records + len == &btheadset_sdp_db[wiced_app_cfg_sdp_record_get_size()]);
+
+    for (p_records_end = p_records + len; p_records < p_records_end; p_records = p_attr_end, records++)
+    {
+        /* Record: attribute ID, value, attribute ID, value, ... */
+        p_attr      = sdp_element(p_records, p_records_end, &len);
+        p_attr_end  = p_attr + len;
+
+        while (p_attr < p_attr_end)
+        {
+            p_id    = p_attr;
+            p_value = sdp_element(p_id, p_attr_end, &len) + len;
+            p_class = sdp_element(p_value, p_attr_end, &len);
+            p_attr  = p_class + len;
+
+            CHECK(p_id[0] == SDP_UINT16);
+
+            if (((p_id[1] << 8) | p_id[2]) != ATTR_ID_SERVICE_CLASS_ID_LIST)
+            {
+                continue;
+            }
+
+            CHECK(p_value[0] >> 3 == DATA_ELE_SEQ_DESC_TYPE);
+
+            for (p_class_end = p_attr; p_class < p_class_end; p_class += 3)
+            {
+                /* SDP is big endian, EIR little endian */
+                CHECK(p_class[0] == SDP_UUID16);
+                CHECK(num + 2u <= sizeof(btheadset_eir.uuid));
+                CHECK((btheadset_eir.uuid[num] == p_class[2]) && (btheadset_eir.uuid[num + 1] == p_class[1]));
+                num += 2;
+            }
+        }
+    }
+
+    CHECK(records == 5);
+    CHECK(num == sizeof(btheadset_eir.uuid));
+}
+
+/* The build time name writes the compile time EIR as is */
+static void test_write_default(void)
+{
+    const uint8_t *p_value;
+    uint8_t len;
+
+    buffers = 0;
+
+    CHECK(headset_eir_write(WICED_DEVICE_NAME) == WICED_BT_SUCCESS);
+    CHECK(p_write == (const uint8_t *) &btheadset_eir);
+    CHECK(buffers == 0);
+
+    p_value = eir_find(write_eir, write_len, BTM_EIR_COMPLETE_LOCAL_NAME_TYPE, &len);
+    CHECK((p_value != NULL) && (len == strlen(WICED_DEVICE_NAME)) && (memcmp(p_value, WICED_DEVICE_NAME, len) == 0));
+
+    p_value = eir_find(write_eir, write_len, BTM_EIR_COMPLETE_16BITS_UUID_TYPE, &len);
+    CHECK((p_value != NULL) && (len == sizeof(btheadset_eir.uuid)));
+}
+
+/* Another name is built once into a buffer, an over long name is shortened */
+static void test_write_renamed(void)
+{
+    char name[300];
+    const uint8_t *p_value;
+    uint8_t len;
+
+    stub_trace_hook = trace_hook;
+    buffers = 0;
+    builds  = 0;
+
+    CHECK(headset_eir_write("Kitchen speaker") == WICED_BT_SUCCESS);
+    CHECK(headset_eir_write("Kitchen speaker") == WICED_BT_SUCCESS);
+    CHECK((buffers == 1) && (builds == 1));
+
+    p_value = eir_find(write_eir, write_len, BTM_EIR_COMPLETE_LOCAL_NAME_TYPE, &len);
+    CHECK((p_value != NULL) && (len == 15) && (memcmp(p_value, "Kitchen speaker", 15) == 0));
+
+    p_value = eir_find(write_eir, write_len, BTM_EIR_COMPLETE_16BITS_UUID_TYPE, &len);
+    CHECK((p_value != NULL) && (len == sizeof(btheadset_eir.uuid)));
+    CHECK(memcmp(p_value, btheadset_eir.uuid, len) == 0);
+
+    memset(name, 'n', sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+
+    CHECK(headset_eir_write(name) == WICED_BT_SUCCESS);
+    CHECK((buffers == 1) && (builds == 2));
+    CHECK(write_len == WICED_APP_CFG_EIR_MAX);
+    CHECK(eir_find(write_eir, write_len, BTM_EIR_COMPLETE_LOCAL_NAME_TYPE, &len) == NULL);
+    CHECK(eir_find(write_eir, write_len, BTM_EIR_SHORTENED_LOCAL_NAME_TYPE, &len) != NULL);
+    CHECK(eir_find(write_eir, write_len, BTM_EIR_COMPLETE_16BITS_UUID_TYPE, &len) != NULL);
+
+    /* Back to the build time name */
+    CHECK(headset_eir_write(WICED_DEVICE_NAME) == WICED_BT_SUCCESS);
+    CHECK(p_write == (const uint8_t *) &btheadset_eir);
+}
+
+int main(void)
+{
+    RUN(test_uuid_list);
+    RUN(test_write_default);
+    RUN(test_write_renamed);
+
+    return 0;
+}
@@ -0,0 +1,221 @@
+/******************************************************************************
+* File Name:   test_gfps_crypto.c
+*
+* Description: Host test and benchmark of the Fast Pair P-256 ECDH and AES-128.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "headset_gfps_crypto.h"
+#include "test.h"
+
+#define BENCH_ECDH          50
+#define BENCH_AES_BLOCKS    100000
+
+typedef struct
+{
+    const char  *private_key;
+    const char  *shared;
+} ecdh_vector_t;
+
+/* NIST CAVS ECC CDH primitive, P-256 count 0 */
+static const char nist_peer[] =
+    "700c48f77f56584c5cc632ca65640db91b6bacce3a4df6b42ce7cc838833d287"
+    "db71e509e3fd9b060ddb20ba5c51dcc5948d46fbf640dfe0441782cab85fa4ac";
+static const char nist_private[]    = "7d7dc5f71eb29ddaf80d6214632eeae03d9058af1fb6d22ed80badb62bc1a534";
+static const char nist_shared[]     = "46fc62106420ff012e54a434fbdd2d25ccc5852060561e68040dd7778997bd7b";
+
+/* Peer key 0x1234567890abcdef * G, shared secrets from an affine Python reference */
+static const char peer[] =
+    "9fad84aeae08bbef7f010014d82cef6a09de2b0cf871b5ce0c4f1d13a59a5934"
+    "07cb45769f1070e2c2470fe5b1bfe63133c0b0cdc64ea4bf3791a8ec2a07fd4f";
+
+static const ecdh_vector_t vectors[] =
+{
+    { "0000000000000000000000000000000000000000000000000000000000000001",
+      "9fad84aeae08bbef7f010014d82cef6a09de2b0cf871b5ce0c4f1d13a59a5934" },
+    { "0000000000000000000000000000000000000000000000000000000000000002",
+      "b3d44b21c45ce2d9f3165252dec93b017ba6f2fd35b1b4422314d9924a37b636" },
+    { "000000000000000000000000000000000000000000000000000000000000000f",
+      "e6aa946f8ada7687f0d942df51dde78a58073bdca3599d206f5243dacde9ced5" },
+    { "0000000000000000000000000000000000000000000000000000000000000010",
+      "b72675a165d57f2e428be85386ed1235d8fab1c817bac8069fc11e0e8cbbe50d" },
+    { "0000000000000000000000000000000000000000000000000000000000000011",
+      "e066f69c3b5e6dc6fadefad6c7130b2bb42ac3147f2e090d7be23bda31ead073" },
+    { "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc63254f",
+      "b3d44b21c45ce2d9f3165252dec93b017ba6f2fd35b1b4422314d9924a37b636" },
+    { "ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632550",
+      "9fad84aeae08bbef7f010014d82cef6a09de2b0cf871b5ce0c4f1d13a59a5934" },
+    { "d23f0824128b2f330c5c7fd0a6a3a4506513270e269e0d37f2a74de452e6b439",
+      "c7474e80b04aeeccccc6659b59a0347cb8572e0870a95d64a3fb82f1dcb97c2e" },
+    { "36f675cc81e74ef5e8e25d940ed904759531985d5d9dc9f81818e811892f902c",
+      "0e30725b94a4fe116141bf858ca76d6fba5ee230b57153dba7ede671b8a237b4" },
+};
+
+static void hex_to_bytes(const char *p_hex, uint8_t *p_out)
+{
+    unsigned int byte;
+
+    while (*p_hex != '\0')
+    {
+        sscanf(p_hex, "%2x", &byte);
+        *p_out++ = (uint8_t) byte;
+        p_hex += 2;
+    }
+}
+
+static void test_ecdh(void)
+{
+    uint8_t private_key[HEADSET_GFPS_CRYPTO_P256_PRIVATE_LEN];
+    uint8_t peer_key[HEADSET_GFPS_CRYPTO_P256_PUBLIC_LEN];
+    uint8_t expected[HEADSET_GFPS_CRYPTO_P256_SHARED_LEN];
+    uint8_t shared[HEADSET_GFPS_CRYPTO_P256_SHARED_LEN];
+    headset_gfps_crypto_stats_t stats;
+    uint32_t i;
+
+    hex_to_bytes(nist_private, private_key);
+    hex_to_bytes(nist_peer, peer_key);
+    hex_to_bytes(nist_shared, expected);
+    CHECK(headset_gfps_crypto_ecdh(private_key, peer_key, shared) == WICED_SUCCESS);
+    CHECK(memcmp(shared, expected, sizeof(shared)) == 0);
+
+    hex_to_bytes(peer, peer_key);
+
+    for (i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++)
+    {
+        hex_to_bytes(vectors[i].private_key, private_key);
+        hex_to_bytes(vectors[i].shared, expected);
+        CHECK(headset_gfps_crypto_ecdh(private_key, peer_key, shared) == WICED_SUCCESS);
+        CHECK(memcmp(shared, expected, sizeof(shared)) == 0);
+    }
+
+    headset_gfps_crypto_stats_get(HEADSET_GFPS_CRYPTO_OP_ECDH, &stats);
+    CHECK(stats.count >= i + 1);
+}
+
+static void test_ecdh_invalid(void)
+{
+    uint8_t private_key[HEADSET_GFPS_CRYPTO_P256_PRIVATE_LEN];
+    uint8_t peer_key[HEADSET_GFPS_CRYPTO_P256_PUBLIC_LEN];
+    uint8_t shared[HEADSET_GFPS_CRYPTO_P256_SHARED_LEN];
+
+    hex_to_bytes(peer, peer_key);
+
+    /* Private key 0 and n */
+    memset(private_key, 0, sizeof(private_key));
+    CHECK(headset_gfps_crypto_ecdh(private_key, peer_key, shared) == WICED_BADARG);
+    hex_to_bytes("ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551", private_key);
+    CHECK(headset_gfps_crypto_ecdh(private_key, peer_key, shared) == WICED_BADARG);
+
+    /* Point off the curve */
+    hex_to_bytes(vectors[0].private_key, private_key);
+    peer_key[HEADSET_GFPS_CRYPTO_P256_PUBLIC_LEN - 1] ^= 1;
+    CHECK(headset_gfps_crypto_ecdh(private_key, peer_key, shared) == WICED_BADARG);
+
+    /* Coordinate equal to p */
+    hex_to_bytes("ffffffff00000001000000000000000000000000ffffffffffffffffffffffff", peer_key);
+    CHECK(headset_gfps_crypto_ecdh(private_key, peer_key, shared) == WICED_BADARG);
+
+    /* Point at infinity as all zeros */
+    memset(peer_key, 0, sizeof(peer_key));
+    CHECK(headset_gfps_crypto_ecdh(private_key, peer_key, shared) == WICED_BADARG);
+}
+
+/* FIPS-197 appendix C.1 */
+static void test_aes(void)
+{
+    headset_gfps_crypto_aes_t aes;
+    uint8_t key[HEADSET_GFPS_CRYPTO_AES_KEY_LEN];
+    uint8_t plain[HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN];
+    uint8_t expected[HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN];
+    uint8_t block[HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN];
+
+    hex_to_bytes("000102030405060708090a0b0c0d0e0f", key);
+    hex_to_bytes("00112233445566778899aabbccddeeff", plain);
+    hex_to_bytes("69c4e0d86a7b0430d8cdb78070b4c55a", expected);
+
+    headset_gfps_crypto_aes_key_set(&aes, key);
+    headset_gfps_crypto_aes_encrypt(&aes, plain, block);
+    CHECK(memcmp(block, expected, sizeof(block)) == 0);
+
+    headset_gfps_crypto_aes_decrypt(&aes, block, block);
+    CHECK(memcmp(block, plain, sizeof(block)) == 0);
+}
+
+static void test_bench(void)
+{
+    uint8_t private_key[HEADSET_GFPS_CRYPTO_P256_PRIVATE_LEN];
+    uint8_t peer_key[HEADSET_GFPS_CRYPTO_P256_PUBLIC_LEN];
+    uint8_t shared[HEADSET_GFPS_CRYPTO_P256_SHARED_LEN];
+    uint8_t block[HEADSET_GFPS_CRYPTO_AES_BLOCK_LEN] = {0};
+    headset_gfps_crypto_aes_t aes;
+    uint64_t start, ecdh_ns, aes_ns;
+    uint32_t i;
+
+    hex_to_bytes(peer, peer_key);
+    hex_to_bytes(vectors[7].private_key, private_key);
+
+    start = test_clock_ns();
+    for (i = 0; i < BENCH_ECDH; i++)
+    {
+        headset_gfps_crypto_ecdh(private_key, peer_key, shared);
+    }
+    ecdh_ns = test_clock_ns() - start;
+
+    headset_gfps_crypto_aes_key_set(&aes, shared);
+
+    start = test_clock_ns();
+    for (i = 0; i < BENCH_AES_BLOCKS; i++)
+    {
+        headset_gfps_crypto_aes_encrypt(&aes, block, block);
+    }
+    aes_ns = test_clock_ns() - start;
+
+    printf("    ecdh %u us, aes block %u ns (host)\n",
+           (uint32_t) (ecdh_ns / BENCH_ECDH / 1000),
+           (uint32_t) (aes_ns / BENCH_AES_BLOCKS));
+}
+
+int main(void)
+{
+    RUN(test_ecdh);
+    RUN(test_ecdh_invalid);
+    RUN(test_aes);
+    RUN(test_bench);
+
+    return 0;
+}
@@ -0,0 +1,185 @@
+/******************************************************************************
+* File Name:   test_gfps_filter.c
+*
+* Description: Host test and benchmark of the Fast Pair account key filter.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "headset_gfps_filter.h"
+#include "headset_sha256.h"
+#include "test.h"
+
+#define BENCH_REFRESHES     10000
+
+static uint8_t keys[HEADSET_GFPS_FILTER_MAX_KEYS][HEADSET_GFPS_FILTER_KEY_LEN];
+
+/* Straight implementation of the Fast Pair account key filter: SHA-256(key || salt) per key */
+static uint8_t reference_filter(uint8_t num_keys, uint8_t salt, uint8_t *p_filter)
+{
+    uint8_t len = HEADSET_GFPS_FILTER_LEN(num_keys);
+    uint8_t input[HEADSET_GFPS_FILTER_KEY_LEN + 1];
+    uint8_t digest[HEADSET_SHA256_DIGEST_LEN];
+    headset_sha256_t ctx;
+    uint32_t x;
+    uint8_t i, j;
+
+    memset(p_filter, 0, HEADSET_GFPS_FILTER_MAX_LEN);
+
+    for (i = 0; i < num_keys; i++)
+    {
+        memcpy(input, keys[i], HEADSET_GFPS_FILTER_KEY_LEN);
+        input[HEADSET_GFPS_FILTER_KEY_LEN] = salt;
+
+        headset_sha256_init(&ctx);
+        headset_sha256_update(&ctx, input, sizeof(input));
+        headset_sha256_final(&ctx, digest);
+
+        for (j = 0; j < 8; j++)
+        {
+            x = ((uint32_t) digest[4 * j] << 24) | ((uint32_t) digest[4 * j + 1] << 16) |
+                ((uint32_t) digest[4 * j + 2] << 8) | digest[4 * j + 3];
+            x %= (uint32_t) len * 8;
+            p_filter[x / 8] |= (uint8_t) (1 << (x % 8));
+        }
+    }
+
+    return len;
+}
+
+static void keys_fill(void)
+{
+    uint32_t seed = 12345;
+    uint8_t i, j;
+
+    for (i = 0; i < HEADSET_GFPS_FILTER_MAX_KEYS; i++)
+    {
+        for (j = 0; j < HEADSET_GFPS_FILTER_KEY_LEN; j++)
+        {
+            seed = seed * 1103515245 + 12345;
+            keys[i][j] = (uint8_t) (seed >> 16);
+        }
+    }
+}
+
+/* Example of the Fast Pair specification */
+static void test_spec_vector(void)
+{
+    static const uint8_t key[1][HEADSET_GFPS_FILTER_KEY_LEN] =
+    {
+        { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0x00, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF },
+    };
+    static const uint8_t expected[] = { 0x0A, 0x42, 0x88, 0x10 };
+    uint8_t filter[HEADSET_GFPS_FILTER_MAX_LEN];
+
+    CHECK(headset_gfps_filter_keys_set(key, 1) == WICED_SUCCESS);
+    CHECK(headset_gfps_filter_get(0xC7, filter) == sizeof(expected));
+    CHECK(memcmp(filter, expected, sizeof(expected)) == 0);
+}
+
+static void test_reference(void)
+{
+    uint8_t filter[HEADSET_GFPS_FILTER_MAX_LEN];
+    uint8_t expected[HEADSET_GFPS_FILTER_MAX_LEN];
+    uint8_t len;
+    uint8_t n;
+    int salt;
+
+    keys_fill();
+
+    CHECK(headset_gfps_filter_keys_set(keys, 0) == WICED_SUCCESS);
+    CHECK(headset_gfps_filter_get(0, filter) == 0);
+
+    for (n = 1; n <= HEADSET_GFPS_FILTER_MAX_KEYS; n++)
+    {
+        CHECK(headset_gfps_filter_keys_set(keys, n) == WICED_SUCCESS);
+
+        for (salt = 0; salt < 256; salt++)
+        {
+            len = headset_gfps_filter_get((uint8_t) salt, filter);
+            CHECK(len == reference_filter(n, (uint8_t) salt, expected));
+            CHECK(memcmp(filter, expected, len) == 0);
+
+            /* Memoized filter for the same salt */
+            memset(filter, 0, sizeof(filter));
+            CHECK(headset_gfps_filter_get((uint8_t) salt, filter) == len);
+            CHECK(memcmp(filter, expected, len) == 0);
+        }
+    }
+
+    CHECK(headset_gfps_filter_keys_set(keys, HEADSET_GFPS_FILTER_MAX_KEYS + 1) == WICED_BADARG);
+    CHECK(headset_gfps_filter_keys_set(NULL, 1) == WICED_BADARG);
+}
+
+static void test_bench(void)
+{
+    uint8_t filter[HEADSET_GFPS_FILTER_MAX_LEN];
+    uint64_t start, cached_ns, reference_ns;
+    uint32_t i;
+
+    keys_fill();
+    CHECK(headset_gfps_filter_keys_set(keys, HEADSET_GFPS_FILTER_MAX_KEYS) == WICED_SUCCESS);
+
+    /* A new salt at every refresh, so the memoized filter is never used */
+    start = test_clock_ns();
+    for (i = 0; i < BENCH_REFRESHES; i++)
+    {
+        headset_gfps_filter_get((uint8_t) i, filter);
+    }
+    cached_ns = test_clock_ns() - start;
+
+    start = test_clock_ns();
+    for (i = 0; i < BENCH_REFRESHES; i++)
+    {
+        reference_filter(HEADSET_GFPS_FILTER_MAX_KEYS, (uint8_t) i, filter);
+    }
+    reference_ns = test_clock_ns() - start;
+
+    printf("    %d keys: %u ns per refresh, reference %u ns\n",
+           HEADSET_GFPS_FILTER_MAX_KEYS,
+           (uint32_t) (cached_ns / BENCH_REFRESHES),
+           (uint32_t) (reference_ns / BENCH_REFRESHES));
+}
+
+int main(void)
+{
+    RUN(test_spec_vector);
+    RUN(test_reference);
+    RUN(test_bench);
+
+    return 0;
+}
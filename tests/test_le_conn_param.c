@@ -0,0 +1,213 @@
+/******************************************************************************
+* File Name:   test_le_conn_param.c
+*
+* Description: Host test of the LE connection parameter policy with an air time model.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "headset_le_conn_param.h"
+#include "wiced_bt_ble.h"
+#include "wiced_bt_l2c.h"
+#include "test.h"
+
+/* Air time of one LE connection event with an empty PDU each way at 1M: 80 + 150 + 80 + 150 us */
+#define EVENT_US        460
+
+/* Fake stack */
+static uint32_t update_count;
+static uint16_t update_min;
+static uint16_t update_max;
+static uint16_t update_latency;
+static wiced_bool_t update_accept = WICED_TRUE;
+static uint32_t phy_count;
+
+wiced_bool_t wiced_bt_l2cap_update_ble_conn_params(wiced_bt_device_address_t rem_bdRa,
+                                                   uint16_t min_int,
+                                                   uint16_t max_int,
+                                                   uint16_t latency,
+                                                   uint16_t timeout)
+{
+    update_count++;
+    update_min      = min_int;
+    update_max      = max_int;
+    update_latency  = latency;
+
+    return update_accept;
+}
+
+wiced_result_t wiced_bt_ble_set_phy(wiced_bt_ble_phy_preferences_t *p_phy_preferences)
+{
+    CHECK(p_phy_preferences->tx_phys == BTM_BLE_PREFER_2M_PHY);
+    phy_count++;
+
+    return WICED_BT_SUCCESS;
+}
+
+static wiced_bt_device_address_t peer = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 };
+
+/* Share of the air an idle LE link takes with the given parameters, in 1/100000 */
+static uint32_t airtime_get(uint16_t interval, uint16_t latency)
+{
+    return (EVENT_US * 100000) / (interval * 1250 * (latency + 1));
+}
+
+static void test_select(void)
+{
+    CHECK(headset_le_conn_param_select(0) == HEADSET_LE_CONN_PARAM_IDLE);
+    CHECK(headset_le_conn_param_select(HEADSET_LE_CONN_PARAM_LOAD_OTA) == HEADSET_LE_CONN_PARAM_BULK);
+    CHECK(headset_le_conn_param_select(HEADSET_LE_CONN_PARAM_LOAD_FASTPAIR) == HEADSET_LE_CONN_PARAM_BULK);
+    CHECK(headset_le_conn_param_select(HEADSET_LE_CONN_PARAM_LOAD_A2DP) == HEADSET_LE_CONN_PARAM_A2DP);
+    CHECK(headset_le_conn_param_select(HEADSET_LE_CONN_PARAM_LOAD_A2DP | HEADSET_LE_CONN_PARAM_LOAD_OTA) ==
+          HEADSET_LE_CONN_PARAM_A2DP_BULK);
+
+    /* A call wins over everything */
+    CHECK(headset_le_conn_param_select(HEADSET_LE_CONN_PARAM_LOAD_ESCO) == HEADSET_LE_CONN_PARAM_ESCO);
+    CHECK(headset_le_conn_param_select(0x0F) == HEADSET_LE_CONN_PARAM_ESCO);
+}
+
+/* Requested parameters per state, and their air time */
+static void test_airtime(void)
+{
+    static const struct
+    {
+        const char  *name;
+        uint8_t     load;
+    } states[] =
+    {
+        { "idle",           0 },
+        { "bulk",           HEADSET_LE_CONN_PARAM_LOAD_OTA },
+        { "a2dp",           HEADSET_LE_CONN_PARAM_LOAD_A2DP },
+        { "a2dp + bulk",    HEADSET_LE_CONN_PARAM_LOAD_A2DP | HEADSET_LE_CONN_PARAM_LOAD_OTA },
+        { "esco",           HEADSET_LE_CONN_PARAM_LOAD_ESCO },
+    };
+    uint32_t airtime[sizeof(states) / sizeof(states[0])];
+    uint32_t i;
+
+    headset_le_conn_param_link_up(peer);
+
+    for (i = 0; i < sizeof(states) / sizeof(states[0]); i++)
+    {
+        headset_le_conn_param_load_set(0xFF, WICED_FALSE);
+        headset_le_conn_param_load_set(states[i].load, WICED_TRUE);
+        CHECK(update_min <= update_max);
+
+        /* Air time at the slowest interval the peer may pick, while the peripheral is idle */
+        airtime[i] = airtime_get(update_max, update_latency);
+        printf("    %-12s %3u - %3u x 1.25 ms, latency %u: %u.%03u %% air time\n",
+               states[i].name, update_min, update_max, update_latency, airtime[i] / 1000, airtime[i] % 1000);
+    }
+
+    /* Audio states leave more air to BR/EDR than idle, bulk takes the most */
+    CHECK(airtime[2] < airtime[0]);
+    CHECK(airtime[4] <= airtime[2]);
+    CHECK(airtime[3] > airtime[2]);
+    CHECK(airtime[1] > airtime[0]);
+    CHECK(airtime[4] < 500);
+
+    headset_le_conn_param_link_down();
+}
+
+/* Requests are only sent on a link, once per change, and 2M is asked once for bulk */
+static void test_requests(void)
+{
+    update_count    = 0;
+    phy_count       = 0;
+
+    headset_le_conn_param_load_set(0xFF, WICED_FALSE);
+    headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_A2DP, WICED_TRUE);
+    CHECK(update_count == 0);
+
+    headset_le_conn_param_link_up(peer);
+    CHECK(update_count == 1);
+
+    /* Same load: nothing */
+    headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_A2DP, WICED_TRUE);
+    CHECK(update_count == 1);
+
+    /* Peer already runs parameters that fit the set: nothing */
+    headset_le_conn_param_update_evt(0, update_max, update_latency);
+    headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_ESCO, WICED_TRUE);
+    CHECK(update_count == 2);
+    headset_le_conn_param_update_evt(0, update_max, update_latency);
+    headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_ESCO, WICED_FALSE);
+    CHECK(update_count == 3);
+
+    /* Bulk asks for 2M once per link */
+    headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_OTA, WICED_TRUE);
+    headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_FASTPAIR, WICED_TRUE);
+    CHECK(update_count == 4);
+    CHECK(phy_count == 1);
+    CHECK(headset_le_conn_param_tx_phy_get() == 1);
+    headset_le_conn_param_phy_update_evt(2, 2);
+    CHECK(headset_le_conn_param_tx_phy_get() == 2);
+
+    /* A request the peer refused is not repeated until the set changes */
+    headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_A2DP, WICED_FALSE);
+    CHECK(update_count == 5);
+    headset_le_conn_param_update_evt(0x1E, 0, 0);
+    headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_FASTPAIR, WICED_FALSE);
+    CHECK(update_count == 5);
+
+    /* A request the stack could not send is retried at the next load change */
+    headset_le_conn_param_update_evt(0, 12, 0);
+    update_accept = WICED_FALSE;
+    headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_ESCO, WICED_TRUE);
+    CHECK(update_count == 6);
+    update_accept = WICED_TRUE;
+    headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_FASTPAIR, WICED_TRUE);
+    CHECK(update_count == 7);
+    headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_ESCO | HEADSET_LE_CONN_PARAM_LOAD_FASTPAIR, WICED_FALSE);
+
+    /* OTA ends with the link */
+    headset_le_conn_param_link_down();
+    headset_le_conn_param_load_set(HEADSET_LE_CONN_PARAM_LOAD_FASTPAIR, WICED_FALSE);
+    CHECK(headset_le_conn_param_tx_phy_get() == 2);
+    headset_le_conn_param_link_up(peer);
+    CHECK(update_min > 12);
+    CHECK(phy_count == 1);
+    CHECK(headset_le_conn_param_tx_phy_get() == 1);
+}
+
+int main(void)
+{
+    RUN(test_select);
+    RUN(test_airtime);
+    RUN(test_requests);
+
+    return 0;
+}
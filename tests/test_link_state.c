@@ -0,0 +1,166 @@
+/******************************************************************************
+* File Name:   test_link_state.c
+*
+* Description: Host test of the BR/EDR link state tracking with two simulated sources.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "headset_adv_sched.h"
+#include "headset_le_conn_param.h"
+#include "headset_link_state.h"
+#include "headset_power.h"
+#include "headset_sniff.h"
+#include "test.h"
+
+/* Fakes of the modules fed by the link states */
+static wiced_bool_t power_input[32];
+static wiced_bool_t adv_state[32];
+static wiced_bool_t le_load[32];
+static uint32_t sniff_links;
+static wiced_bool_t sniff_busy[2];
+
+static const wiced_bt_device_address_t phone    = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x01 };
+static const wiced_bt_device_address_t laptop   = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x02 };
+
+void headset_power_input_set(uint8_t input, wiced_bool_t set)
+{
+    power_input[input] = set;
+}
+
+void headset_adv_sched_state_set(uint8_t state, wiced_bool_t set)
+{
+    adv_state[state] = set;
+}
+
+void headset_le_conn_param_load_set(uint8_t load, wiced_bool_t active)
+{
+    le_load[load] = active;
+}
+
+void headset_sniff_link_set(wiced_bt_device_address_t bd_addr, wiced_bool_t connected)
+{
+    sniff_links += connected ? 1 : -1;
+}
+
+void headset_sniff_busy_set(wiced_bt_device_address_t bd_addr, wiced_bool_t busy)
+{
+    sniff_busy[bd_addr[5] - 1] = busy;
+}
+
+static void connect(const wiced_bt_device_address_t bd_addr, uint16_t handle)
+{
+    wiced_bt_a2dp_sink_event_data_t data;
+
+    headset_link_state_conn_status_change((uint8_t *) bd_addr, NULL, WICED_TRUE, handle, BT_TRANSPORT_BR_EDR, 0);
+
+    memset(&data, 0, sizeof(data));
+    data.connect.result = WICED_SUCCESS;
+    data.connect.handle = handle;
+    memcpy(data.connect.bd_addr, bd_addr, sizeof(wiced_bt_device_address_t));
+    headset_link_state_a2dp_post_handler(WICED_BT_A2DP_SINK_CONNECT_EVT, &data);
+}
+
+static void a2dp_event(wiced_bt_a2dp_sink_event_t event, uint16_t handle)
+{
+    wiced_bt_a2dp_sink_event_data_t data;
+
+    memset(&data, 0, sizeof(data));
+    data.start_ind.handle = handle;
+    headset_link_state_a2dp_post_handler(event, &data);
+}
+
+/* Phone and laptop connected, music on one then the other, then both gone */
+static void test_two_sources(void)
+{
+    connect(phone, 1);
+    CHECK(sniff_links == 1);
+    CHECK(power_input[HEADSET_POWER_INPUT_CONNECTED] && !power_input[HEADSET_POWER_INPUT_STREAMING]);
+    CHECK(adv_state[HEADSET_ADV_SCHED_STATE_BREDR_CONNECTED]);
+
+    connect(laptop, 2);
+    CHECK(sniff_links == 2);
+
+    a2dp_event(WICED_BT_A2DP_SINK_START_IND_EVT, 2);
+    CHECK(power_input[HEADSET_POWER_INPUT_STREAMING]);
+    CHECK(adv_state[HEADSET_ADV_SCHED_STATE_STREAMING]);
+    CHECK(le_load[HEADSET_LE_CONN_PARAM_LOAD_A2DP]);
+    CHECK(!sniff_busy[0] && sniff_busy[1]);
+
+    /* Laptop pauses, phone starts */
+    a2dp_event(WICED_BT_A2DP_SINK_SUSPEND_EVT, 2);
+    a2dp_event(WICED_BT_A2DP_SINK_START_CFM_EVT, 1);
+    CHECK(sniff_busy[0] && !sniff_busy[1]);
+    CHECK(power_input[HEADSET_POWER_INPUT_STREAMING]);
+
+    /* Phone A2DP goes down: nothing streams, the laptop keeps the device connected */
+    a2dp_event(WICED_BT_A2DP_SINK_DISCONNECT_EVT, 1);
+    CHECK(!power_input[HEADSET_POWER_INPUT_STREAMING]);
+    CHECK(!le_load[HEADSET_LE_CONN_PARAM_LOAD_A2DP]);
+    headset_link_state_conn_status_change((uint8_t *) phone, NULL, WICED_FALSE, 1, BT_TRANSPORT_BR_EDR, 0x13);
+    CHECK(power_input[HEADSET_POWER_INPUT_CONNECTED]);
+
+    headset_link_state_conn_status_change((uint8_t *) laptop, NULL, WICED_FALSE, 2, BT_TRANSPORT_BR_EDR, 0x13);
+    CHECK(sniff_links == 0);
+    CHECK(!power_input[HEADSET_POWER_INPUT_CONNECTED]);
+    CHECK(!adv_state[HEADSET_ADV_SCHED_STATE_BREDR_CONNECTED]);
+}
+
+/* A third source and LE links are not tracked */
+static void test_limits(void)
+{
+    static const wiced_bt_device_address_t tablet = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x03 };
+
+    connect(phone, 1);
+    connect(laptop, 2);
+    connect(tablet, 3);
+    a2dp_event(WICED_BT_A2DP_SINK_START_IND_EVT, 3);
+    CHECK(!power_input[HEADSET_POWER_INPUT_STREAMING]);
+
+    headset_link_state_conn_status_change((uint8_t *) tablet, NULL, WICED_TRUE, 4, BT_TRANSPORT_LE, 0);
+    headset_link_state_conn_status_change((uint8_t *) phone, NULL, WICED_FALSE, 1, BT_TRANSPORT_BR_EDR, 0);
+    headset_link_state_conn_status_change((uint8_t *) laptop, NULL, WICED_FALSE, 2, BT_TRANSPORT_BR_EDR, 0);
+    CHECK(!power_input[HEADSET_POWER_INPUT_CONNECTED]);
+}
+
+int main(void)
+{
+    RUN(test_two_sources);
+    RUN(test_limits);
+
+    return 0;
+}
@@ -0,0 +1,309 @@
+/******************************************************************************
+* File Name:   test_ota_delta.c
+*
+* Description: Host test of the OTA delta applier against a simulated flash.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+
+#include "headset_ota_delta.h"
+#include "headset_sha256.h"
+#include "test.h"
+
+#define SOURCE_LEN      16384
+#define IMAGE_MAX       (SOURCE_LEN + 4096)
+#define DELTA_MAX       8192
+
+typedef struct
+{
+    uint8_t     type;           /* 0 COPY, 1 INSERT */
+    uint32_t    pos;            /* COPY: absolute source position */
+    uint32_t    len;
+} edit_t;
+
+/* Simulated flash: the running image and the bank the new image is written to */
+static uint8_t  source[SOURCE_LEN];
+static uint8_t  target[IMAGE_MAX];
+static uint32_t target_written;
+static wiced_bool_t unaligned_write;
+
+static uint8_t  expected[IMAGE_MAX];
+static uint32_t expected_len;
+static uint8_t  delta[DELTA_MAX];
+static uint32_t delta_len;
+
+static uint32_t seed;
+
+static uint32_t rand_next(void)
+{
+    seed = seed * 1103515245 + 12345;
+
+    return seed >> 16;
+}
+
+static wiced_bool_t flash_read(uint32_t offset, uint8_t *p_data, uint32_t len)
+{
+    if ((offset + len) > SOURCE_LEN)
+    {
+        return WICED_FALSE;
+    }
+
+    memcpy(p_data, &source[offset], len);
+
+    return WICED_TRUE;
+}
+
+static wiced_bool_t flash_write(uint32_t offset, const uint8_t *p_data, uint32_t len)
+{
+    if ((offset % HEADSET_OTA_DELTA_PAGE_SIZE) != 0)
+    {
+        unaligned_write = WICED_TRUE;
+    }
+
+    memcpy(&target[offset], p_data, len);
+    target_written += len;
+
+    return WICED_TRUE;
+}
+
+static void put_varint(uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        delta[delta_len++] = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    delta[delta_len++] = (uint8_t) value;
+}
+
+static void put_le32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t) value;
+    p[1] = (uint8_t) (value >> 8);
+    p[2] = (uint8_t) (value >> 16);
+    p[3] = (uint8_t) (value >> 24);
+}
+
+static void sha256(const uint8_t *p_data, uint32_t len, uint8_t *p_digest)
+{
+    headset_sha256_t ctx;
+
+    headset_sha256_init(&ctx);
+    headset_sha256_update(&ctx, p_data, len);
+    headset_sha256_final(&ctx, p_digest);
+}
+
+/* Build the expected image and its delta stream from an edit list, as scripts/ota_delta.py does */
+static void delta_build(const edit_t *p_edit, uint32_t num)
+{
+    uint32_t src_pos = 0;
+    int32_t offset;
+    uint32_t i, j;
+
+    expected_len    = 0;
+    delta_len       = HEADSET_OTA_DELTA_HEADER_LEN;
+
+    for (i = 0; i < num; i++)
+    {
+        put_varint((p_edit[i].len << 1) | p_edit[i].type);
+
+        if (p_edit[i].type == 0)
+        {
+            offset = (int32_t) (p_edit[i].pos - src_pos);
+            put_varint(((uint32_t) offset << 1) ^ (uint32_t) (offset >> 31));
+
+            if ((p_edit[i].pos + p_edit[i].len) <= SOURCE_LEN)
+            {
+                memcpy(&expected[expected_len], &source[p_edit[i].pos], p_edit[i].len);
+            }
+            src_pos = p_edit[i].pos + p_edit[i].len;
+
+        }
+        else
+        {
+            for (j = 0; j < p_edit[i].len; j++)
+            {
+                expected[expected_len + j] = (uint8_t) rand_next();
+            }
+            memcpy(&delta[delta_len], &expected[expected_len], p_edit[i].len);
+            delta_len += p_edit[i].len;
+        }
+
+        expected_len += p_edit[i].len;
+    }
+
+    memset(delta, 0, HEADSET_OTA_DELTA_HEADER_LEN);
+    memcpy(delta, "HDLT", 4);
+    delta[4] = HEADSET_OTA_DELTA_VERSION;
+    put_le32(&delta[8], SOURCE_LEN);
+    put_le32(&delta[12], expected_len);
+    sha256(source, SOURCE_LEN, &delta[16]);
+    sha256(expected, expected_len, &delta[16 + HEADSET_SHA256_DIGEST_LEN]);
+}
+
+/* A release with patched words, an insertion, a deletion and a block moved backwards */
+static void release_build(void)
+{
+    static const edit_t edits[] =
+    {
+        { 0, 0,     4000, },
+        { 1, 0,     300,  },
+        { 0, 4100,  4900, },
+        { 1, 0,     4,    },
+        { 0, 9004,  3000, },
+        { 0, 100,   500,  },
+        { 1, 0,     4,    },
+        { 0, 12008, 4376, },
+    };
+    uint32_t i;
+
+    seed = 1;
+    for (i = 0; i < SOURCE_LEN; i++)
+    {
+        source[i] = (uint8_t) rand_next();
+    }
+
+    delta_build(edits, sizeof(edits) / sizeof(edits[0]));
+}
+
+/* Feed the delta in random part sizes, as the OTA transport delivers it */
+static wiced_result_t delta_apply(uint32_t max_part)
+{
+    wiced_result_t result = WICED_SUCCESS;
+    uint32_t offset = 0;
+    uint32_t n;
+
+    memset(target, 0xff, sizeof(target));
+    target_written  = 0;
+    unaligned_write = WICED_FALSE;
+
+    CHECK(headset_ota_delta_start(flash_read, flash_write, SOURCE_LEN) == WICED_SUCCESS);
+
+    while ((offset < delta_len) && (result == WICED_SUCCESS))
+    {
+        n = 1 + rand_next() % max_part;
+        if (n > (delta_len - offset))
+        {
+            n = delta_len - offset;
+        }
+
+        result  = headset_ota_delta_data(&delta[offset], n);
+        offset += n;
+    }
+
+    return (result == WICED_SUCCESS) ? headset_ota_delta_finish() : result;
+}
+
+static void test_apply(void)
+{
+    static const uint32_t max_part[] = { 1, 7, 20, 244, 509, DELTA_MAX };
+    uint32_t i;
+
+    release_build();
+
+    for (i = 0; i < sizeof(max_part) / sizeof(max_part[0]); i++)
+    {
+        CHECK(delta_apply(max_part[i]) == WICED_SUCCESS);
+        CHECK(target_written == expected_len);
+        CHECK(memcmp(target, expected, expected_len) == 0);
+        CHECK(!unaligned_write);
+    }
+
+    printf("    %u byte image, %u byte delta (%u.%u %%)\n",
+           expected_len, delta_len,
+           delta_len * 100 / expected_len, (delta_len * 1000 / expected_len) % 10);
+}
+
+static void test_reject(void)
+{
+    release_build();
+
+    /* Delta built for another image: nothing is written */
+    source[SOURCE_LEN / 2] ^= 1;
+    CHECK(delta_apply(DELTA_MAX) == WICED_ERROR);
+    CHECK(target_written == 0);
+    source[SOURCE_LEN / 2] ^= 1;
+
+    /* Corrupted literal */
+    delta[HEADSET_OTA_DELTA_HEADER_LEN + 10] ^= 0x40;
+    CHECK(delta_apply(DELTA_MAX) == WICED_ERROR);
+    delta[HEADSET_OTA_DELTA_HEADER_LEN + 10] ^= 0x40;
+
+    /* Truncated stream */
+    delta_len--;
+    CHECK(delta_apply(DELTA_MAX) == WICED_ERROR);
+    delta_len++;
+
+    /* Bad version */
+    delta[4]++;
+    CHECK(delta_apply(DELTA_MAX) == WICED_ERROR);
+    delta[4]--;
+    CHECK(delta_apply(DELTA_MAX) == WICED_SUCCESS);
+
+    CHECK(headset_ota_delta_start(NULL, flash_write, SOURCE_LEN) == WICED_BADARG);
+}
+
+/* Copies outside the running image and ops past the end of the target */
+static void test_bounds(void)
+{
+    static const edit_t past_source[] = { { 0, SOURCE_LEN - 100, 200, }, };
+    static const edit_t two_copies[]  = { { 0, 0, 100, }, { 0, 0, 100, }, };
+
+    release_build();
+
+    delta_build(past_source, 1);
+    CHECK(delta_apply(DELTA_MAX) == WICED_ERROR);
+
+    /* Op longer than the target */
+    delta_build(two_copies, 2);
+    put_le32(&delta[12], 150);
+    CHECK(delta_apply(DELTA_MAX) == WICED_ERROR);
+
+    /* Data after the end of the image */
+    delta_build(two_copies, 2);
+    delta[delta_len++] = 0x02;
+    CHECK(delta_apply(DELTA_MAX) == WICED_ERROR);
+}
+
+int main(void)
+{
+    RUN(test_apply);
+    RUN(test_reject);
+    RUN(test_bounds);
+
+    return 0;
+}
@@ -0,0 +1,313 @@
+/******************************************************************************
+* File Name:   test_power.c
+*
+* Description: Host test of the power state machine, auto-off and energy estimate.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "headset_adv_sched.h"
+#include "headset_power.h"
+#include "headset_sniff.h"
+#include "test.h"
+#include "wiced_bt_trace.h"
+#include "wiced_timer.h"
+
+static wiced_bool_t sniff_allowed;
+static wiced_bool_t adv_off;
+static uint32_t     total_uah;
+
+void headset_sniff_allowed_set(wiced_bool_t allowed)
+{
+    sniff_allowed = allowed;
+}
+
+void headset_adv_sched_state_set(uint8_t state, wiced_bool_t set)
+{
+    if (state == HEADSET_ADV_SCHED_STATE_AUTO_OFF)
+    {
+        adv_off = set;
+    }
+}
+
+/* Per state lines of the energy report: "headset_power: <state> <s> s <uAh> uAh" */
+static struct
+{
+    char        name[24];
+    uint32_t    seconds;
+    uint32_t    uah;
+} report[HEADSET_POWER_STATE_MAX];
+static uint32_t report_count;
+
+static void trace_hook(const char *p_line)
+{
+    const char *p_name;
+    size_t len;
+
+    if (sscanf(p_line, "headset_power: total %u uAh", &total_uah) == 1)
+    {
+        return;
+    }
+
+    if ((strncmp(p_line, "headset_power: ", 15) != 0) || (strstr(p_line, " -> ") != NULL) ||
+        (report_count == HEADSET_POWER_STATE_MAX))
+    {
+        return;
+    }
+
+    /* The state names contain no digit */
+    p_name  = p_line + 15;
+    len     = strcspn(p_name, "0123456789");
+
+    if ((len < 2) || (len > sizeof(report[0].name)) ||
+        (sscanf(p_name + len, "%u s %u uAh", &report[report_count].seconds, &report[report_count].uah) != 2))
+    {
+        return;
+    }
+
+    memcpy(report[report_count].name, p_name, len - 1);
+    report[report_count].name[len - 1] = '\0';
+    report_count++;
+}
+
+static uint32_t report_seconds(const char *name)
+{
+    uint32_t i;
+
+    for (i = 0; i < report_count; i++)
+    {
+        if (strcmp(report[i].name, name) == 0)
+        {
+            return report[i].seconds;
+        }
+    }
+
+    return UINT32_MAX;
+}
+
+static void test_states(void)
+{
+    headset_power_init();
+    CHECK(headset_power_state_get() == HEADSET_POWER_STATE_DISCONNECTED_IDLE);
+    CHECK(sniff_allowed);
+
+    headset_power_input_set(HEADSET_POWER_INPUT_DISCOVERABLE, WICED_TRUE);
+    CHECK(headset_power_state_get() == HEADSET_POWER_STATE_DISCOVERABLE);
+
+    headset_power_input_set(HEADSET_POWER_INPUT_CONNECTED, WICED_TRUE);
+    CHECK(headset_power_state_get() == HEADSET_POWER_STATE_CONNECTED_IDLE);
+    headset_power_input_set(HEADSET_POWER_INPUT_STREAMING, WICED_TRUE);
+    CHECK(headset_power_state_get() == HEADSET_POWER_STATE_STREAMING);
+
+    headset_power_input_set(HEADSET_POWER_INPUT_CALL, WICED_TRUE);
+    CHECK(headset_power_state_get() == HEADSET_POWER_STATE_CALL);
+    CHECK(!sniff_allowed);
+
+    headset_power_input_set(HEADSET_POWER_INPUT_CALL | HEADSET_POWER_INPUT_STREAMING, WICED_FALSE);
+    CHECK(headset_power_state_get() == HEADSET_POWER_STATE_CONNECTED_IDLE);
+    CHECK(sniff_allowed);
+}
+
+static void test_auto_off(void)
+{
+    headset_power_init();
+
+    /* User activity restarts the timeout */
+    stub_time_advance_ms((HEADSET_POWER_AUTO_OFF_TIMEOUT - 1) * 1000);
+    headset_power_user_activity();
+    stub_time_advance_ms((HEADSET_POWER_AUTO_OFF_TIMEOUT - 1) * 1000);
+    CHECK(headset_power_state_get() == HEADSET_POWER_STATE_DISCONNECTED_IDLE);
+    CHECK(!adv_off);
+
+    stub_time_advance_ms(1000);
+    CHECK(headset_power_state_get() == HEADSET_POWER_STATE_ADV_OFF);
+    CHECK(adv_off);
+
+    headset_power_user_activity();
+    CHECK(headset_power_state_get() == HEADSET_POWER_STATE_DISCONNECTED_IDLE);
+    CHECK(!adv_off);
+
+    /* A reconnection of a paired source also restarts advertising */
+    stub_time_advance_ms(HEADSET_POWER_AUTO_OFF_TIMEOUT * 1000);
+    CHECK(headset_power_state_get() == HEADSET_POWER_STATE_ADV_OFF);
+    headset_power_input_set(HEADSET_POWER_INPUT_CONNECTED, WICED_TRUE);
+    CHECK(headset_power_state_get() == HEADSET_POWER_STATE_CONNECTED_IDLE);
+    CHECK(!adv_off);
+
+    /* No timeout while connected */
+    stub_time_advance_ms(HEADSET_POWER_AUTO_OFF_TIMEOUT * 2000);
+    CHECK(headset_power_state_get() == HEADSET_POWER_STATE_CONNECTED_IDLE);
+
+    headset_power_input_set(HEADSET_POWER_INPUT_CONNECTED, WICED_FALSE);
+    stub_time_advance_ms(HEADSET_POWER_AUTO_OFF_TIMEOUT * 1000);
+    CHECK(headset_power_state_get() == HEADSET_POWER_STATE_ADV_OFF);
+}
+
+/* One hour: 10 min idle, 30 min streaming, 10 min idle then advertising off */
+static void test_energy(void)
+{
+    uint32_t expected_uah;
+
+    stub_trace_hook = trace_hook;
+    headset_power_init();
+
+    stub_time_advance_ms(HEADSET_POWER_AUTO_OFF_TIMEOUT * 500);
+    headset_power_input_set(HEADSET_POWER_INPUT_CONNECTED | HEADSET_POWER_INPUT_STREAMING, WICED_TRUE);
+    stub_time_advance_ms(1800 * 1000);
+    headset_power_input_set(HEADSET_POWER_INPUT_CONNECTED | HEADSET_POWER_INPUT_STREAMING, WICED_FALSE);
+    stub_time_advance_ms(3600 * 1000 - 1800 * 1000 - HEADSET_POWER_AUTO_OFF_TIMEOUT * 500);
+    CHECK(headset_power_state_get() == HEADSET_POWER_STATE_ADV_OFF);
+
+    headset_power_energy_report();
+
+    /* 250 uA for 15 min, 8 mA for 30 min, 200 uA for 15 min */
+    expected_uah = (250 * 900 + 8000 * 1800 + 200 * 900) / 3600;
+    printf("    1 h with 30 min streaming: %u uAh (%u uA average)\n", total_uah, total_uah);
+    CHECK(total_uah == expected_uah);
+}
+
+/*
+ * Day in the life, replayed from a trace of the application events. The device stays powered
+ * for 24 h: music on the way to work, a call, music at lunch and on the way home, a call in the
+ * evening. Auto-off stops the adverts 10 min after each disconnection.
+ */
+enum
+{
+    DAY_BUTTON,     /* Button press */
+    DAY_SET,        /* Inputs set */
+    DAY_CLEAR,      /* Inputs cleared */
+};
+
+static void test_day(void)
+{
+    static const struct
+    {
+        uint16_t    minute;
+        uint8_t     event;
+        uint8_t     inputs;
+    } trace[] =
+    {
+        { 7 * 60,       DAY_BUTTON, 0 },
+        { 7 * 60 + 1,   DAY_SET,    HEADSET_POWER_INPUT_CONNECTED },
+        { 7 * 60 + 5,   DAY_SET,    HEADSET_POWER_INPUT_STREAMING },
+        { 8 * 60,       DAY_CLEAR,  HEADSET_POWER_INPUT_STREAMING },
+        { 8 * 60 + 30,  DAY_SET,    HEADSET_POWER_INPUT_CALL },
+        { 8 * 60 + 45,  DAY_CLEAR,  HEADSET_POWER_INPUT_CALL },
+        { 9 * 60,       DAY_CLEAR,  HEADSET_POWER_INPUT_CONNECTED },
+        { 12 * 60,      DAY_BUTTON, 0 },
+        { 12 * 60,      DAY_SET,    HEADSET_POWER_INPUT_CONNECTED },
+        { 12 * 60 + 5,  DAY_SET,    HEADSET_POWER_INPUT_STREAMING },
+        { 13 * 60,      DAY_CLEAR,  HEADSET_POWER_INPUT_CONNECTED | HEADSET_POWER_INPUT_STREAMING },
+        { 17 * 60 + 30, DAY_BUTTON, 0 },
+        { 17 * 60 + 30, DAY_SET,    HEADSET_POWER_INPUT_CONNECTED | HEADSET_POWER_INPUT_STREAMING },
+        { 18 * 60 + 30, DAY_SET,    HEADSET_POWER_INPUT_CALL },
+        { 18 * 60 + 50, DAY_CLEAR,  HEADSET_POWER_INPUT_CALL | HEADSET_POWER_INPUT_STREAMING },
+        { 19 * 60,      DAY_CLEAR,  HEADSET_POWER_INPUT_CONNECTED },
+        { 24 * 60,      DAY_BUTTON, 0 },
+    };
+    /* Minutes per state, worked out by hand from the trace, and the current of headset_power.c */
+    static const struct
+    {
+        const char  *name;
+        uint32_t    minutes;
+        uint32_t    current_ua;
+    } expected[] =
+    {
+        { "advertising off",    410 + 170 + 260 + 290,  200  },
+        { "disconnected idle",  10 + 1 + 10 + 10 + 10,  250  },
+        { "discoverable",       0,                      1500 },
+        { "connected idle",     4 + 30 + 15 + 5 + 10,   400  },
+        { "streaming",          55 + 55 + 60,           8000 },
+        { "call",               15 + 20,                9000 },
+    };
+    uint32_t minute = 0;
+    uint32_t expected_uah = 0;
+    uint32_t i;
+
+    stub_trace_hook = trace_hook;
+    report_count    = 0;
+    headset_power_init();
+
+    for (i = 0; i < sizeof(trace) / sizeof(trace[0]); i++)
+    {
+        stub_time_advance_ms((trace[i].minute - minute) * 60000);
+        minute = trace[i].minute;
+
+        if (minute == 24 * 60)
+        {
+            break;
+        }
+
+        if (trace[i].event == DAY_BUTTON)
+        {
+            headset_power_user_activity();
+        }
+        else
+        {
+            headset_power_input_set(trace[i].inputs, trace[i].event == DAY_SET);
+        }
+    }
+
+    CHECK(headset_power_state_get() == HEADSET_POWER_STATE_ADV_OFF);
+    headset_power_energy_report();
+
+    CHECK(report_count == HEADSET_POWER_STATE_MAX);
+    for (i = 0; i < sizeof(expected) / sizeof(expected[0]); i++)
+    {
+        CHECK(report_seconds(expected[i].name) == expected[i].minutes * 60);
+        expected_uah += expected[i].minutes * expected[i].current_ua / 60;
+    }
+
+    for (i = 0; i < report_count; i++)
+    {
+        printf("    %-18s %5u min %6u uAh\n", report[i].name, report[i].seconds / 60, report[i].uah);
+    }
+    printf("    24 h: %u uAh (%u uA average)\n", total_uah, total_uah / 24);
+
+    CHECK(total_uah == expected_uah);
+}
+
+int main(void)
+{
+    RUN(test_states);
+    RUN(test_auto_off);
+    RUN(test_energy);
+    RUN(test_day);
+
+    return 0;
+}
@@ -0,0 +1,233 @@
+/******************************************************************************
+* File Name:   test_sniff.c
+*
+* Description: Host test of the sniff and sniff subrating policy against a fake stack.
+*
+* Related Document: None
+*
+*******************************************************************************
+* Copyright 2021-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "headset_sniff.h"
+#include "test.h"
+#include "wiced_timer.h"
+
+/* Default poll interval of an active ACL link, in slots */
+#define ACTIVE_POLL_SLOTS   40
+
+/* Fake stack, one link power mode per address (the last address byte) */
+typedef struct
+{
+    uint8_t     mode;               /* BTM_PM_STS_xxx */
+    uint32_t    sniff_requests;
+    uint32_t    cancels;
+    uint32_t    ssr_requests;
+    uint16_t    max_period;
+    uint16_t    ssr_max_latency;
+} fake_link_t;
+
+static fake_link_t fake_link[2];
+static wiced_bt_device_address_t addr[2] = { { 1, 2, 3, 4, 5, 0 }, { 1, 2, 3, 4, 5, 1 } };
+
+wiced_bt_dev_status_t wiced_bt_dev_set_sniff_mode(wiced_bt_device_address_t remote_bda, uint16_t min_period,
+                                                  uint16_t max_period, uint16_t attempt, uint16_t timeout)
+{
+    fake_link_t *p_link = &fake_link[remote_bda[5]];
+
+    CHECK(min_period <= max_period);
+    p_link->sniff_requests++;
+    p_link->max_period  = max_period;
+    p_link->mode        = BTM_PM_STS_PENDING;
+
+    return WICED_BT_PENDING;
+}
+
+wiced_bt_dev_status_t wiced_bt_dev_cancel_sniff_mode(wiced_bt_device_address_t remote_bda)
+{
+    fake_link[remote_bda[5]].cancels++;
+
+    return WICED_BT_PENDING;
+}
+
+wiced_bt_dev_status_t wiced_bt_dev_set_sniff_subrating(wiced_bt_device_address_t remote_bda, uint16_t max_latency,
+                                                       uint16_t min_remote_timeout, uint16_t min_local_timeout)
+{
+    fake_link_t *p_link = &fake_link[remote_bda[5]];
+
+    p_link->ssr_requests++;
+    p_link->ssr_max_latency = max_latency;
+
+    return WICED_BT_SUCCESS;
+}
+
+/* Report the pending mode change, then the subrating the module asks for once in sniff */
+static void stack_complete(int i)
+{
+    if (fake_link[i].mode == BTM_PM_STS_PENDING)
+    {
+        fake_link[i].mode = BTM_PM_STS_SNIFF;
+        headset_sniff_mode_change(addr[i], BTM_PM_STS_SNIFF);
+    }
+
+    if ((fake_link[i].mode == BTM_PM_STS_SNIFF) && (fake_link[i].ssr_requests != 0))
+    {
+        fake_link[i].mode = BTM_PM_STS_SSR;
+        headset_sniff_mode_change(addr[i], BTM_PM_STS_SSR);
+    }
+}
+
+static void stack_active(int i)
+{
+    fake_link[i].mode = BTM_PM_STS_ACTIVE;
+    headset_sniff_mode_change(addr[i], BTM_PM_STS_ACTIVE);
+}
+
+static void setup(void)
+{
+    memset(fake_link, 0, sizeof(fake_link));
+
+    headset_sniff_init();
+    headset_sniff_allowed_set(WICED_TRUE);
+}
+
+static void test_idle_link(void)
+{
+    setup();
+    headset_sniff_link_set(addr[0], WICED_TRUE);
+
+    stub_time_advance_ms(HEADSET_SNIFF_IDLE_TIMEOUT - 1);
+    CHECK(fake_link[0].sniff_requests == 0);
+    stub_time_advance_ms(1);
+    CHECK(fake_link[0].sniff_requests == 1);
+    CHECK(fake_link[0].max_period == HEADSET_SNIFF_MAX_PERIOD);
+
+    stack_complete(0);
+    CHECK(fake_link[0].mode == BTM_PM_STS_SSR);
+    CHECK(fake_link[0].ssr_max_latency == HEADSET_SNIFF_SSR_MAX_LATENCY);
+
+    /* No new request while in sniff */
+    stub_time_advance_ms(HEADSET_SNIFF_IDLE_TIMEOUT * 10);
+    CHECK(fake_link[0].sniff_requests == 1);
+
+    /* The peer takes the link back to active, it is sniffed again once idle */
+    stack_active(0);
+    stub_time_advance_ms(HEADSET_SNIFF_IDLE_TIMEOUT);
+    CHECK(fake_link[0].sniff_requests == 2);
+
+    /* A refused request is retried at the next idle period only */
+    headset_sniff_mode_change(addr[0], BTM_PM_STS_ERROR);
+    stub_time_advance_ms(HEADSET_SNIFF_IDLE_TIMEOUT * 10);
+    CHECK(fake_link[0].sniff_requests == 2);
+}
+
+static void test_streaming(void)
+{
+    setup();
+    headset_sniff_link_set(addr[0], WICED_TRUE);
+    headset_sniff_link_set(addr[1], WICED_TRUE);
+    stub_time_advance_ms(HEADSET_SNIFF_IDLE_TIMEOUT);
+    stack_complete(0);
+    stack_complete(1);
+
+    /* The streaming link leaves sniff at once, the other one stays */
+    headset_sniff_busy_set(addr[0], WICED_TRUE);
+    CHECK(fake_link[0].cancels == 1);
+    CHECK(fake_link[1].cancels == 0);
+    stack_active(0);
+
+    stub_time_advance_ms(HEADSET_SNIFF_IDLE_TIMEOUT * 10);
+    CHECK(fake_link[0].sniff_requests == 1);
+
+    headset_sniff_busy_set(addr[0], WICED_FALSE);
+    stub_time_advance_ms(HEADSET_SNIFF_IDLE_TIMEOUT);
+    CHECK(fake_link[0].sniff_requests == 2);
+}
+
+static void test_wake_and_call(void)
+{
+    setup();
+    headset_sniff_link_set(addr[0], WICED_TRUE);
+    headset_sniff_link_set(addr[1], WICED_TRUE);
+    stub_time_advance_ms(HEADSET_SNIFF_IDLE_TIMEOUT);
+    stack_complete(0);
+
+    /* A button press takes every link out of sniff, including a pending request */
+    headset_sniff_wake();
+    CHECK(fake_link[0].cancels == 1);
+    CHECK(fake_link[1].cancels == 1);
+    stack_active(0);
+    stack_active(1);
+
+    /* No sniff during a call */
+    headset_sniff_allowed_set(WICED_FALSE);
+    stub_time_advance_ms(HEADSET_SNIFF_IDLE_TIMEOUT * 10);
+    CHECK(fake_link[0].sniff_requests == 1);
+    CHECK(fake_link[1].sniff_requests == 1);
+
+    headset_sniff_allowed_set(WICED_TRUE);
+    stub_time_advance_ms(HEADSET_SNIFF_IDLE_TIMEOUT);
+    CHECK(fake_link[0].sniff_requests == 2);
+    CHECK(fake_link[1].sniff_requests == 2);
+
+    /* A disconnected link is forgotten */
+    headset_sniff_link_set(addr[1], WICED_FALSE);
+    headset_sniff_mode_change(addr[1], BTM_PM_STS_ACTIVE);
+    stub_time_advance_ms(HEADSET_SNIFF_IDLE_TIMEOUT * 10);
+    CHECK(fake_link[1].sniff_requests == 2);
+}
+
+/* Link anchors per minute of an idle connection, the radio wakes up at each of them */
+static void test_model(void)
+{
+    uint32_t active = 60000000 / (ACTIVE_POLL_SLOTS * 625);
+    uint32_t sniff  = 60000000 / (HEADSET_SNIFF_MAX_PERIOD * 625);
+    uint32_t ssr    = 60000000 / (HEADSET_SNIFF_SSR_MAX_LATENCY * 625);
+
+    printf("    idle link anchors per minute: active %u, sniff %u, subrated %u\n", active, sniff, ssr);
+
+    CHECK(ssr * 3 <= sniff);
+    CHECK(sniff * 20 <= active);
+}
+
+int main(void)
+{
+    RUN(test_idle_link);
+    RUN(test_streaming);
+    RUN(test_wake_and_call);
+    RUN(test_model);
+
+    return 0;
+}
@@ -43,19 +43,19 @@
 * Header Files
 *******************************************************************************/
 #include "bt_hs_spk_handsfree.h"
+#include "headset_audio_buf.h"
 #include "wiced_app_cfg.h"
 #include "wiced_bt_avdt.h"
 #include "wiced_bt_avrc.h"
 #include "wiced_bt_avrc_defs.h"
 #include "wiced_bt_cfg.h"
+#include "wiced_bt_dev.h"
 #include "wiced_bt_sdp.h"
 #include "wiced_bt_sdp_defs.h"
 
 /*******************************************************************************
 * Macros
 ********************************************************************************/
-#define WICED_DEVICE_NAME   "HSPK"
-
 #if (WICED_BT_HFP_HF_WBS_INCLUDED == TRUE)
 #define WICED_APP_CFG_SDP_HFP_FEATURE   (WICED_BT_HFP_HF_SDP_FEATURE_3WAY_CALLING | \
                                          WICED_BT_HFP_HF_SDP_FEATURE_CLIP | \
@@ -67,13 +67,30 @@
                                          WICED_BT_HFP_HF_SDP_FEATURE_REMOTE_VOL_CTRL)
 #endif
 
+/*
+ * ServiceClassIDList of each record of btheadset_sdp_db, applied to SDP_ATTR_UUID16 in the
+ * records and to WICED_APP_CFG_EIR_UUID16 in the EIR, so the two lists cannot drift apart.
+ */
+#define WICED_APP_CFG_CLASSES_A2DP_SINK(uuid16)         uuid16(UUID_SERVCLASS_AUDIO_SINK)
+#define WICED_APP_CFG_CLASSES_AVRC_TARGET(uuid16)       uuid16(UUID_SERVCLASS_AV_REM_CTRL_TARGET)
+#define WICED_APP_CFG_CLASSES_AVRC_CONTROLLER(uuid16)   uuid16(UUID_SERVCLASS_AV_REMOTE_CONTROL), \
+                                                        uuid16(UUID_SERVCLASS_AV_REM_CTRL_CONTROL)
+#define WICED_APP_CFG_CLASSES_HANDSFREE(uuid16)         uuid16(UUID_SERVCLASS_HF_HANDSFREE), \
+                                                        uuid16(UUID_SERVCLASS_GENERIC_AUDIO)
+#define WICED_APP_CFG_CLASSES_OFU_SPP(uuid16)           uuid16(UUID_SERVCLASS_SERIAL_PORT)
+
+/* Service class ID list attribute of a record, 3 bytes per UUID */
+#define WICED_APP_CFG_SDP_CLASS_ID_LIST(classes)        SDP_ATTR_ID(ATTR_ID_SERVICE_CLASS_ID_LIST), \
+                                                        SDP_ATTR_SEQUENCE_1(sizeof((const uint8_t[]) { classes(SDP_ATTR_UUID16) })), \
+                                                        classes(SDP_ATTR_UUID16)
+
 /*******************************************************************************
 * Global Variables
 ********************************************************************************/
 /* BR Setting */
 const wiced_bt_cfg_br_t wiced_bt_cfg_br =
 {
-    .br_max_simultaneous_links  = 2,
+    .br_max_simultaneous_links  = BT_HS_SPK_CONTROL_BR_EDR_MAX_CONNECTIONS + 1,    /**< One more than the sources for a connection being set up or rejected */
     .br_max_rx_pdu_size         = 1024,
     .device_class               = {0x24, 0x04, 0x18},   /**< Local device class */
 
@@ -133,7 +150,11 @@ const wiced_bt_cfg_ble_advert_settings_t wiced_bt_cfg_adv_settings =
 
     .high_duty_min_interval = 160,  /**< High duty undirected connectable minimum advertising interval */
     .high_duty_max_interval = 160,  /**< High duty undirected connectable maximum advertising interval */
+#ifdef FASTPAIR_ENABLE
+    .high_duty_duration     = 30,   /**< High duty undirected connectable advertising duration in seconds ( 0 for infinite ), then low duty */
+#else
     .high_duty_duration     = 0,    /**< High duty undirected connectable advertising duration in seconds ( 0 for infinite ) */
+#endif
 
     .low_duty_min_interval  = 400,  /**< Low duty undirected connectable minimum advertising interval */
     .low_duty_max_interval  = 400,  /**< Low duty undirected connectable maximum advertising interval */
@@ -159,7 +180,11 @@ const wiced_bt_cfg_ble_advert_settings_t wiced_bt_cfg_adv_settings =
 const wiced_bt_cfg_ble_t wiced_bt_cfg_ble =
 {
     .ble_max_simultaneous_links     = 1,
+#ifdef OTA_FW_UPGRADE
+    .ble_max_rx_pdu_size            = 512,  /**< Largest ATT MTU offered to the peer, lets OTA data use 509 byte writes */
+#else
     .ble_max_rx_pdu_size            = 365,
+#endif
     .appearance                     = APPEARANCE_GENERIC_TAG,   /**< GATT appearance (see gatt_appearance_e) */
 #ifdef FASTPAIR_ENABLE
     .rpa_refresh_timeout            = WICED_BT_CFG_DEFAULT_RANDOM_ADDRESS_CHANGE_TIMEOUT,   /**< Interval of  random address refreshing - secs */
@@ -239,7 +264,7 @@ const uint8_t btheadset_sdp_db[] =
     // SDP Record for A2DP Sink
     SDP_ATTR_SEQUENCE_1(77),
         SDP_ATTR_RECORD_HANDLE(HANDLE_AVDT_SINK),
-        SDP_ATTR_CLASS_ID(UUID_SERVCLASS_AUDIO_SINK),
+        WICED_APP_CFG_SDP_CLASS_ID_LIST(WICED_APP_CFG_CLASSES_A2DP_SINK),
         SDP_ATTR_ID(ATTR_ID_PROTOCOL_DESC_LIST),
             SDP_ATTR_SEQUENCE_1(16),
                 SDP_ATTR_SEQUENCE_1(6),
@@ -260,9 +285,7 @@ const uint8_t btheadset_sdp_db[] =
     // SDP Record for AVRC Target
     SDP_ATTR_SEQUENCE_1(56),
         SDP_ATTR_RECORD_HANDLE(HANDLE_AVRC_TARGET),
-        SDP_ATTR_ID(ATTR_ID_SERVICE_CLASS_ID_LIST),
-            SDP_ATTR_SEQUENCE_1(3),
-                SDP_ATTR_UUID16(UUID_SERVCLASS_AV_REM_CTRL_TARGET),
+        WICED_APP_CFG_SDP_CLASS_ID_LIST(WICED_APP_CFG_CLASSES_AVRC_TARGET),
         SDP_ATTR_ID(ATTR_ID_PROTOCOL_DESC_LIST), SDP_ATTR_SEQUENCE_1(16),
             SDP_ATTR_SEQUENCE_1(6),
                 SDP_ATTR_UUID16(UUID_PROTOCOL_L2CAP),
@@ -279,10 +302,7 @@ const uint8_t btheadset_sdp_db[] =
     // SDP Record for AVRC Controller
     SDP_ATTR_SEQUENCE_1(59),
         SDP_ATTR_RECORD_HANDLE(HANDLE_AVRC_CONTROLLER),
-        SDP_ATTR_ID(ATTR_ID_SERVICE_CLASS_ID_LIST),
-            SDP_ATTR_SEQUENCE_1(6),
-                SDP_ATTR_UUID16(UUID_SERVCLASS_AV_REMOTE_CONTROL),
-                SDP_ATTR_UUID16(UUID_SERVCLASS_AV_REM_CTRL_CONTROL),
+        WICED_APP_CFG_SDP_CLASS_ID_LIST(WICED_APP_CFG_CLASSES_AVRC_CONTROLLER),
         SDP_ATTR_ID(ATTR_ID_PROTOCOL_DESC_LIST), SDP_ATTR_SEQUENCE_1(16),
             SDP_ATTR_SEQUENCE_1(6),
                 SDP_ATTR_UUID16(UUID_PROTOCOL_L2CAP),
@@ -299,9 +319,7 @@ const uint8_t btheadset_sdp_db[] =
         // SDP Record for Hands-Free Unit
             SDP_ATTR_SEQUENCE_1(75),
                 SDP_ATTR_RECORD_HANDLE(WICED_HANDSFREE_HDLR_UNIT),
-                SDP_ATTR_ID(ATTR_ID_SERVICE_CLASS_ID_LIST), SDP_ATTR_SEQUENCE_1(6),
-                    SDP_ATTR_UUID16(UUID_SERVCLASS_HF_HANDSFREE),
-                    SDP_ATTR_UUID16(UUID_SERVCLASS_GENERIC_AUDIO),
+                WICED_APP_CFG_SDP_CLASS_ID_LIST(WICED_APP_CFG_CLASSES_HANDSFREE),
                 SDP_ATTR_RFCOMM_PROTOCOL_DESC_LIST(WICED_HANDSFREE_SCN),
                 SDP_ATTR_ID(ATTR_ID_BT_PROFILE_DESC_LIST), SDP_ATTR_SEQUENCE_1(8),
                     SDP_ATTR_SEQUENCE_1(6),
@@ -314,7 +332,7 @@ const uint8_t btheadset_sdp_db[] =
     // SDP Record for SPP OFU
     SDP_ATTR_SEQUENCE_1(69),                                            // 2 bytes
         SDP_ATTR_RECORD_HANDLE(HANDLE_OFU_SPP),                         // 8 bytes
-        SDP_ATTR_CLASS_ID(UUID_SERVCLASS_SERIAL_PORT),                  // 8
+        WICED_APP_CFG_SDP_CLASS_ID_LIST(WICED_APP_CFG_CLASSES_OFU_SPP),  // 8
         SDP_ATTR_RFCOMM_PROTOCOL_DESC_LIST(OFU_SPP_RFCOMM_SCN),         // 17 bytes
         SDP_ATTR_BROWSE_LIST,                                           // 8
         SDP_ATTR_PROFILE_DESC_LIST(UUID_SERVCLASS_SERIAL_PORT, 0x0102), // 13 byte
@@ -322,12 +340,60 @@ const uint8_t btheadset_sdp_db[] =
         'S', 'P', 'P', ' ', 'S', 'E', 'R', 'V', 'E', 'R',
 };
 
+/*
+ * EIR, written to the controller as is (headset_eir). The UUIDs are the service class IDs of the
+ * records above in record order, little endian.
+ */
+#define WICED_APP_CFG_EIR_UUID16(uuid)  (uint8_t) (uuid), (uint8_t) ((uuid) >> 8)
+
+#define WICED_APP_CFG_EIR_UUID_LIST     WICED_APP_CFG_CLASSES_A2DP_SINK(WICED_APP_CFG_EIR_UUID16),       \
+                                        WICED_APP_CFG_CLASSES_AVRC_TARGET(WICED_APP_CFG_EIR_UUID16),     \
+                                        WICED_APP_CFG_CLASSES_AVRC_CONTROLLER(WICED_APP_CFG_EIR_UUID16), \
+                                        WICED_APP_CFG_CLASSES_HANDSFREE(WICED_APP_CFG_EIR_UUID16),       \
+                                        WICED_APP_CFG_CLASSES_OFU_SPP(WICED_APP_CFG_EIR_UUID16)
+
+const wiced_app_cfg_eir_t btheadset_eir =
+{
+    .name_len   = sizeof(btheadset_eir.name) + 1,
+    .name_type  = BTM_EIR_COMPLETE_LOCAL_NAME_TYPE,
+    .name       = WICED_DEVICE_NAME,
+    .uuid_len   = sizeof(btheadset_eir.uuid) + 1,
+    .uuid_type  = BTM_EIR_COMPLETE_16BITS_UUID_TYPE,
+    .uuid       = { WICED_APP_CFG_EIR_UUID_LIST },
+};
+
+_Static_assert(sizeof((const uint8_t[]) { WICED_APP_CFG_EIR_UUID_LIST }) == sizeof(btheadset_eir.uuid),
+               "WICED_APP_CFG_EIR_UUID_NUM does not match the UUID list");
+_Static_assert(sizeof(btheadset_eir) <= WICED_APP_CFG_EIR_MAX, "EIR too long");
+
 /*****************************************************************************
  *   codec and audio tuning configurations
  ****************************************************************************/
 /*  Recommended max_bitpool for high quality audio */
 #define BT_AUDIO_A2DP_SBC_MAX_BITPOOL   53
 
+/* Advertised sampling frequencies */
+#ifdef ENABLE_PTS_TESTING
+#define BT_AUDIO_A2DP_SBC_SAMP_FREQ     (A2D_SBC_IE_SAMP_FREQ_44 | A2D_SBC_IE_SAMP_FREQ_48 | A2D_SBC_IE_SAMP_FREQ_16 | A2D_SBC_IE_SAMP_FREQ_32)
+#else
+#define BT_AUDIO_A2DP_SBC_SAMP_FREQ     (A2D_SBC_IE_SAMP_FREQ_44 | A2D_SBC_IE_SAMP_FREQ_48)
+#endif
+#define BT_AUDIO_A2DP_M24_SAMP_FREQ     (A2D_M24_IE_SAMP_FREQ_44 | A2D_M24_IE_SAMP_FREQ_48)
+
+/* Highest advertised SBC sampling frequency in Hz */
+#define BT_AUDIO_A2DP_SBC_MAX_SAMP_RATE (((BT_AUDIO_A2DP_SBC_SAMP_FREQ) & A2D_SBC_IE_SAMP_FREQ_48) ? 48000 : \
+                                         ((BT_AUDIO_A2DP_SBC_SAMP_FREQ) & A2D_SBC_IE_SAMP_FREQ_44) ? 44100 : \
+                                         ((BT_AUDIO_A2DP_SBC_SAMP_FREQ) & A2D_SBC_IE_SAMP_FREQ_32) ? 32000 : 16000)
+
+/* Highest advertised AAC sampling frequency in Hz */
+#define BT_AUDIO_A2DP_M24_MAX_SAMP_RATE (((BT_AUDIO_A2DP_M24_SAMP_FREQ) & A2D_M24_IE_SAMP_FREQ_48) ? 48000 : 44100)
+
+/* Highest AAC bit rate the jitter buffer is sized for (bit/s) */
+#define BT_AUDIO_A2DP_M24_MAX_BIT_RATE  320000
+
+/* Jitter buffer depth */
+#define BT_AUDIO_A2DP_BUF_DEPTH_MS      300
+
 /* Array of decoder capabilities information. */
 wiced_bt_a2dp_codec_info_t bt_audio_codec_capabilities[] =
 {
@@ -337,11 +403,7 @@ wiced_bt_a2dp_codec_info_t bt_audio_codec_capabilities[] =
         {
             .sbc =
             {
-#ifdef ENABLE_PTS_TESTING
-                (A2D_SBC_IE_SAMP_FREQ_44 | A2D_SBC_IE_SAMP_FREQ_48 | A2D_SBC_IE_SAMP_FREQ_16 | A2D_SBC_IE_SAMP_FREQ_32),    /* samp_freq */
-#else
-                (A2D_SBC_IE_SAMP_FREQ_44 | A2D_SBC_IE_SAMP_FREQ_48),    /* samp_freq */
-#endif
+                BT_AUDIO_A2DP_SBC_SAMP_FREQ,                            /* samp_freq */
                 (A2D_SBC_IE_CH_MD_MONO   | A2D_SBC_IE_CH_MD_STEREO |
                  A2D_SBC_IE_CH_MD_JOINT  | A2D_SBC_IE_CH_MD_DUAL),      /* ch_mode */
                 (A2D_SBC_IE_BLOCKS_16    | A2D_SBC_IE_BLOCKS_12 |
@@ -362,7 +424,7 @@ wiced_bt_a2dp_codec_info_t bt_audio_codec_capabilities[] =
                 .m24 =
                 {
                     (A2D_M24_IE_OBJ_MSK),                                   /* obj_type */
-                    (A2D_M24_IE_SAMP_FREQ_44 | A2D_M24_IE_SAMP_FREQ_48),    /*samp_freq */
+                    BT_AUDIO_A2DP_M24_SAMP_FREQ,                            /*samp_freq */
                     (A2D_M24_IE_CHNL_MSK),                                  /* chnl */
                     (A2D_M24_IE_VBR_MSK),                                   /* b7: VBR */
                     (A2D_M24_IE_BITRATE_MSK)                                /* bitrate - b7-b0 of octect 3, all of octect4, 5*/
@@ -383,7 +445,7 @@ wiced_bt_a2dp_config_data_t bt_audio_config =
     },
     .p_param =
     {
-        .buf_depth_ms                   = 300,                                          /* in msec */
+        .buf_depth_ms                   = BT_AUDIO_A2DP_BUF_DEPTH_MS,                   /* in msec */
         .start_buf_depth                = 50,                                           /* start playback percentage of the buffer depth */
         .target_buf_depth               = 50,                                           /* target level percentage of the buffer depth */
         .overrun_control                = WICED_BT_A2DP_SINK_OVERRUN_CONTROL_FLUSH_DATA,/* overrun flow control flag */
@@ -406,19 +468,48 @@ wiced_bt_a2dp_config_data_t bt_audio_config =
     }
 };
 
-/* It needs 14728 bytes for HFP(mSBC use mainly) and 14148 bytes for A2DP(jitter buffer use mainly) */
-#define AUDIO_BUF_SIZE_MAIN                 (15 * 1024)
+/*
+ * The audio buffer is split in two regions, as sized by the audio library:
+ *  - the main region, used by HFP (mSBC working memory) or by A2DP (jitter buffer), one at a time.
+ *    It needs 14728 bytes for HFP(mSBC use mainly) and 14148 bytes for A2DP(jitter buffer use mainly).
+ *  - the codec region, placed after the main region. It is kept out of the main region since the
+ *    library does not document whether the voice path also uses it.
+ *
+ * The library places both regions itself, the application only gives the total size. The sizes
+ * are therefore checked at build time, against the library requirements and against the jitter
+ * buffer modeled from the advertised codec parameters (see headset_audio_buf.h).
+ */
 
+/* A2DP jitter buffer */
+#define AUDIO_BUF_SIZE_A2DP_SBC             HEADSET_AUDIO_BUF_SBC_JITTER_SIZE(BT_AUDIO_A2DP_BUF_DEPTH_MS, \
+                                                                              BT_AUDIO_A2DP_SBC_MAX_SAMP_RATE, \
+                                                                              BT_AUDIO_A2DP_SBC_MAX_BITPOOL)
 #ifdef A2DP_SINK_AAC_ENABLED
+#define AUDIO_BUF_SIZE_A2DP_AAC             HEADSET_AUDIO_BUF_AAC_JITTER_SIZE(BT_AUDIO_A2DP_BUF_DEPTH_MS, \
+                                                                              BT_AUDIO_A2DP_M24_MAX_SAMP_RATE, \
+                                                                              BT_AUDIO_A2DP_M24_MAX_BIT_RATE)
+#define AUDIO_BUF_SIZE_A2DP                 HEADSET_AUDIO_BUF_MAX(AUDIO_BUF_SIZE_A2DP_SBC, AUDIO_BUF_SIZE_A2DP_AAC)
+
 /* For AAC, audio codec memory requires 21248 bytes and sample buffer required 2 * 4 1024 bytes */
-#define AUDIO_BUF_SIZE_CODEC                (21248 + (2 * 4 * 1024))
+#define AUDIO_BUF_SIZE_CODEC                HEADSET_AUDIO_BUF_AAC_CODEC_SIZE
 #else
+#define AUDIO_BUF_SIZE_A2DP                 AUDIO_BUF_SIZE_A2DP_SBC
+
 /* SBC audio codec memory requires 6908 bytes */
-#define AUDIO_BUF_SIZE_CODEC                6908
+#define AUDIO_BUF_SIZE_CODEC                HEADSET_AUDIO_BUF_SBC_CODEC_SIZE
 #endif
 
+#define AUDIO_BUF_SIZE_MAIN                 (15 * 1024)
+
 #define AUDIO_CODEC_BUFFER_SIZE             (AUDIO_BUF_SIZE_MAIN + AUDIO_BUF_SIZE_CODEC)
 
+/* Fail the build if the main region drops below what the audio library or the modeled jitter buffer need. */
+_Static_assert(AUDIO_BUF_SIZE_MAIN >= HEADSET_AUDIO_BUF_LIB_HFP_MIN, "main region below the library HFP requirement");
+_Static_assert(AUDIO_BUF_SIZE_MAIN >= HEADSET_AUDIO_BUF_LIB_A2DP_MIN, "main region below the library A2DP requirement");
+_Static_assert(AUDIO_BUF_SIZE_MAIN >= AUDIO_BUF_SIZE_A2DP, "main region too small for the A2DP jitter buffer");
+_Static_assert(BT_AUDIO_A2DP_SBC_MAX_BITPOOL <= A2D_SBC_IE_MAX_BITPOOL, "invalid SBC max bitpool");
+_Static_assert((BT_AUDIO_A2DP_BUF_DEPTH_MS > 0) && (BT_AUDIO_A2DP_BUF_DEPTH_MS <= 1000), "invalid A2DP buffer depth");
+
 /**  Audio buffer configuration configuration */
 const wiced_bt_audio_config_buffer_t wiced_bt_audio_buf_config = {
     .role                       =   WICED_AUDIO_SINK_ROLE | WICED_HF_ROLE,
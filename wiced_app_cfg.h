@@ -48,6 +48,8 @@
 /*******************************************************************************
 *        Macro Definitions
 *******************************************************************************/
+#define WICED_DEVICE_NAME   "HSPK"
+
 #ifdef OTA_FW_UPGRADE
 #define OFU_SPP_RFCOMM_PORT_COUNT   1
 #else   // !OTA_FW_UPGRADE
@@ -59,10 +61,31 @@ enum
     OFU_SPP_RFCOMM_SCN = 2,
 };
 
+/* Service class UUIDs of the records in btheadset_sdp_db, listed in the EIR (checked against the list at build time) */
+#define WICED_APP_CFG_EIR_UUID_NUM  7
+
+/* Largest EIR the controller takes */
+#define WICED_APP_CFG_EIR_MAX       240
+
+/*******************************************************************************
+*        Data Types
+*******************************************************************************/
+/* EIR built at compile time: complete local name, complete list of 16-bit service class UUIDs */
+typedef struct __attribute__((packed))
+{
+    uint8_t name_len;
+    uint8_t name_type;
+    char    name[sizeof(WICED_DEVICE_NAME) - 1];
+    uint8_t uuid_len;
+    uint8_t uuid_type;
+    uint8_t uuid[WICED_APP_CFG_EIR_UUID_NUM * 2];
+} wiced_app_cfg_eir_t;
+
 /*******************************************************************************
 *        External Variable Declarations
 *******************************************************************************/
 extern const wiced_bt_cfg_settings_t wiced_bt_cfg_settings;
+extern const wiced_app_cfg_eir_t btheadset_eir;
 
 /*******************************************************************************
 *        Function Prototypes